@@ -0,0 +1,99 @@
+/*
+    \file   host_session_storage.c
+
+    \brief  RAM backed MQTT session storage for the host build.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+// mqtt_session_storage.c programs the SAMD21 NVMCTRL through 32-bit flash
+// addresses; on the host the records are kept in RAM with the same semantics,
+// tagged with the client ID itself rather than its hash.
+
+#include <string.h>
+#include "mqtt/mqtt_session_storage/mqtt_session_storage.h"
+#include "iot_config/mqtt_config.h"
+
+typedef struct
+{
+	uint8_t data[MQTT_SESSION_STORAGE_SIZE];
+	uint16_t length;
+	char clientID[128];
+	bool valid;
+} hostSessionRecord;
+
+static hostSessionRecord hostSessionSaved;
+static hostSessionRecord hostSessionPending;
+
+bool MQTT_SessionStorageBegin(const uint8_t *clientID)
+{
+	strncpy(hostSessionPending.clientID, (const char *) clientID, sizeof(hostSessionPending.clientID) - 1);
+	hostSessionPending.length = 0;
+	hostSessionPending.valid = true;
+	return true;
+}
+
+bool MQTT_SessionStorageWrite(const uint8_t *data, uint16_t length)
+{
+	if ((hostSessionPending.valid == false) || (length > sizeof(hostSessionPending.data) - hostSessionPending.length))
+	{
+		hostSessionPending.valid = false;
+		return false;
+	}
+	memcpy(&hostSessionPending.data[hostSessionPending.length], data, length);
+	hostSessionPending.length += length;
+	return true;
+}
+
+bool MQTT_SessionStorageEnd(void)
+{
+	if (hostSessionPending.valid == false)
+	{
+		return false;
+	}
+	hostSessionSaved = hostSessionPending;
+	hostSessionPending.valid = false;
+	return true;
+}
+
+uint16_t MQTT_SessionStorageOpen(const uint8_t *clientID)
+{
+	if ((hostSessionSaved.valid == false) || (strcmp(hostSessionSaved.clientID, (const char *) clientID) != 0))
+	{
+		return 0;
+	}
+	return hostSessionSaved.length;
+}
+
+uint16_t MQTT_SessionStorageRead(uint16_t offset, uint8_t *data, uint16_t length)
+{
+	if (offset >= hostSessionSaved.length)
+	{
+		return 0;
+	}
+	if (length > hostSessionSaved.length - offset)
+	{
+		length = hostSessionSaved.length - offset;
+	}
+	memcpy(data, &hostSessionSaved.data[offset], length);
+	return length;
+}
@@ -0,0 +1,545 @@
+/*
+    \file   host_sim.c
+
+    \brief  Simulated socket, clock and debug output for the host build.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include "socket.h"
+#include "m2m_wifi.h"
+#include "host_sim.h"
+#include "debug_print.h"
+#include "mqtt/mqtt_comm_bsd/mqtt_comm_layer.h"
+#include "mqtt/mqtt_core/mqtt_core.h"
+#include "services/iot/cloud/bsd_adapter/bsdWINC.h"
+#include "services/iot/cloud/mqtt_packetPopulation/mqtt_packetPopulate.h"
+
+#define SIM_MAX_TIMERS          16
+#define SIM_CAPTURE_SIZE        (64 * 1024)
+#define SIM_RX_QUEUE_SIZE       (64 * 1024)
+#define SIM_RX_MESSAGES         256
+#define SIM_SEND_PENDING        8
+#define SIM_SOCKET              0
+
+typedef struct
+{
+	SYS_TIME_CALLBACK callback;
+	uintptr_t context;
+	uint32_t period;
+	uint32_t expiry;
+	SYS_TIME_CALLBACK_TYPE type;
+	uint16_t token;
+	bool active;
+} simTimer;
+
+static uint32_t simClock;
+static simTimer simTimers[SIM_MAX_TIMERS];
+static simSocketStats simStats;
+static bool simSendError;
+static bool simCapture;
+static uint8_t simCaptureBuffer[SIM_CAPTURE_SIZE];
+static size_t simCaptureLength;
+static uint32_t simConnectedCount;
+static int simVerbose = -1;
+
+// The WINC side of the one simulated socket
+static struct
+{
+	bool open;
+	bool recvPending;
+	uint8_t *recvBuffer;
+	uint16_t recvLength;
+	// Sends not confirmed with SOCKET_MSG_SEND yet, oldest first
+	uint16_t sendLength[SIM_SEND_PENDING];
+	uint8_t sendHead;
+	uint8_t sendCount;
+} simWinc;
+
+// Received data WINC holds until it is asked for it, one message per segment
+static uint8_t simRxQueue[SIM_RX_QUEUE_SIZE];
+static size_t simRxQueueHead;
+static size_t simRxQueueLength;
+static uint16_t simRxMessages[SIM_RX_MESSAGES];
+static uint16_t simRxMessageHead;
+static uint16_t simRxMessageCount;
+
+// As set up by reInit() in cloud_service.c
+static packetReceptionHandler_t simSocketHandler;
+static uint8_t simSocketBuffer[SOCKET_BUFFER_MAX_LENGTH];
+
+static void simConnected(void)
+{
+	simConnectedCount++;
+}
+
+static pf_MQTT_CLIENT simMqttClient =
+{
+	.MQTT_CLIENT_connected = simConnected
+};
+pf_MQTT_CLIENT *pf_mqtt_client = &simMqttClient;
+
+void SIM_Reset(void)
+{
+	uint8_t i;
+
+	// Tokens are kept so that handles from a previous run stay stale
+	for (i = 0; i < SIM_MAX_TIMERS; i++)
+	{
+		simTimers[i].active = false;
+	}
+	memset(&simStats, 0, sizeof(simStats));
+	simClock = 0;
+	simSendError = false;
+	simCaptureLength = 0;
+	simConnectedCount = 0;
+	memset(&simWinc, 0, sizeof(simWinc));
+	simRxQueueHead = 0;
+	simRxQueueLength = 0;
+	simRxMessageHead = 0;
+	simRxMessageCount = 0;
+}
+
+void SIM_ClockAdvance(uint32_t ms)
+{
+	uint32_t target = simClock + ms;
+	uint32_t next;
+	uint8_t i;
+
+	// Fire the timers in expiry order, with the clock set to each expiry
+	while (true)
+	{
+		next = target;
+		for (i = 0; i < SIM_MAX_TIMERS; i++)
+		{
+			if ((simTimers[i].active == true) && ((int32_t) (simTimers[i].expiry - next) < 0))
+			{
+				next = simTimers[i].expiry;
+			}
+		}
+		simClock = next;
+		for (i = 0; i < SIM_MAX_TIMERS; i++)
+		{
+			simTimer *timer = &simTimers[i];
+
+			if ((timer->active == true) && (timer->expiry == simClock))
+			{
+				if (timer->type == SYS_TIME_PERIODIC)
+				{
+					timer->expiry += timer->period;
+				}
+				else
+				{
+					timer->active = false;
+				}
+				timer->callback(timer->context);
+			}
+		}
+		if (simClock == target)
+		{
+			break;
+		}
+	}
+}
+
+uint32_t SIM_ClockGet(void)
+{
+	return simClock;
+}
+
+static bool simSocketDeliver(void)
+{
+	tstrSocketRecvMsg recvMsg;
+	int16_t sentLength;
+	uint16_t remaining;
+	uint16_t chunk;
+	uint16_t i;
+	bool delivered = false;
+
+	// Data is sent as soon as events are handled
+	while ((simWinc.open == true) && (simWinc.sendCount > 0))
+	{
+		sentLength = simWinc.sendLength[simWinc.sendHead];
+		simWinc.sendHead = (simWinc.sendHead + 1) % SIM_SEND_PENDING;
+		simWinc.sendCount--;
+		delivered = true;
+		BSD_SocketHandler(SIM_SOCKET, SOCKET_MSG_SEND, &sentLength);
+	}
+
+	// As Socket_ReadSocketData() in the WINC driver: a RECV reply answers
+	// one recv() call with one message, split into chunks of the size of the
+	// buffer last passed to recv(). The copy stands for the SPI transfer and
+	// is left out of the copy statistics.
+	while ((simWinc.open == true) && (simWinc.recvPending == true) && (simRxMessageCount > 0))
+	{
+		remaining = simRxMessages[simRxMessageHead];
+		simRxMessageHead = (simRxMessageHead + 1) % SIM_RX_MESSAGES;
+		simRxMessageCount--;
+		simWinc.recvPending = false;
+		delivered = true;
+
+		memset(&recvMsg, 0, sizeof(recvMsg));
+		while (remaining > 0)
+		{
+			chunk = (remaining > simWinc.recvLength) ? simWinc.recvLength : remaining;
+			for (i = 0; i < chunk; i++)
+			{
+				simWinc.recvBuffer[i] = simRxQueue[simRxQueueHead + i];
+			}
+			simRxQueueHead += chunk;
+			simRxQueueLength -= chunk;
+			remaining -= chunk;
+
+			recvMsg.pu8Buffer = simWinc.recvBuffer;
+			recvMsg.s16BufferSize = chunk;
+			recvMsg.u16RemainingSize = remaining;
+			BSD_SocketHandler(SIM_SOCKET, SOCKET_MSG_RECV, &recvMsg);
+			if (simWinc.open == false)
+			{
+				// Closed by the callback: the rest of the data is dropped
+				return true;
+			}
+		}
+	}
+	if (simRxQueueLength == 0)
+	{
+		simRxQueueHead = 0;
+	}
+	return delivered;
+}
+
+void SIM_SocketConnect(void)
+{
+	mqttContext *context = MQTT_GetClientConnectionInfo();
+	struct bsd_sockaddr_in addr;
+	tstrSocketConnectMsg connectMsg;
+
+	// As reInit() and connectMQTTSocket() in cloud_service.c
+	memset(&simSocketHandler, 0, sizeof(simSocketHandler));
+	simSocketHandler.socket = context->tcpClientSocket;
+	simSocketHandler.recvCallBack = MQTT_GetReceivedData;
+	simSocketHandler.sendCallBack = MQTT_GetSendCompleted;
+	simSocketHandler.recvBuffer = simSocketBuffer;
+	simSocketHandler.recvBufferSize = sizeof(simSocketBuffer);
+
+	*context->tcpClientSocket = BSD_socket(PF_INET, BSD_SOCK_STREAM, 1);
+	BSD_SetSocketHandler(*context->tcpClientSocket, &simSocketHandler);
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = PF_INET;
+	addr.sin_port = BSD_htons(8883);
+	BSD_connect(*context->tcpClientSocket, (struct bsd_sockaddr *) &addr, sizeof(addr));
+
+	connectMsg.sock = SIM_SOCKET;
+	connectMsg.s8Error = SOCK_ERR_NO_ERROR;
+	BSD_SocketHandler(SIM_SOCKET, SOCKET_MSG_CONNECT, &connectMsg);
+}
+
+void SIM_SocketInject(const uint8_t *data, size_t length, uint16_t segmentLength)
+{
+	uint16_t segment;
+	uint16_t i;
+
+	if (segmentLength > SOCKET_BUFFER_MAX_LENGTH)
+	{
+		segmentLength = SOCKET_BUFFER_MAX_LENGTH;
+	}
+	while ((length > 0) && (simWinc.open == true))
+	{
+		segment = (length > segmentLength) ? segmentLength : length;
+		if ((simRxQueueHead + simRxQueueLength + segment > SIM_RX_QUEUE_SIZE) || (simRxMessageCount == SIM_RX_MESSAGES))
+		{
+			fprintf(stderr, "sim: received data is not read\n");
+			abort();
+		}
+		for (i = 0; i < segment; i++)
+		{
+			simRxQueue[simRxQueueHead + simRxQueueLength + i] = data[i];
+		}
+		simRxQueueLength += segment;
+		simRxMessages[(simRxMessageHead + simRxMessageCount) % SIM_RX_MESSAGES] = segment;
+		simRxMessageCount++;
+		data += segment;
+		length -= segment;
+	}
+}
+
+int8_t m2m_wifi_handle_events(void)
+{
+	// Called in a loop by a blocking BSD_poll(): let time pass while it waits
+	if (simSocketDeliver() == false)
+	{
+		SIM_ClockAdvance(1);
+	}
+	return 0;
+}
+
+void SIM_MainLoop(void)
+{
+	mqttContext *context = MQTT_GetClientConnectionInfo();
+
+	// m2m_wifi_handle_events() and CLOUD_sched(), until both are idle
+	do
+	{
+		while (MQTT_ConsumeRunnable() == true)
+		{
+			if ((BSD_GetSocketState(*context->tcpClientSocket) != SOCKET_CONNECTED) || (MQTT_GetConnectionState() == DISCONNECTED))
+			{
+				continue;
+			}
+			// As pumpMQTT()
+			MQTT_Receive(context);
+			MQTT_ReceptionHandler(context);
+			MQTT_TransmissionHandler(context);
+			if (MQTT_Receive(context) == true)
+			{
+				MQTT_SetRunnable();
+			}
+		}
+	} while (simSocketDeliver() == true);
+}
+
+void SIM_SocketSetSendError(bool error)
+{
+	simSendError = error;
+}
+
+void SIM_SocketCapture(bool enable)
+{
+	simCapture = enable;
+	simCaptureLength = 0;
+}
+
+const uint8_t *SIM_SocketSentData(size_t *length)
+{
+	*length = simCaptureLength;
+	return simCaptureBuffer;
+}
+
+void SIM_SocketSentClear(void)
+{
+	simCaptureLength = 0;
+}
+
+const simSocketStats *SIM_SocketGetStats(void)
+{
+	return &simStats;
+}
+
+uint32_t SIM_GetConnectedCount(void)
+{
+	return simConnectedCount;
+}
+
+/* WINC socket */
+
+SOCKET SIM_WincSocket(uint16_t u16Domain, uint8_t u8Type, uint8_t u8Flags)
+{
+	memset(&simWinc, 0, sizeof(simWinc));
+	simWinc.open = true;
+	return SIM_SOCKET;
+}
+
+int8_t SIM_WincConnect(SOCKET sock, struct sockaddr *pstrAddr, uint8_t u8AddrLen)
+{
+	return ((sock == SIM_SOCKET) && (simWinc.open == true)) ? SOCK_ERR_NO_ERROR : SOCK_ERR_INVALID_ARG;
+}
+
+int16_t SIM_WincSend(SOCKET sock, void *pvSendBuffer, uint16_t u16SendLength, uint16_t u16Flags)
+{
+	const uint8_t *data = pvSendBuffer;
+	size_t i;
+
+	if ((sock != SIM_SOCKET) || (simWinc.open == false) || (pvSendBuffer == NULL) || (u16SendLength > SOCKET_BUFFER_MAX_LENGTH))
+	{
+		return SOCK_ERR_INVALID_ARG;
+	}
+	if ((simSendError == true) || (simWinc.sendCount == SIM_SEND_PENDING))
+	{
+		return SOCK_ERR_BUFFER_FULL;
+	}
+	simWinc.sendLength[(simWinc.sendHead + simWinc.sendCount) % SIM_SEND_PENDING] = u16SendLength;
+	simWinc.sendCount++;
+	simStats.sendCalls++;
+	simStats.sentBytes += u16SendLength;
+	// Byte loop so that capturing does not show up in the copy statistics
+	for (i = 0; (simCapture == true) && (i < u16SendLength) && (simCaptureLength < SIM_CAPTURE_SIZE); i++)
+	{
+		simCaptureBuffer[simCaptureLength++] = data[i];
+	}
+	return SOCK_ERR_NO_ERROR;
+}
+
+int16_t SIM_WincRecv(SOCKET sock, void *pvRecvBuf, uint16_t u16BufLen, uint32_t u32Timeoutmsec)
+{
+	// As in the WINC driver, every call moves the buffer the next data is
+	// written to, but only the first one until a reply issues a command
+	if ((sock != SIM_SOCKET) || (simWinc.open == false) || (pvRecvBuf == NULL) || (u16BufLen == 0))
+	{
+		return SOCK_ERR_INVALID_ARG;
+	}
+	simWinc.recvBuffer = pvRecvBuf;
+	simWinc.recvLength = u16BufLen;
+	if (simWinc.recvPending == false)
+	{
+		simWinc.recvPending = true;
+		simStats.recvCalls++;
+	}
+	return SOCK_ERR_NO_ERROR;
+}
+
+int8_t SIM_WincShutdown(SOCKET sock)
+{
+	if ((sock != SIM_SOCKET) || (simWinc.open == false))
+	{
+		return SOCK_ERR_INVALID_ARG;
+	}
+	simStats.closeCalls++;
+	memset(&simWinc, 0, sizeof(simWinc));
+	simRxQueueHead = 0;
+	simRxQueueLength = 0;
+	simRxMessageCount = 0;
+	return SOCK_ERR_NO_ERROR;
+}
+
+// Not used by the MQTT client
+
+int8_t SIM_WincBind(SOCKET sock, struct sockaddr *pstrAddr, uint8_t u8AddrLen)
+{
+	return SOCK_ERR_INVALID;
+}
+
+int8_t SIM_WincListen(SOCKET sock, uint8_t backlog)
+{
+	return SOCK_ERR_INVALID;
+}
+
+int8_t SIM_WincAccept(SOCKET sock, struct sockaddr *addr, uint8_t *addrlen)
+{
+	return SOCK_ERR_INVALID;
+}
+
+int16_t SIM_WincSendTo(SOCKET sock, void *pvSendBuffer, uint16_t u16SendLength, uint16_t flags, struct sockaddr *pstrDestAddr, uint8_t u8AddrLen)
+{
+	return SOCK_ERR_INVALID;
+}
+
+int16_t SIM_WincRecvFrom(SOCKET sock, void *pvRecvBuf, uint16_t u16BufLen, uint32_t u32Timeoutmsec)
+{
+	return SOCK_ERR_INVALID;
+}
+
+int8_t SIM_WincSetSockOpt(SOCKET socket, uint8_t u8Level, uint8_t option_name, const void *option_value, uint16_t u16OptionLen)
+{
+	return SOCK_ERR_INVALID;
+}
+
+/* SYS_TIME and RTC, one count per millisecond */
+
+SYS_TIME_HANDLE SYS_TIME_CallbackRegisterMS(SYS_TIME_CALLBACK callback, uintptr_t context, uint32_t ms, SYS_TIME_CALLBACK_TYPE type)
+{
+	uint8_t i;
+
+	for (i = 0; i < SIM_MAX_TIMERS; i++)
+	{
+		if (simTimers[i].active == false)
+		{
+			simTimers[i].callback = callback;
+			simTimers[i].context = context;
+			simTimers[i].period = (ms > 0) ? ms : 1;
+			simTimers[i].expiry = simClock + simTimers[i].period;
+			simTimers[i].type = type;
+			simTimers[i].active = true;
+			// As in SYS_TIME, a stale handle does not reach a reused timer
+			simTimers[i].token++;
+			return (SYS_TIME_HANDLE) (((uint32_t) simTimers[i].token << 8) | (i + 1));
+		}
+	}
+	return SYS_TIME_HANDLE_INVALID;
+}
+
+SYS_TIME_RESULT SYS_TIME_TimerStop(SYS_TIME_HANDLE handle)
+{
+	uint32_t index = (handle & 0xFF) - 1;
+
+	if ((handle == SYS_TIME_HANDLE_INVALID) || (index >= SIM_MAX_TIMERS) || ((handle >> 8) != simTimers[index].token) || (simTimers[index].active == false))
+	{
+		return SYS_TIME_ERROR;
+	}
+	simTimers[index].active = false;
+	return SYS_TIME_SUCCESS;
+}
+
+SYS_TIME_RESULT SYS_TIME_TimerDestroy(SYS_TIME_HANDLE handle)
+{
+	return SYS_TIME_TimerStop(handle);
+}
+
+uint32_t SYS_TIME_CounterGet(void)
+{
+	return simClock;
+}
+
+uint64_t SYS_TIME_Counter64Get(void)
+{
+	return simClock;
+}
+
+uint32_t SYS_TIME_CountToMS(uint32_t count)
+{
+	return count;
+}
+
+uint32_t SYS_TIME_MSToCount(uint32_t ms)
+{
+	return ms;
+}
+
+void RTC_RTCCTimeGet(struct tm *currentTime)
+{
+	time_t seconds = 1577836800 + simClock / 1000;
+
+	*currentTime = *gmtime(&seconds);
+}
+
+/* Debug output, enabled with MQTT_HOST_VERBOSE=1 */
+
+void debug_printer(debug_severity_t debug_severity, debug_errorLevel_t error_level, const char *format, ...)
+{
+	va_list args;
+
+	if (simVerbose < 0)
+	{
+		simVerbose = (getenv("MQTT_HOST_VERBOSE") != NULL);
+	}
+	if (simVerbose == 0)
+	{
+		return;
+	}
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fputc('\n', stderr);
+}
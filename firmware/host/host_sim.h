@@ -0,0 +1,78 @@
+/*
+    \file   host_sim.h
+
+    \brief  Simulated socket and clock for the host build.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct
+{
+	uint32_t sendCalls;
+	uint64_t sentBytes;
+	uint32_t closeCalls;
+	uint32_t recvCalls;
+} simSocketStats;
+
+// Clear the clock, the timers, the socket statistics and the captured data
+void SIM_Reset(void);
+
+// Move the clock forward, firing the SYS_TIME callbacks that expire
+void SIM_ClockAdvance(uint32_t ms);
+uint32_t SIM_ClockGet(void);
+
+// Open and connect the MQTT socket through the BSD adapter, as the cloud 
+// service does; call after MQTT_ClientInitialise()
+void SIM_SocketConnect(void);
+
+// Have the socket receive data, in TCP segments of at most segmentLength 
+// bytes. WINC holds it until the adapter asks for it; SIM_MainLoop() hands
+// it over.
+void SIM_SocketInject(const uint8_t *data, size_t length, uint16_t segmentLength);
+
+// Run the WINC event handler (send completions, received data) and the MQTT 
+// engine (as CLOUD_sched() does) until both are idle
+void SIM_MainLoop(void);
+
+// Make WINC refuse data (SOCK_ERR_BUFFER_FULL), or take it again. WINC also 
+// refuses it on its own while too many sends are waiting for SIM_MainLoop().
+void SIM_SocketSetSendError(bool error);
+
+// Keep a copy of the sent data; off by default so that the benchmark only
+// measures the MQTT stack
+void SIM_SocketCapture(bool enable);
+const uint8_t *SIM_SocketSentData(size_t *length);
+void SIM_SocketSentClear(void);
+
+const simSocketStats *SIM_SocketGetStats(void);
+
+// Number of times the MQTT core reported a successful connection
+uint32_t SIM_GetConnectedCount(void);
+
+#endif /* HOST_SIM_H */
@@ -0,0 +1,162 @@
+/*
+    \file   socket.h
+
+    \brief  Host replacement for the WINC socket, SYS_TIME and RTC headers.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+#ifndef HOST_SOCKET_H
+#define HOST_SOCKET_H
+
+// The MQTT core and the BSD adapter reach the WINC driver, the Harmony time
+// system service and the RTC through "socket.h". On the host this header 
+// stands in for all three; the functions are implemented by host_sim.c.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#define SOCKET_BUFFER_MAX_LENGTH    1400
+
+// Host and target are both little endian
+#define _htons(A)   (uint16_t)((((uint16_t) (A)) << 8) | (((uint16_t) (A)) >> 8))
+#define _ntohs      _htons
+#define _htonl(m)   __builtin_bswap32((uint32_t) (m))
+#define _ntohl      _htonl
+
+/* WINC socket API, as used by the BSD adapter (bsdWINC.c) */
+
+#define AF_INET                     2
+
+#define TCP_SOCK_MAX                7
+#define UDP_SOCK_MAX                4
+#define MAX_SOCKET                  (TCP_SOCK_MAX + UDP_SOCK_MAX)
+
+#define SOCK_ERR_NO_ERROR           0
+#define SOCK_ERR_INVALID_ARG        -6
+#define SOCK_ERR_INVALID            -9
+#define SOCK_ERR_CONN_ABORTED       -12
+#define SOCK_ERR_BUFFER_FULL        -14
+
+typedef int8_t SOCKET;
+
+struct sockaddr
+{
+    uint16_t sa_family;
+    uint8_t sa_data[14];
+};
+
+struct in_addr
+{
+    uint32_t s_addr;
+};
+
+struct sockaddr_in
+{
+    uint16_t sin_family;
+    uint16_t sin_port;
+    struct in_addr sin_addr;
+    uint8_t sin_zero[8];
+};
+
+typedef enum
+{
+    SOCKET_MSG_BIND = 1,
+    SOCKET_MSG_LISTEN,
+    SOCKET_MSG_DNS_RESOLVE,
+    SOCKET_MSG_ACCEPT,
+    SOCKET_MSG_CONNECT,
+    SOCKET_MSG_RECV,
+    SOCKET_MSG_SEND,
+    SOCKET_MSG_SENDTO,
+    SOCKET_MSG_RECVFROM
+} tenuSocketCallbackMsgType;
+
+typedef struct
+{
+    SOCKET sock;
+    int8_t s8Error;
+} tstrSocketConnectMsg;
+
+typedef struct
+{
+    uint8_t *pu8Buffer;
+    int16_t s16BufferSize;
+    uint16_t u16RemainingSize;
+    struct sockaddr_in strRemoteAddr;
+} tstrSocketRecvMsg;
+
+// Renamed so that they do not clash with the C library socket functions
+#define socket(domain, type, flags)                         SIM_WincSocket(domain, type, flags)
+#define connect(sock, addr, addrLength)                     SIM_WincConnect(sock, addr, addrLength)
+#define bind(sock, addr, addrLength)                        SIM_WincBind(sock, addr, addrLength)
+#define listen(sock, backlog)                               SIM_WincListen(sock, backlog)
+#define accept(sock, addr, addrLength)                      SIM_WincAccept(sock, addr, addrLength)
+#define send(sock, buffer, length, flags)                   SIM_WincSend(sock, buffer, length, flags)
+#define sendto(sock, buffer, length, flags, addr, addrLength)   SIM_WincSendTo(sock, buffer, length, flags, addr, addrLength)
+#define recv(sock, buffer, length, timeout)                 SIM_WincRecv(sock, buffer, length, timeout)
+#define recvfrom(sock, buffer, length, timeout)             SIM_WincRecvFrom(sock, buffer, length, timeout)
+#define setsockopt(sock, level, option, value, length)      SIM_WincSetSockOpt(sock, level, option, value, length)
+#define shutdown(sock)                                      SIM_WincShutdown(sock)
+
+SOCKET SIM_WincSocket(uint16_t u16Domain, uint8_t u8Type, uint8_t u8Flags);
+int8_t SIM_WincConnect(SOCKET sock, struct sockaddr *pstrAddr, uint8_t u8AddrLen);
+int8_t SIM_WincBind(SOCKET sock, struct sockaddr *pstrAddr, uint8_t u8AddrLen);
+int8_t SIM_WincListen(SOCKET sock, uint8_t backlog);
+int8_t SIM_WincAccept(SOCKET sock, struct sockaddr *addr, uint8_t *addrlen);
+int16_t SIM_WincSend(SOCKET sock, void *pvSendBuffer, uint16_t u16SendLength, uint16_t u16Flags);
+int16_t SIM_WincSendTo(SOCKET sock, void *pvSendBuffer, uint16_t u16SendLength, uint16_t flags, struct sockaddr *pstrDestAddr, uint8_t u8AddrLen);
+int16_t SIM_WincRecv(SOCKET sock, void *pvRecvBuf, uint16_t u16BufLen, uint32_t u32Timeoutmsec);
+int16_t SIM_WincRecvFrom(SOCKET sock, void *pvRecvBuf, uint16_t u16BufLen, uint32_t u32Timeoutmsec);
+int8_t SIM_WincSetSockOpt(SOCKET socket, uint8_t u8Level, uint8_t option_name, const void *option_value, uint16_t u16OptionLen);
+int8_t SIM_WincShutdown(SOCKET sock);
+
+typedef uintptr_t SYS_TIME_HANDLE;
+
+#define SYS_TIME_HANDLE_INVALID     ((SYS_TIME_HANDLE) (-1))
+
+typedef enum
+{
+    SYS_TIME_SINGLE,
+    SYS_TIME_PERIODIC
+} SYS_TIME_CALLBACK_TYPE;
+
+typedef enum
+{
+    SYS_TIME_SUCCESS = 0,
+    SYS_TIME_ERROR = -1
+} SYS_TIME_RESULT;
+
+typedef void (*SYS_TIME_CALLBACK)(uintptr_t context);
+
+SYS_TIME_HANDLE SYS_TIME_CallbackRegisterMS(SYS_TIME_CALLBACK callback, uintptr_t context, uint32_t ms, SYS_TIME_CALLBACK_TYPE type);
+SYS_TIME_RESULT SYS_TIME_TimerStop(SYS_TIME_HANDLE handle);
+SYS_TIME_RESULT SYS_TIME_TimerDestroy(SYS_TIME_HANDLE handle);
+uint32_t SYS_TIME_CounterGet(void);
+uint64_t SYS_TIME_Counter64Get(void);
+uint32_t SYS_TIME_CountToMS(uint32_t count);
+uint32_t SYS_TIME_MSToCount(uint32_t ms);
+
+void RTC_RTCCTimeGet(struct tm *currentTime);
+
+#endif /* HOST_SOCKET_H */
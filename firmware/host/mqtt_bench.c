@@ -0,0 +1,352 @@
+/*
+    \file   mqtt_bench.c
+
+    \brief  Throughput and copy count benchmark of the MQTT stack.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+// Measures packets per second and the number of bytes the stack copies per
+// PUBLISH sent and received. Copies are counted by wrapping memcpy/memmove 
+// and MQTT_ExchangeBufferLinearize() at link time (see CMakeLists.txt), so 
+// the numbers include every byte moved through the Tx and Rx rings.
+//
+// Usage: mqtt_bench [iterations]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "host_sim.h"
+#include "mqtt/mqtt_core/mqtt_core.h"
+#include "mqtt/mqtt_packetTransfer_interface.h"
+
+#define BENCH_DEFAULT_ITERATIONS    100000UL
+#define BENCH_RX_SEGMENT            1400U   // Received TCP segments, at most one MSS
+#define BENCH_RX_BATCH              16U     // PUBLISH packets per received stream
+#define BENCH_MAX_PAYLOAD           4096U
+
+typedef struct
+{
+	const char *name;
+	uint16_t payloadLength;
+	uint8_t qos;
+	bool streaming;
+} benchScenario;
+
+static const benchScenario benchTx[] =
+{
+	{ "publish qos0", 16, 0, false },
+	{ "publish qos0", 256, 0, false },
+	{ "publish qos0", 1024, 0, false },
+	{ "publish qos0", 4096, 0, false },
+	{ "publish qos1+puback", 16, 1, false },
+	{ "publish qos1+puback", 256, 1, false },
+};
+
+static const benchScenario benchRx[] =
+{
+	{ "receive qos0", 16, 0, false },
+	{ "receive qos0", 256, 0, false },
+	{ "receive qos0", 1024, 0, false },
+	{ "receive qos1", 256, 1, false },
+	{ "receive stream qos0", 256, 0, true },
+	{ "receive stream qos0", 4096, 0, true },
+};
+
+static char benchTxTopic[] = "devices/bench/messages/events/";
+static char benchRxTopic[] = "devices/bench/messages/devicebound/%24.to=bench";
+static char benchRxStreamTopic[] = "$iothub/twin/res/200/?$rid=1";
+
+static uint8_t benchPayload[BENCH_MAX_PAYLOAD];
+static uint8_t benchStream[BENCH_RX_BATCH * (BENCH_MAX_PAYLOAD + 128)];
+static volatile uint32_t benchDelivered;
+
+/* Copy accounting */
+
+static bool benchCounting;
+static uint64_t benchCopied;
+
+void *__real_memcpy(void *destination, const void *source, size_t length);
+void *__real_memmove(void *destination, const void *source, size_t length);
+uint8_t *__real_MQTT_ExchangeBufferLinearize(exchangeBuffer *buffer, uint16_t length);
+
+void *__wrap_memcpy(void *destination, const void *source, size_t length)
+{
+	if (benchCounting == true)
+	{
+		benchCopied += length;
+	}
+	return __real_memcpy(destination, source, length);
+}
+
+void *__wrap_memmove(void *destination, const void *source, size_t length)
+{
+	if (benchCounting == true)
+	{
+		benchCopied += length;
+	}
+	return __real_memmove(destination, source, length);
+}
+
+uint8_t *__wrap_MQTT_ExchangeBufferLinearize(exchangeBuffer *buffer, uint16_t length)
+{
+	uint16_t offset = buffer->currentLocation - buffer->start;
+	uint16_t firstLength = buffer->bufferLength - offset;
+
+	// Moves are counted by the memcpy/memmove wrappers, except when there is
+	// too little free space and the whole buffer is rotated in place, which
+	// moves every byte of it twice
+	if ((benchCounting == true) && (offset + length >= buffer->bufferLength) 
+		&& (buffer->dataLength > firstLength) && (buffer->bufferLength - buffer->dataLength < firstLength))
+	{
+		benchCopied += 2U * buffer->bufferLength;
+	}
+	return __real_MQTT_ExchangeBufferLinearize(buffer, length);
+}
+
+/* Helpers */
+
+static double benchNow(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static void benchReceived(uint8_t *topic, uint8_t *payload)
+{
+	benchDelivered++;
+}
+
+static void benchStreamBegin(void *context, uint8_t *topic, uint32_t payloadLength)
+{
+}
+
+static void benchStreamData(void *context, uint8_t *data, uint16_t length)
+{
+}
+
+static void benchStreamEnd(void *context, bool complete)
+{
+	*(volatile uint32_t *) context += (complete == true);
+}
+
+static publishReceptionHandler_t benchHandlers[] =
+{
+	{ .topic = "devices/bench/messages/devicebound/#", .mqttHandlePublishDataCallBack = benchReceived },
+	{ .topic = "$iothub/twin/res/#", .mqttPublishBeginCallBack = benchStreamBegin, .mqttPublishDataCallBack = benchStreamData, .mqttPublishEndCallBack = benchStreamEnd, .mqttPublishContext = (void *) &benchDelivered },
+};
+
+static mqttContext *benchConnect(void)
+{
+	static const uint8_t connack[] = { 0x20, 0x02, 0x00, 0x00 };
+	mqttConnectPacket connectPacket;
+	mqttContext *context;
+
+	SIM_Reset();
+	MQTT_ClientInitialise();
+	context = MQTT_GetClientConnectionInfo();
+	MQTT_SetPublishReceptionHandlerTable(benchHandlers, sizeof(benchHandlers) / sizeof(benchHandlers[0]));
+	SIM_SocketConnect();
+
+	memset(&connectPacket, 0, sizeof(connectPacket));
+	connectPacket.clientID = (uint8_t *) "bench";
+	connectPacket.connectVariableHeader.keepAliveTimer = 60;
+	connectPacket.connectVariableHeader.connectFlagsByte.cleanSession = 1;
+	MQTT_CreateConnectPacket(&connectPacket);
+	MQTT_TransmissionHandler(context);
+	SIM_SocketInject(connack, sizeof(connack), sizeof(connack));
+	SIM_MainLoop();
+	if (MQTT_GetConnectionState() != CONNECTED)
+	{
+		fprintf(stderr, "bench: connection not established\n");
+		exit(1);
+	}
+	return context;
+}
+
+static size_t benchEncodePublish(uint8_t *output, const char *topic, uint16_t payloadLength, uint8_t qos, uint16_t packetIdentifier)
+{
+	size_t topicLength = strlen(topic);
+	uint32_t remainingLength = 2 + topicLength + ((qos > 0) ? 2 : 0) + payloadLength;
+	size_t i = 0;
+	uint8_t encoded;
+
+	output[i++] = 0x30 | (qos << 1);
+	do
+	{
+		encoded = remainingLength % 128;
+		remainingLength /= 128;
+		output[i++] = encoded | ((remainingLength > 0) ? 0x80 : 0);
+	} while (remainingLength > 0);
+	output[i++] = topicLength >> 8;
+	output[i++] = topicLength & 0xFF;
+	memcpy(&output[i], topic, topicLength);
+	i += topicLength;
+	if (qos > 0)
+	{
+		output[i++] = packetIdentifier >> 8;
+		output[i++] = packetIdentifier & 0xFF;
+	}
+	memcpy(&output[i], benchPayload, payloadLength);
+	return i + payloadLength;
+}
+
+static void benchReport(const benchScenario *scenario, unsigned long packets, double seconds, uint64_t wireBytes)
+{
+	printf("%-22s %7u %12.0f %9.1f %12.1f %10.1f\n", scenario->name, scenario->payloadLength, packets / seconds, 
+		wireBytes / seconds / 1e6, (double) benchCopied / packets, (double) wireBytes / packets);
+}
+
+/* Scenarios */
+
+static void benchPublish(const benchScenario *scenario, unsigned long iterations)
+{
+	uint8_t puback[4] = { 0x40, 0x02, 0x00, 0x00 };
+	mqttPublishPacket publishPacket;
+	mqttContext *context = benchConnect();
+	uint64_t sentBytes = SIM_SocketGetStats()->sentBytes;
+	uint16_t packetIdentifier = 0;
+	const uint8_t *sent;
+	size_t sentLength;
+	unsigned long i;
+	double start;
+
+	memset(&publishPacket, 0, sizeof(publishPacket));
+	publishPacket.topic = (uint8_t *) benchTxTopic;
+	publishPacket.payload = benchPayload;
+	publishPacket.payloadLength = scenario->payloadLength;
+	publishPacket.publishHeaderFlags.qos = scenario->qos;
+
+	if (scenario->qos > 0)
+	{
+		// Learn the first packet identifier, the following ones are sequential
+		SIM_SocketCapture(true);
+		MQTT_CreatePublishPacket(&publishPacket);
+		MQTT_TransmissionHandler(context);
+		sent = SIM_SocketSentData(&sentLength);
+		for (i = 1; (sent[i] & 0x80) != 0; i++)
+		{
+		}
+		i += 1 + 2 + strlen(benchTxTopic);
+		packetIdentifier = (sent[i] << 8) | sent[i + 1];
+		SIM_SocketCapture(false);
+		puback[2] = packetIdentifier >> 8;
+		puback[3] = packetIdentifier & 0xFF;
+		SIM_SocketInject(puback, sizeof(puback), sizeof(puback));
+		SIM_MainLoop();
+		sentBytes = SIM_SocketGetStats()->sentBytes;
+	}
+
+	benchCopied = 0;
+	benchCounting = true;
+	start = benchNow();
+	for (i = 0; i < iterations; i++)
+	{
+		if (MQTT_CreatePublishPacket(&publishPacket) == false)
+		{
+			fprintf(stderr, "bench: %s %u failed at %lu\n", scenario->name, scenario->payloadLength, i);
+			exit(1);
+		}
+		MQTT_TransmissionHandler(context);
+		if (scenario->qos > 0)
+		{
+			packetIdentifier = (packetIdentifier == 0xFFFF) ? 1 : packetIdentifier + 1;
+			puback[2] = packetIdentifier >> 8;
+			puback[3] = packetIdentifier & 0xFF;
+			SIM_SocketInject(puback, sizeof(puback), sizeof(puback));
+		}
+		// Send completions, and the PUBACK
+		SIM_MainLoop();
+	}
+	benchCounting = false;
+	benchReport(scenario, iterations, benchNow() - start, SIM_SocketGetStats()->sentBytes - sentBytes);
+}
+
+static void benchReceive(const benchScenario *scenario, unsigned long iterations)
+{
+	const char *topic = (scenario->streaming == true) ? benchRxStreamTopic : benchRxTopic;
+	unsigned long batches = (iterations + BENCH_RX_BATCH - 1) / BENCH_RX_BATCH;
+	unsigned long i;
+	size_t streamLength = 0;
+	size_t offset;
+	size_t segment;
+	uint16_t packet;
+	double start;
+
+	benchConnect();
+	for (packet = 0; packet < BENCH_RX_BATCH; packet++)
+	{
+		streamLength += benchEncodePublish(&benchStream[streamLength], topic, scenario->payloadLength, scenario->qos, packet + 1);
+	}
+
+	benchDelivered = 0;
+	benchCopied = 0;
+	benchCounting = true;
+	start = benchNow();
+	for (i = 0; i < batches; i++)
+	{
+		// Each TCP segment is followed by a run of the main loop, as on a 
+		// socket event
+		for (offset = 0; offset < streamLength; offset += segment)
+		{
+			segment = ((streamLength - offset) > BENCH_RX_SEGMENT) ? BENCH_RX_SEGMENT : (streamLength - offset);
+			SIM_SocketInject(&benchStream[offset], segment, segment);
+			SIM_MainLoop();
+		}
+	}
+	benchCounting = false;
+	if (benchDelivered != batches * BENCH_RX_BATCH)
+	{
+		fprintf(stderr, "bench: %s %u delivered %u of %lu\n", scenario->name, scenario->payloadLength, benchDelivered, batches * BENCH_RX_BATCH);
+		exit(1);
+	}
+	benchReport(scenario, batches * BENCH_RX_BATCH, benchNow() - start, (uint64_t) batches * streamLength);
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long iterations = BENCH_DEFAULT_ITERATIONS;
+	size_t i;
+
+	if (argc > 1)
+	{
+		iterations = strtoul(argv[1], NULL, 0);
+	}
+	for (i = 0; i < sizeof(benchPayload); i++)
+	{
+		benchPayload[i] = 'a' + i % 26;
+	}
+
+	printf("%-22s %7s %12s %9s %12s %10s\n", "scenario", "payload", "packets/s", "MB/s", "copied/pkt", "wire/pkt");
+	for (i = 0; i < sizeof(benchTx) / sizeof(benchTx[0]); i++)
+	{
+		benchPublish(&benchTx[i], iterations);
+	}
+	for (i = 0; i < sizeof(benchRx) / sizeof(benchRx[0]); i++)
+	{
+		benchReceive(&benchRx[i], iterations);
+	}
+	return 0;
+}
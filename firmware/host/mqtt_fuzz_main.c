@@ -0,0 +1,223 @@
+/*
+    \file   mqtt_fuzz_main.c
+
+    \brief  Stand-alone driver for the reception fuzz target.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+// Used when the compiler has no libFuzzer (GCC). Runs the files given on the
+// command line through LLVMFuzzerTestOneInput(), e.g. to replay a crash found
+// on a clang build, then the built-in seeds and, with -runs=N, N random 
+// mutations of them. -seed=S makes the random inputs reproducible.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define FUZZ_MAX_INPUT      4096
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+typedef struct
+{
+	const uint8_t *data;
+	size_t size;
+} fuzzSeed;
+
+// Control byte, segment length - 1, then the received stream
+static const uint8_t seedPublish[] = 
+{
+	0x02, 0xFF,
+	0x30, 0x1B, 0x00, 0x16, '$', 'i', 'o', 't', 'h', 'u', 'b', '/', 'm', 'e', 't', 'h', 'o', 'd', 's', '/', 'P', 'O', 'S', 'T', '/', '#', 'h', 'i', '!',
+	0x32, 0x09, 0x00, 0x05, 'a', '/', 'b', '/', 'c', 0x00, 0x07,
+};
+static const uint8_t seedConnack[] = 
+{
+	0x00, 0x00,
+	0x20, 0x02, 0x00, 0x00, 0xD0, 0x00, 0x40, 0x02, 0x00, 0x01,
+};
+static const uint8_t seedSuback[] = 
+{
+	0x0E, 0x03,
+	0x90, 0x04, 0x00, 0x01, 0x00, 0x01, 0xD0, 0x00,
+};
+static const uint8_t seedStream[] = 
+{
+	0x03, 0x07,
+	0x32, 0xA0, 0x01, 0x00, 0x14, '$', 'i', 'o', 't', 'h', 'u', 'b', '/', 't', 'w', 'i', 'n', '/', 'r', 'e', 's', '/', '2', '0', '0', 0x00, 0x02,
+	'{', '"', 'd', 'e', 's', 'i', 'r', 'e', 'd', '"', ':', '{', '}', '}',
+};
+static const uint8_t seedLength[] = 
+{
+	0x02, 0x40,
+	0x30, 0xFF, 0xFF, 0xFF, 0x7F, 0x00, 0x01, 'x', 0x30, 0x80, 0x80, 0x80, 0x80, 0x01,
+};
+
+static const fuzzSeed fuzzSeeds[] =
+{
+	{ seedPublish, sizeof(seedPublish) },
+	{ seedConnack, sizeof(seedConnack) },
+	{ seedSuback, sizeof(seedSuback) },
+	{ seedStream, sizeof(seedStream) },
+	{ seedLength, sizeof(seedLength) },
+};
+
+#define FUZZ_NUM_SEEDS      (sizeof(fuzzSeeds) / sizeof(fuzzSeeds[0]))
+
+static uint32_t fuzzRandomState = 1;
+
+static uint32_t fuzzRandom(void)
+{
+	// xorshift32
+	fuzzRandomState ^= fuzzRandomState << 13;
+	fuzzRandomState ^= fuzzRandomState >> 17;
+	fuzzRandomState ^= fuzzRandomState << 5;
+	return fuzzRandomState;
+}
+
+static size_t fuzzMutate(uint8_t *input, size_t size)
+{
+	const fuzzSeed *other;
+	uint32_t mutations = 1 + fuzzRandom() % 8;
+	size_t position;
+	size_t length;
+
+	while (mutations-- > 0)
+	{
+		position = (size > 0) ? fuzzRandom() % size : 0;
+		switch (fuzzRandom() % 6)
+		{
+			case 0:
+				// Flip a bit
+				if (size > 0)
+				{
+					input[position] ^= 1 << (fuzzRandom() % 8);
+				}
+				break;
+			case 1:
+				// Interesting byte values
+				if (size > 0)
+				{
+					static const uint8_t interesting[] = { 0x00, 0x01, 0x7F, 0x80, 0xFF, 0x30, 0x32, 0x40 };
+					input[position] = interesting[fuzzRandom() % sizeof(interesting)];
+				}
+				break;
+			case 2:
+				// Insert random bytes
+				length = 1 + fuzzRandom() % 16;
+				if (size + length <= FUZZ_MAX_INPUT)
+				{
+					memmove(&input[position + length], &input[position], size - position);
+					while (length-- > 0)
+					{
+						input[position + length] = fuzzRandom();
+						size++;
+					}
+				}
+				break;
+			case 3:
+				// Erase bytes
+				length = 1 + fuzzRandom() % 16;
+				if (position + length <= size)
+				{
+					memmove(&input[position], &input[position + length], size - position - length);
+					size -= length;
+				}
+				break;
+			case 4:
+				// Append the stream of another seed
+				other = &fuzzSeeds[fuzzRandom() % FUZZ_NUM_SEEDS];
+				if (size + other->size - 2 <= FUZZ_MAX_INPUT)
+				{
+					memcpy(&input[size], &other->data[2], other->size - 2);
+					size += other->size - 2;
+				}
+				break;
+			default:
+				// Truncate
+				size = position;
+				break;
+		}
+	}
+	return size;
+}
+
+static int fuzzRunFile(const char *path)
+{
+	static uint8_t input[1024 * 1024];
+	FILE *file = fopen(path, "rb");
+	size_t size;
+
+	if (file == NULL)
+	{
+		perror(path);
+		return -1;
+	}
+	size = fread(input, 1, sizeof(input), file);
+	fclose(file);
+	printf("fuzz: running %s (%zu bytes)\n", path, size);
+	LLVMFuzzerTestOneInput(input, size);
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	static uint8_t input[FUZZ_MAX_INPUT];
+	unsigned long runs = 0;
+	unsigned long run;
+	const fuzzSeed *seed;
+	size_t size;
+	size_t i;
+	int arg;
+
+	for (arg = 1; arg < argc; arg++)
+	{
+		if (strncmp(argv[arg], "-runs=", 6) == 0)
+		{
+			runs = strtoul(&argv[arg][6], NULL, 0);
+		}
+		else if (strncmp(argv[arg], "-seed=", 6) == 0)
+		{
+			fuzzRandomState = strtoul(&argv[arg][6], NULL, 0) | 1;
+		}
+		else if (fuzzRunFile(argv[arg]) != 0)
+		{
+			return 1;
+		}
+	}
+
+	for (i = 0; i < FUZZ_NUM_SEEDS; i++)
+	{
+		LLVMFuzzerTestOneInput(fuzzSeeds[i].data, fuzzSeeds[i].size);
+	}
+	for (run = 0; run < runs; run++)
+	{
+		seed = &fuzzSeeds[fuzzRandom() % FUZZ_NUM_SEEDS];
+		memcpy(input, seed->data, seed->size);
+		size = fuzzMutate(input, seed->size);
+		LLVMFuzzerTestOneInput(input, size);
+	}
+	printf("fuzz: %zu seeds and %lu random inputs done\n", FUZZ_NUM_SEEDS, runs);
+	return 0;
+}
@@ -0,0 +1,186 @@
+/*
+    \file   mqtt_fuzz_reception.c
+
+    \brief  libFuzzer entry point for the MQTT reception path.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+// Input layout:
+//   byte 0   control bits
+//            0x01 connect with cleanSession = 1
+//            0x02 start CONNECTED (a valid CONNACK is injected first)
+//            0x04 SUBSCRIBE once connected, so that a SUBACK is expected
+//            0x08 advance the clock by one second after every segment
+//   byte 1   segment length - 1, the size of the WINC receive callbacks
+//   byte 2.. received byte stream
+//
+// Every segment is followed by a run of the main loop, which reads it through
+// the BSD adapter and dispatches it. The handlers below check that what 
+// reaches the application is consistent.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_sim.h"
+#include "mqtt/mqtt_core/mqtt_core.h"
+#include "mqtt/mqtt_packetTransfer_interface.h"
+
+#define FUZZ_CLEAN_SESSION      0x01
+#define FUZZ_START_CONNECTED    0x02
+#define FUZZ_SUBSCRIBE          0x04
+#define FUZZ_ADVANCE_CLOCK      0x08
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+static uint32_t streamLength;
+static uint32_t streamReceived;
+static bool streamActive;
+
+static void fuzzCheck(bool condition, const char *message)
+{
+	if (condition == false)
+	{
+		fprintf(stderr, "fuzz: %s\n", message);
+		abort();
+	}
+}
+
+static void fuzzPublishData(uint8_t *topic, uint8_t *payload)
+{
+	// Both are expected to be NUL terminated
+	fuzzCheck(strlen((char *) topic) < TOPIC_SIZE, "topic too long");
+	(void) strlen((char *) payload);
+}
+
+static void fuzzPublishBegin(void *context, uint8_t *topic, uint32_t payloadLength)
+{
+	fuzzCheck(context == &streamActive, "wrong stream context");
+	fuzzCheck(streamActive == false, "stream begun twice");
+	fuzzCheck(strlen((char *) topic) < TOPIC_SIZE, "topic too long");
+	streamActive = true;
+	streamLength = payloadLength;
+	streamReceived = 0;
+}
+
+static void fuzzPublishStreamData(void *context, uint8_t *data, uint16_t length)
+{
+	volatile uint8_t sink = 0;
+	uint16_t i;
+
+	fuzzCheck(context == &streamActive, "wrong stream context");
+	fuzzCheck(streamActive == true, "data outside a stream");
+	for (i = 0; i < length; i++)
+	{
+		sink ^= data[i];
+	}
+	streamReceived += length;
+	fuzzCheck(streamReceived <= streamLength, "stream longer than announced");
+}
+
+static void fuzzPublishEnd(void *context, bool complete)
+{
+	fuzzCheck(context == &streamActive, "wrong stream context");
+	fuzzCheck(streamActive == true, "end outside a stream");
+	fuzzCheck((complete == false) || (streamReceived == streamLength), "stream shorter than announced");
+	streamActive = false;
+}
+
+static publishReceptionHandler_t fuzzHandlers[] =
+{
+	{ .topic = "$iothub/methods/POST/#", .mqttHandlePublishDataCallBack = fuzzPublishData },
+	{ .topic = "$iothub/twin/res/#", .mqttPublishBeginCallBack = fuzzPublishBegin, .mqttPublishDataCallBack = fuzzPublishStreamData, .mqttPublishEndCallBack = fuzzPublishEnd, .mqttPublishContext = &streamActive },
+	{ .topic = "a/+/c", .mqttHandlePublishDataCallBack = fuzzPublishData },
+	{ .topic = "#", .mqttHandlePublishDataCallBack = fuzzPublishData },
+};
+
+static uint8_t fuzzTopic1[] = "$iothub/methods/POST/#";
+static uint8_t fuzzTopic2[] = "$iothub/twin/res/#";
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	static const uint8_t connack[] = { 0x20, 0x02, 0x01, 0x00 };
+	mqttConnectPacket connectPacket;
+	mqttSubscribePacket subscribePacket;
+	mqttContext *context;
+	uint8_t control;
+	uint16_t segmentLength;
+	size_t segment;
+
+	if (size < 2)
+	{
+		return 0;
+	}
+	control = data[0];
+	segmentLength = (uint16_t) data[1] + 1;
+	data += 2;
+	size -= 2;
+
+	SIM_Reset();
+	MQTT_ClientInitialise();
+	context = MQTT_GetClientConnectionInfo();
+	MQTT_SetPublishReceptionHandlerTable(fuzzHandlers, sizeof(fuzzHandlers) / sizeof(fuzzHandlers[0]));
+	SIM_SocketConnect();
+
+	memset(&connectPacket, 0, sizeof(connectPacket));
+	connectPacket.clientID = (uint8_t *) "fuzz";
+	connectPacket.connectVariableHeader.keepAliveTimer = 60;
+	connectPacket.connectVariableHeader.connectFlagsByte.cleanSession = ((control & FUZZ_CLEAN_SESSION) != 0);
+	MQTT_CreateConnectPacket(&connectPacket);
+	MQTT_TransmissionHandler(context);
+
+	if ((control & FUZZ_START_CONNECTED) != 0)
+	{
+		SIM_SocketInject(connack, sizeof(connack), sizeof(connack));
+		SIM_MainLoop();
+		if ((control & FUZZ_SUBSCRIBE) != 0)
+		{
+			memset(&subscribePacket, 0, sizeof(subscribePacket));
+			subscribePacket.subscribePayload[0].topic = fuzzTopic1;
+			subscribePacket.subscribePayload[0].topicLength = sizeof(fuzzTopic1) - 1;
+			subscribePacket.subscribePayload[1].topic = fuzzTopic2;
+			subscribePacket.subscribePayload[1].topicLength = sizeof(fuzzTopic2) - 1;
+			subscribePacket.subscribePayload[1].requestedQoS = 1;
+			MQTT_CreateSubscribePacket(&subscribePacket);
+			MQTT_TransmissionHandler(context);
+		}
+	}
+
+	while (size > 0)
+	{
+		segment = (size > segmentLength) ? segmentLength : size;
+		SIM_SocketInject(data, segment, segmentLength);
+		data += segment;
+		size -= segment;
+
+		SIM_MainLoop();
+		if ((control & FUZZ_ADVANCE_CLOCK) != 0)
+		{
+			SIM_ClockAdvance(1000);
+			MQTT_sched();
+		}
+	}
+
+	// Connection lost; a stream left open is ended by the next CONNECT
+	MQTT_initialiseState();
+	return 0;
+}
@@ -0,0 +1,412 @@
+/*
+    \file   mqtt_test.c
+
+    \brief  Assertion tests of the MQTT stack on the host simulation.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+// Checks the behaviour the fuzzer cannot tell right from wrong: which topic
+// filter a PUBLISH is delivered to, the QoS 1 retransmission with the DUP
+// flag, and the timeouts of the deadline table. Prints every failed check
+// and exits with 1 if there was one.
+//
+// Usage: mqtt_test
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "host_sim.h"
+#include "mqtt/mqtt_core/mqtt_core.h"
+#include "mqtt/mqtt_packetTransfer_interface.h"
+
+#define TEST_STEP                   100U    // ms between two runs of the main loop
+#define TEST_PUBLISH_DUP            0x08U
+
+#define TEST_CHECK(condition)       testCheck((condition), #condition, __LINE__)
+
+static unsigned testFailures;
+
+static void testCheck(bool condition, const char *text, int line)
+{
+	if (condition == false)
+	{
+		fprintf(stderr, "mqtt_test.c:%d: check failed: %s\n", line, text);
+		testFailures++;
+	}
+}
+
+// Index 0 to 7 in the order of the checks below; 14 trie nodes with the root
+static publishReceptionHandler_t testTrieHandlers[] =
+{
+	{ .topic = "a/b/c" },
+	{ .topic = "a/+/c" },
+	{ .topic = "a/b/#" },
+	{ .topic = "a/+/d" },
+	{ .topic = "a/#" },
+	{ .topic = "+/d" },
+	{ .topic = "#" },
+	{ .topic = "$SYS/#" },
+};
+
+// IoT Hub style: many method routes under the one subscribed methods filter
+static publishReceptionHandler_t testRouteHandlers[] =
+{
+	{ .topic = "$iothub/methods/POST/reboot/#" },
+	{ .topic = "$iothub/methods/POST/blink/#" },
+	{ .topic = "$iothub/methods/POST/report/#" },
+	{ .topic = "$iothub/methods/POST/reset/#" },
+	{ .topic = "$iothub/methods/POST/sleep/#" },
+	{ .topic = "$iothub/methods/POST/#" },
+	{ .topic = "$iothub/twin/PATCH/properties/desired/#" },
+	{ .topic = "$iothub/twin/res/#" },
+};
+
+// 2 levels per character: longer than the whole topic index
+static char testLongFilter[2 * MAX_NUM_TOPIC_TRIE_NODES];
+
+static publishReceptionHandler_t testOverflowHandlers[] =
+{
+	{ .topic = "a/b" },
+	{ .topic = testLongFilter },
+	{ .topic = "a/c" },
+	{ .topic = "d/e" },
+};
+
+static publishReceptionHandler_t testHandlers[] =
+{
+	{ .topic = "t" },
+};
+
+static publishReceptionHandler_t *testFind(const char *topic)
+{
+	return MQTT_FindPublishReceptionHandler((uint8_t *) topic);
+}
+
+static void testTrie(void)
+{
+	MQTT_SetPublishReceptionHandlerTable(testTrieHandlers, sizeof(testTrieHandlers) / sizeof(testTrieHandlers[0]));
+
+	// An exact level wins over '+', which wins over '#'
+	TEST_CHECK(testFind("a/b/c") == &testTrieHandlers[0]);
+	TEST_CHECK(testFind("a/x/c") == &testTrieHandlers[1]);
+	TEST_CHECK(testFind("a/b/e") == &testTrieHandlers[2]);
+	TEST_CHECK(testFind("a/b/d") == &testTrieHandlers[2]);
+	TEST_CHECK(testFind("a/x/d") == &testTrieHandlers[3]);
+	TEST_CHECK(testFind("a/x/y") == &testTrieHandlers[4]);
+	// '#' also matches the parent level
+	TEST_CHECK(testFind("a") == &testTrieHandlers[4]);
+	// Back from the exact 'a' to its '#' rather than on to the root '+'
+	TEST_CHECK(testFind("a/d") == &testTrieHandlers[4]);
+	TEST_CHECK(testFind("q/d") == &testTrieHandlers[5]);
+	TEST_CHECK(testFind("q/e") == &testTrieHandlers[6]);
+	TEST_CHECK(testFind("q") == &testTrieHandlers[6]);
+	// Wildcards at the first level do not match the topics starting with '$'
+	TEST_CHECK(testFind("$SYS/x") == &testTrieHandlers[7]);
+	TEST_CHECK(testFind("$SYS") == &testTrieHandlers[7]);
+	TEST_CHECK(testFind("$other/d") == NULL);
+	TEST_CHECK(testFind("$other") == NULL);
+
+	// Without the exact filter, '#' under the exact 'b' beats '+' under 'a'
+	MQTT_SetPublishReceptionHandlerTable(&testTrieHandlers[1], sizeof(testTrieHandlers) / sizeof(testTrieHandlers[0]) - 1);
+	TEST_CHECK(testFind("a/b/c") == &testTrieHandlers[2]);
+	TEST_CHECK(testFind("a/x/c") == &testTrieHandlers[1]);
+}
+
+static void testRoutes(void)
+{
+	MQTT_SetPublishReceptionHandlerTable(testRouteHandlers, sizeof(testRouteHandlers) / sizeof(testRouteHandlers[0]));
+
+	TEST_CHECK(sizeof(testRouteHandlers) / sizeof(testRouteHandlers[0]) <= MAX_NUM_PUBLISH_HANDLERS);
+	TEST_CHECK(testFind("$iothub/methods/POST/reboot/?$rid=1") == &testRouteHandlers[0]);
+	TEST_CHECK(testFind("$iothub/methods/POST/blink/?$rid=2") == &testRouteHandlers[1]);
+	TEST_CHECK(testFind("$iothub/methods/POST/report/?$rid=3") == &testRouteHandlers[2]);
+	TEST_CHECK(testFind("$iothub/methods/POST/reset/?$rid=4") == &testRouteHandlers[3]);
+	TEST_CHECK(testFind("$iothub/methods/POST/sleep/?$rid=5") == &testRouteHandlers[4]);
+	TEST_CHECK(testFind("$iothub/methods/POST/other/?$rid=6") == &testRouteHandlers[5]);
+	TEST_CHECK(testFind("$iothub/twin/PATCH/properties/desired/?$version=7") == &testRouteHandlers[6]);
+	TEST_CHECK(testFind("$iothub/twin/res/200/?$rid=8") == &testRouteHandlers[7]);
+}
+
+// A filter that does not fit leaves nothing behind for the following ones
+static void testTrieOverflow(void)
+{
+	size_t i;
+
+	for (i = 0; i < sizeof(testLongFilter) - 1; i++)
+	{
+		testLongFilter[i] = ((i % 2) == 0) ? 'a' : '/';
+	}
+	testLongFilter[sizeof(testLongFilter) - 1] = '\0';
+
+	MQTT_SetPublishReceptionHandlerTable(testOverflowHandlers, sizeof(testOverflowHandlers) / sizeof(testOverflowHandlers[0]));
+	TEST_CHECK(testFind("a/b") == &testOverflowHandlers[0]);
+	TEST_CHECK(testFind("a/c") == &testOverflowHandlers[2]);
+	TEST_CHECK(testFind("d/e") == &testOverflowHandlers[3]);
+	TEST_CHECK(testFind("a/a") == NULL);
+	TEST_CHECK(testFind(testLongFilter) == NULL);
+}
+
+// A persistent session is reported present by the CONNACK
+static mqttContext *testConnect(uint16_t keepAliveTimer, bool cleanSession)
+{
+	const uint8_t connack[] = { 0x20, 0x02, (cleanSession == true) ? 0x00 : 0x01, 0x00 };
+	mqttConnectPacket connectPacket;
+	mqttContext *context;
+
+	SIM_Reset();
+	MQTT_ClientInitialise();
+	context = MQTT_GetClientConnectionInfo();
+	MQTT_SetPublishReceptionHandlerTable(testHandlers, sizeof(testHandlers) / sizeof(testHandlers[0]));
+	SIM_SocketConnect();
+
+	memset(&connectPacket, 0, sizeof(connectPacket));
+	connectPacket.clientID = (uint8_t *) "test";
+	connectPacket.connectVariableHeader.keepAliveTimer = keepAliveTimer;
+	connectPacket.connectVariableHeader.connectFlagsByte.cleanSession = (cleanSession == true) ? 1 : 0;
+	MQTT_CreateConnectPacket(&connectPacket);
+	MQTT_TransmissionHandler(context);
+	SIM_SocketInject(connack, sizeof(connack), sizeof(connack));
+	SIM_MainLoop();
+	TEST_CHECK(MQTT_GetConnectionState() == CONNECTED);
+	SIM_SocketCapture(true);
+	SIM_SocketSentClear();
+	return context;
+}
+
+// Lets the clock run as the main loop of the application would see it
+static void testRun(uint32_t ms)
+{
+	uint32_t step;
+
+	while (ms > 0)
+	{
+		step = (ms < TEST_STEP) ? ms : TEST_STEP;
+		SIM_ClockAdvance(step);
+		MQTT_sched();
+		SIM_MainLoop();
+		ms -= step;
+	}
+}
+
+// Same, up to a time since the connection
+static void testRunUntil(uint32_t ms)
+{
+	if (ms > SIM_ClockGet())
+	{
+		testRun(ms - SIM_ClockGet());
+	}
+}
+
+static size_t testSentLength(void)
+{
+	size_t sentLength;
+
+	SIM_SocketSentData(&sentLength);
+	return sentLength;
+}
+
+// Sends a QoS 1 PUBLISH on "t" and returns its packet identifier
+static uint16_t testPublish(mqttContext *context, uint8_t *packet, size_t *packetLength)
+{
+	mqttPublishPacket publishPacket;
+	const uint8_t *sent;
+	size_t sentLength;
+
+	memset(&publishPacket, 0, sizeof(publishPacket));
+	publishPacket.topic = (uint8_t *) "t";
+	publishPacket.payload = (uint8_t *) "x";
+	publishPacket.payloadLength = 1;
+	publishPacket.publishHeaderFlags.qos = 1;
+
+	SIM_SocketSentClear();
+	TEST_CHECK(MQTT_CreatePublishPacket(&publishPacket) == true);
+	MQTT_TransmissionHandler(context);
+	SIM_MainLoop();
+	sent = SIM_SocketSentData(&sentLength);
+	// Fixed header, topic length, "t", packet identifier, "x"
+	TEST_CHECK(sentLength == 2 + 2 + 1 + 2 + 1);
+	if (sentLength != 2 + 2 + 1 + 2 + 1)
+	{
+		return 0;
+	}
+	TEST_CHECK(sent[0] == 0x32);
+	if (packet != NULL)
+	{
+		memcpy(packet, sent, sentLength);
+		*packetLength = sentLength;
+	}
+	SIM_SocketSentClear();
+	return (sent[5] << 8) | sent[6];
+}
+
+static void testPuback(uint16_t packetIdentifier)
+{
+	uint8_t puback[] = { 0x40, 0x02, packetIdentifier >> 8, packetIdentifier & 0xFF };
+
+	SIM_SocketInject(puback, sizeof(puback), sizeof(puback));
+	SIM_MainLoop();
+}
+
+static void testRetransmit(void)
+{
+	mqttContext *context = testConnect(0, true);
+	uint8_t original[16];
+	size_t originalLength = 0;
+	const uint8_t *sent;
+	size_t sentLength;
+	uint16_t packetIdentifier;
+
+	packetIdentifier = testPublish(context, original, &originalLength);
+
+	testRun(WAITFORPUBACK_TIMEOUT - TEST_STEP);
+	TEST_CHECK(testSentLength() == 0);
+
+	// The same packet again, with only the DUP flag added
+	testRun(2 * TEST_STEP);
+	sent = SIM_SocketSentData(&sentLength);
+	TEST_CHECK(sentLength == originalLength);
+	if ((sentLength == originalLength) && (originalLength != 0))
+	{
+		TEST_CHECK(sent[0] == (original[0] | TEST_PUBLISH_DUP));
+		TEST_CHECK(memcmp(&sent[1], &original[1], originalLength - 1) == 0);
+	}
+	SIM_SocketSentClear();
+
+	// Still not acknowledged: sent once more after another timeout
+	testRun(WAITFORPUBACK_TIMEOUT + TEST_STEP);
+	sent = SIM_SocketSentData(&sentLength);
+	TEST_CHECK(sentLength == originalLength);
+	if (sentLength != 0)
+	{
+		TEST_CHECK(sent[0] == (original[0] | TEST_PUBLISH_DUP));
+	}
+	SIM_SocketSentClear();
+
+	// Acknowledged: never again
+	testPuback(packetIdentifier);
+	testRun(2 * WAITFORPUBACK_TIMEOUT);
+	TEST_CHECK(testSentLength() == 0);
+	TEST_CHECK(MQTT_GetConnectionState() == CONNECTED);
+}
+
+// Two PUBACK deadlines and the keep alive ones share one timer: each must
+// still expire on its own time. Times are from the connection.
+static void testDeadlines(void)
+{
+	static const uint8_t pingreq[] = { 0xC0, 0x00 };
+	mqttContext *context = testConnect(60, true);
+	// The core sends PINGREQ a second before the keep alive the broker is told
+	uint32_t keepAliveInterval = (60 - 1) * SECONDS;
+	uint32_t closeCalls = SIM_SocketGetStats()->closeCalls;
+	uint32_t second = 10 * SECONDS;
+	uint16_t firstIdentifier;
+	uint16_t secondIdentifier;
+	const uint8_t *sent;
+	size_t sentLength;
+
+	firstIdentifier = testPublish(context, NULL, NULL);
+	testRunUntil(second);
+	secondIdentifier = testPublish(context, NULL, NULL);
+	testRunUntil(15 * SECONDS);
+	testPuback(firstIdentifier);
+
+	// The first deadline is gone with its PUBACK, the second one is not
+	testRunUntil(second + WAITFORPUBACK_TIMEOUT - TEST_STEP);
+	TEST_CHECK(testSentLength() == 0);
+	testRunUntil(second + WAITFORPUBACK_TIMEOUT + TEST_STEP);
+	sent = SIM_SocketSentData(&sentLength);
+	TEST_CHECK(sentLength != 0);
+	if (sentLength >= 7)
+	{
+		TEST_CHECK(sent[0] == (0x32 | TEST_PUBLISH_DUP));
+		TEST_CHECK(((sent[5] << 8) | sent[6]) == secondIdentifier);
+	}
+	SIM_SocketSentClear();
+	testPuback(secondIdentifier);
+
+	// Every packet sent postpones PINGREQ, the retransmission included
+	testRunUntil(second + WAITFORPUBACK_TIMEOUT + keepAliveInterval - TEST_STEP);
+	TEST_CHECK(testSentLength() == 0);
+	testRunUntil(second + WAITFORPUBACK_TIMEOUT + keepAliveInterval + 2 * TEST_STEP);
+	sent = SIM_SocketSentData(&sentLength);
+	TEST_CHECK(sentLength == sizeof(pingreq));
+	if (sentLength == sizeof(pingreq))
+	{
+		TEST_CHECK(memcmp(sent, pingreq, sizeof(pingreq)) == 0);
+	}
+	SIM_SocketSentClear();
+
+	// No PINGRESP: the connection is given up
+	testRunUntil(second + WAITFORPUBACK_TIMEOUT + keepAliveInterval + WAITFORPINGRESP_TIMEOUT - TEST_STEP);
+	TEST_CHECK(MQTT_GetConnectionState() == CONNECTED);
+	testRunUntil(second + WAITFORPUBACK_TIMEOUT + keepAliveInterval + WAITFORPINGRESP_TIMEOUT + 3 * TEST_STEP);
+	TEST_CHECK(MQTT_GetConnectionState() == DISCONNECTED);
+	TEST_CHECK(SIM_SocketGetStats()->closeCalls == closeCalls + 1);
+}
+
+// A SUBACK timeout closes its own connection only: a resumed session sends
+// no SUBSCRIBE that would reset it
+static void testSubackTimeout(void)
+{
+	mqttContext *context = testConnect(0, true);
+	mqttSubscribePacket subscribePacket;
+	uint32_t closeCalls = SIM_SocketGetStats()->closeCalls;
+
+	memset(&subscribePacket, 0, sizeof(subscribePacket));
+	subscribePacket.packetIdentifierLSB = 1;
+	subscribePacket.subscribePayload[0].topic = (uint8_t *) "t";
+	subscribePacket.subscribePayload[0].topicLength = 1;
+	TEST_CHECK(MQTT_CreateSubscribePacket(&subscribePacket) == true);
+	MQTT_TransmissionHandler(context);
+	SIM_MainLoop();
+	TEST_CHECK(testSentLength() != 0);
+
+	testRunUntil(WAITFORSUBACK_TIMEOUT + 2 * TEST_STEP);
+	TEST_CHECK(MQTT_GetConnectionState() == DISCONNECTED);
+	TEST_CHECK(SIM_SocketGetStats()->closeCalls == closeCalls + 1);
+
+	testConnect(0, false);
+	TEST_CHECK(MQTT_GetSessionPresent() == true);
+	closeCalls = SIM_SocketGetStats()->closeCalls;
+	testRun(2 * WAITFORSUBACK_TIMEOUT);
+	TEST_CHECK(MQTT_GetConnectionState() == CONNECTED);
+	TEST_CHECK(SIM_SocketGetStats()->closeCalls == closeCalls);
+}
+
+int main(void)
+{
+	testTrie();
+	testRoutes();
+	testTrieOverflow();
+	testRetransmit();
+	testDeadlines();
+	testSubackTimeout();
+
+	if (testFailures != 0)
+	{
+		printf("mqtt_test: %u checks failed\n", testFailures);
+		return 1;
+	}
+	printf("mqtt_test: all checks passed\n");
+	return 0;
+}
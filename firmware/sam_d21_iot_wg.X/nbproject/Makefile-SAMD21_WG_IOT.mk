@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../src/azure-sdk-for-c/sdk/src/azure/core/az_precondition.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_span.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_log.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_common.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_c2d.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_methods.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_sas.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_telemetry.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_twin.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_provisioning_client.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_provisioning_client_sas.c ../src/config/SAMD21_WG_IOT/driver/spi/src/drv_spi.c ../src/config/SAMD21_WG_IOT/driver/winc/dev/gpio/wdrv_winc_eint.c ../src/config/SAMD21_WG_IOT/driver/winc/dev/gpio/wdrv_winc_gpio.c ../src/config/SAMD21_WG_IOT/driver/winc/dev/spi/wdrv_winc_spi.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/common/nm_common.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_hif.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_periph.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_wifi.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmasic.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmbus.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmdrv.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmspi.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_ota.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_ssl.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/socket/socket.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/socket/inet_ntop.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/socket/inet_addr.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/spi_flash/spi_flash.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/spi_flash/flexible_flash.c ../src/config/SAMD21_WG_IOT/driver/winc/osal/wdrv_winc_osal.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_assoc.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_authctx.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_bssctx.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_bssfind.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_custie.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_host_file.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_httpprovctx.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_nvm.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_powersave.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_socket.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_softap.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_ssl.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_sta.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_systime.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_wps.c ../src/config/SAMD21_WG_IOT/peripheral/adc/plib_adc.c ../src/config/SAMD21_WG_IOT/peripheral/clock/plib_clock.c ../src/config/SAMD21_WG_IOT/peripheral/dmac/plib_dmac.c ../src/config/SAMD21_WG_IOT/peripheral/eic/plib_eic.c ../src/config/SAMD21_WG_IOT/peripheral/evsys/plib_evsys.c ../src/config/SAMD21_WG_IOT/peripheral/nvic/plib_nvic.c ../src/config/SAMD21_WG_IOT/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/SAMD21_WG_IOT/peripheral/port/plib_port.c ../src/config/SAMD21_WG_IOT/peripheral/rtc/plib_rtc_clock.c ../src/config/SAMD21_WG_IOT/peripheral/sercom/i2c_master/plib_sercom3_i2c_master.c ../src/config/SAMD21_WG_IOT/peripheral/sercom/spim/plib_sercom4_spi.c ../src/config/SAMD21_WG_IOT/peripheral/sercom/usart/plib_sercom5_usart.c ../src/config/SAMD21_WG_IOT/peripheral/tc/plib_tc3.c ../src/config/SAMD21_WG_IOT/stdio/xc32_monitor.c ../src/config/SAMD21_WG_IOT/system/command/src/sys_command.c ../src/config/SAMD21_WG_IOT/system/console/src/sys_console.c ../src/config/SAMD21_WG_IOT/system/console/src/sys_console_uart.c ../src/config/SAMD21_WG_IOT/system/dma/sys_dma.c ../src/config/SAMD21_WG_IOT/system/int/src/sys_int.c ../src/config/SAMD21_WG_IOT/system/time/src/sys_time.c ../src/config/SAMD21_WG_IOT/initialization.c ../src/config/SAMD21_WG_IOT/interrupts.c ../src/config/SAMD21_WG_IOT/exceptions.c ../src/config/SAMD21_WG_IOT/startup_xc32.c ../src/config/SAMD21_WG_IOT/libc_syscalls.c ../src/config/SAMD21_WG_IOT/tasks.c ../src/credentials_storage/credentials_storage.c ../src/cryptoauthlib/lib/atcacert/atcacert_client.c ../src/cryptoauthlib/lib/atcacert/atcacert_date.c ../src/cryptoauthlib/lib/atcacert/atcacert_def.c ../src/cryptoauthlib/lib/atcacert/atcacert_der.c ../src/cryptoauthlib/lib/atcacert/atcacert_host_hw.c ../src/cryptoauthlib/lib/atcacert/atcacert_host_sw.c ../src/cryptoauthlib/lib/atcacert/atcacert_pem.c ../src/cryptoauthlib/lib/basic/atca_basic.c ../src/cryptoauthlib/lib/basic/atca_basic_aes.c ../src/cryptoauthlib/lib/basic/atca_basic_checkmac.c ../src/cryptoauthlib/lib/basic/atca_basic_counter.c ../src/cryptoauthlib/lib/basic/atca_basic_derivekey.c ../src/cryptoauthlib/lib/basic/atca_basic_ecdh.c ../src/cryptoauthlib/lib/basic/atca_basic_gendig.c ../src/cryptoauthlib/lib/basic/atca_basic_genkey.c ../src/cryptoauthlib/lib/basic/atca_basic_hmac.c ../src/cryptoauthlib/lib/basic/atca_basic_info.c ../src/cryptoauthlib/lib/basic/atca_basic_kdf.c ../src/cryptoauthlib/lib/basic/atca_basic_lock.c ../src/cryptoauthlib/lib/basic/atca_basic_mac.c ../src/cryptoauthlib/lib/basic/atca_basic_nonce.c ../src/cryptoauthlib/lib/basic/atca_basic_privwrite.c ../src/cryptoauthlib/lib/basic/atca_basic_random.c ../src/cryptoauthlib/lib/basic/atca_basic_read.c ../src/cryptoauthlib/lib/basic/atca_basic_secureboot.c ../src/cryptoauthlib/lib/basic/atca_basic_selftest.c ../src/cryptoauthlib/lib/basic/atca_basic_sha.c ../src/cryptoauthlib/lib/basic/atca_basic_sign.c ../src/cryptoauthlib/lib/basic/atca_basic_updateextra.c ../src/cryptoauthlib/lib/basic/atca_basic_verify.c ../src/cryptoauthlib/lib/basic/atca_basic_write.c ../src/cryptoauthlib/lib/basic/atca_helpers.c ../src/cryptoauthlib/lib/crypto/hashes/sha1_routines.c ../src/cryptoauthlib/lib/crypto/hashes/sha2_routines.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_ecdsa.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_rand.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_sha1.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_sha2.c ../src/cryptoauthlib/lib/hal/atca_hal.c ../src/cryptoauthlib/lib/hal/hal_i2c.c ../src/cryptoauthlib/lib/hal/hal_timer.c ../src/cryptoauthlib/lib/host/atca_host.c ../src/cryptoauthlib/lib/jwt/atca_jwt.c ../src/cryptoauthlib/lib/tls/atcatls.c ../src/cryptoauthlib/lib/tls/atcatls_cfg.c ../src/cryptoauthlib/lib/atca_cfgs.c ../src/cryptoauthlib/lib/atca_command.c ../src/cryptoauthlib/lib/atca_device.c ../src/cryptoauthlib/lib/atca_execution.c ../src/cryptoauthlib/lib/atca_iface.c ../src/mqtt/mqtt_comm_bsd/mqtt_comm_layer.c ../src/mqtt/mqtt_core/mqtt_core.c ../src/mqtt/mqtt_exchange_buffer/mqtt_exchange_buffer.c ../src/mqtt/mqtt_packetTransfer_interface.c ../src/services/iot/cloud/bsd_adapter/bsdWINC.c ../src/services/iot/cloud/crypto_client/cryptoauthlib_main.c ../src/services/iot/cloud/crypto_client/crypto_client.c ../src/services/iot/cloud/mqtt_packetPopulation/mqtt_packetPopulate.c ../src/services/iot/cloud/mqtt_packetPopulation/mqtt_iothub_packetPopulate.c ../src/services/iot/cloud/mqtt_packetPopulation/mqtt_iotprovisioning_packetPopulate.c ../src/services/iot/cloud/cloud_service.c ../src/services/iot/cloud/wifi_service.c ../src/debug_print.c ../src/main.c ../src/app.c ../src/led.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_reader.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_token.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_writer.c
+SOURCEFILES_QUOTED_IF_SPACED=../src/azure-sdk-for-c/sdk/src/azure/core/az_precondition.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_span.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_log.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_common.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_c2d.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_methods.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_sas.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_telemetry.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_twin.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_provisioning_client.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_provisioning_client_sas.c ../src/config/SAMD21_WG_IOT/driver/spi/src/drv_spi.c ../src/config/SAMD21_WG_IOT/driver/winc/dev/gpio/wdrv_winc_eint.c ../src/config/SAMD21_WG_IOT/driver/winc/dev/gpio/wdrv_winc_gpio.c ../src/config/SAMD21_WG_IOT/driver/winc/dev/spi/wdrv_winc_spi.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/common/nm_common.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_hif.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_periph.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_wifi.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmasic.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmbus.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmdrv.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmspi.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_ota.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_ssl.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/socket/socket.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/socket/inet_ntop.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/socket/inet_addr.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/spi_flash/spi_flash.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/spi_flash/flexible_flash.c ../src/config/SAMD21_WG_IOT/driver/winc/osal/wdrv_winc_osal.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_assoc.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_authctx.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_bssctx.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_bssfind.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_custie.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_host_file.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_httpprovctx.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_nvm.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_powersave.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_socket.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_softap.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_ssl.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_sta.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_systime.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_wps.c ../src/config/SAMD21_WG_IOT/peripheral/adc/plib_adc.c ../src/config/SAMD21_WG_IOT/peripheral/clock/plib_clock.c ../src/config/SAMD21_WG_IOT/peripheral/dmac/plib_dmac.c ../src/config/SAMD21_WG_IOT/peripheral/eic/plib_eic.c ../src/config/SAMD21_WG_IOT/peripheral/evsys/plib_evsys.c ../src/config/SAMD21_WG_IOT/peripheral/nvic/plib_nvic.c ../src/config/SAMD21_WG_IOT/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/SAMD21_WG_IOT/peripheral/port/plib_port.c ../src/config/SAMD21_WG_IOT/peripheral/rtc/plib_rtc_clock.c ../src/config/SAMD21_WG_IOT/peripheral/sercom/i2c_master/plib_sercom3_i2c_master.c ../src/config/SAMD21_WG_IOT/peripheral/sercom/spim/plib_sercom4_spi.c ../src/config/SAMD21_WG_IOT/peripheral/sercom/usart/plib_sercom5_usart.c ../src/config/SAMD21_WG_IOT/peripheral/tc/plib_tc3.c ../src/config/SAMD21_WG_IOT/stdio/xc32_monitor.c ../src/config/SAMD21_WG_IOT/system/command/src/sys_command.c ../src/config/SAMD21_WG_IOT/system/console/src/sys_console.c ../src/config/SAMD21_WG_IOT/system/console/src/sys_console_uart.c ../src/config/SAMD21_WG_IOT/system/dma/sys_dma.c ../src/config/SAMD21_WG_IOT/system/int/src/sys_int.c ../src/config/SAMD21_WG_IOT/system/time/src/sys_time.c ../src/config/SAMD21_WG_IOT/initialization.c ../src/config/SAMD21_WG_IOT/interrupts.c ../src/config/SAMD21_WG_IOT/exceptions.c ../src/config/SAMD21_WG_IOT/startup_xc32.c ../src/config/SAMD21_WG_IOT/libc_syscalls.c ../src/config/SAMD21_WG_IOT/tasks.c ../src/credentials_storage/credentials_storage.c ../src/cryptoauthlib/lib/atcacert/atcacert_client.c ../src/cryptoauthlib/lib/atcacert/atcacert_date.c ../src/cryptoauthlib/lib/atcacert/atcacert_def.c ../src/cryptoauthlib/lib/atcacert/atcacert_der.c ../src/cryptoauthlib/lib/atcacert/atcacert_host_hw.c ../src/cryptoauthlib/lib/atcacert/atcacert_host_sw.c ../src/cryptoauthlib/lib/atcacert/atcacert_pem.c ../src/cryptoauthlib/lib/basic/atca_basic.c ../src/cryptoauthlib/lib/basic/atca_basic_aes.c ../src/cryptoauthlib/lib/basic/atca_basic_checkmac.c ../src/cryptoauthlib/lib/basic/atca_basic_counter.c ../src/cryptoauthlib/lib/basic/atca_basic_derivekey.c ../src/cryptoauthlib/lib/basic/atca_basic_ecdh.c ../src/cryptoauthlib/lib/basic/atca_basic_gendig.c ../src/cryptoauthlib/lib/basic/atca_basic_genkey.c ../src/cryptoauthlib/lib/basic/atca_basic_hmac.c ../src/cryptoauthlib/lib/basic/atca_basic_info.c ../src/cryptoauthlib/lib/basic/atca_basic_kdf.c ../src/cryptoauthlib/lib/basic/atca_basic_lock.c ../src/cryptoauthlib/lib/basic/atca_basic_mac.c ../src/cryptoauthlib/lib/basic/atca_basic_nonce.c ../src/cryptoauthlib/lib/basic/atca_basic_privwrite.c ../src/cryptoauthlib/lib/basic/atca_basic_random.c ../src/cryptoauthlib/lib/basic/atca_basic_read.c ../src/cryptoauthlib/lib/basic/atca_basic_secureboot.c ../src/cryptoauthlib/lib/basic/atca_basic_selftest.c ../src/cryptoauthlib/lib/basic/atca_basic_sha.c ../src/cryptoauthlib/lib/basic/atca_basic_sign.c ../src/cryptoauthlib/lib/basic/atca_basic_updateextra.c ../src/cryptoauthlib/lib/basic/atca_basic_verify.c ../src/cryptoauthlib/lib/basic/atca_basic_write.c ../src/cryptoauthlib/lib/basic/atca_helpers.c ../src/cryptoauthlib/lib/crypto/hashes/sha1_routines.c ../src/cryptoauthlib/lib/crypto/hashes/sha2_routines.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_ecdsa.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_rand.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_sha1.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_sha2.c ../src/cryptoauthlib/lib/hal/atca_hal.c ../src/cryptoauthlib/lib/hal/hal_i2c.c ../src/cryptoauthlib/lib/hal/hal_timer.c ../src/cryptoauthlib/lib/host/atca_host.c ../src/cryptoauthlib/lib/jwt/atca_jwt.c ../src/cryptoauthlib/lib/tls/atcatls.c ../src/cryptoauthlib/lib/tls/atcatls_cfg.c ../src/cryptoauthlib/lib/atca_cfgs.c ../src/cryptoauthlib/lib/atca_command.c ../src/cryptoauthlib/lib/atca_device.c ../src/cryptoauthlib/lib/atca_execution.c ../src/cryptoauthlib/lib/atca_iface.c ../src/mqtt/mqtt_comm_bsd/mqtt_comm_layer.c ../src/mqtt/mqtt_core/mqtt_core.c ../src/mqtt/mqtt_exchange_buffer/mqtt_exchange_buffer.c ../src/mqtt/mqtt_packetTransfer_interface.c ../src/services/iot/cloud/bsd_adapter/bsdWINC.c ../src/services/iot/cloud/crypto_client/cryptoauthlib_main.c ../src/services/iot/cloud/crypto_client/crypto_client.c ../src/services/iot/cloud/mqtt_packetPopulation/mqtt_packetPopulate.c ../src/services/iot/cloud/mqtt_packetPopulation/mqtt_iothub_packetPopulate.c ../src/services/iot/cloud/mqtt_packetPopulation/mqtt_iotprovisioning_packetPopulate.c ../src/services/iot/cloud/cloud_service.c ../src/services/iot/cloud/wifi_service.c ../src/debug_print.c ../src/main.c ../src/app.c ../src/led.c ../src/i2c_bus.c ../src/flash_storage.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_reader.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_token.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_writer.c ../src/mqtt/mqtt_session_storage/mqtt_session_storage.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/2034671162/az_precondition.o ${OBJECTDIR}/_ext/2034671162/az_span.o ${OBJECTDIR}/_ext/2034671162/az_log.o ${OBJECTDIR}/_ext/758376979/az_iot_common.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_c2d.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_methods.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_sas.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_telemetry.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_twin.o ${OBJECTDIR}/_ext/758376979/az_iot_provisioning_client.o ${OBJECTDIR}/_ext/758376979/az_iot_provisioning_client_sas.o ${OBJECTDIR}/_ext/1678205250/drv_spi.o ${OBJECTDIR}/_ext/328869906/wdrv_winc_eint.o ${OBJECTDIR}/_ext/328869906/wdrv_winc_gpio.o ${OBJECTDIR}/_ext/2088830217/wdrv_winc_spi.o ${OBJECTDIR}/_ext/373976187/nm_common.o ${OBJECTDIR}/_ext/405265080/m2m_hif.o ${OBJECTDIR}/_ext/405265080/m2m_periph.o ${OBJECTDIR}/_ext/405265080/m2m_wifi.o ${OBJECTDIR}/_ext/405265080/nmasic.o ${OBJECTDIR}/_ext/405265080/nmbus.o ${OBJECTDIR}/_ext/405265080/nmdrv.o ${OBJECTDIR}/_ext/405265080/nmspi.o ${OBJECTDIR}/_ext/405265080/m2m_ota.o ${OBJECTDIR}/_ext/405265080/m2m_ssl.o ${OBJECTDIR}/_ext/831742467/socket.o ${OBJECTDIR}/_ext/831742467/inet_ntop.o ${OBJECTDIR}/_ext/831742467/inet_addr.o ${OBJECTDIR}/_ext/1091366131/spi_flash.o ${OBJECTDIR}/_ext/1091366131/flexible_flash.o ${OBJECTDIR}/_ext/1461284888/wdrv_winc_osal.o ${OBJECTDIR}/_ext/845676186/wdrv_winc.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_assoc.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_authctx.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_bssctx.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_bssfind.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_custie.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_host_file.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_httpprovctx.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_nvm.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_powersave.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_socket.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_softap.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_ssl.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_sta.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_systime.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_wps.o ${OBJECTDIR}/_ext/485667147/plib_adc.o ${OBJECTDIR}/_ext/1427407075/plib_clock.o ${OBJECTDIR}/_ext/2124285686/plib_dmac.o ${OBJECTDIR}/_ext/485663148/plib_eic.o ${OBJECTDIR}/_ext/1429556561/plib_evsys.o ${OBJECTDIR}/_ext/2124592493/plib_nvic.o ${OBJECTDIR}/_ext/1194272987/plib_nvmctrl.o ${OBJECTDIR}/_ext/2124645644/plib_port.o ${OBJECTDIR}/_ext/485650314/plib_rtc_clock.o ${OBJECTDIR}/_ext/1357986986/plib_sercom3_i2c_master.o ${OBJECTDIR}/_ext/693558660/plib_sercom4_spi.o ${OBJECTDIR}/_ext/27410978/plib_sercom5_usart.o ${OBJECTDIR}/_ext/708402758/plib_tc3.o ${OBJECTDIR}/_ext/1812770719/xc32_monitor.o ${OBJECTDIR}/_ext/131504744/sys_command.o ${OBJECTDIR}/_ext/325207436/sys_console.o ${OBJECTDIR}/_ext/325207436/sys_console_uart.o ${OBJECTDIR}/_ext/1268222528/sys_dma.o ${OBJECTDIR}/_ext/1335837964/sys_int.o ${OBJECTDIR}/_ext/157239130/sys_time.o ${OBJECTDIR}/_ext/853479/initialization.o ${OBJECTDIR}/_ext/853479/interrupts.o ${OBJECTDIR}/_ext/853479/exceptions.o ${OBJECTDIR}/_ext/853479/startup_xc32.o ${OBJECTDIR}/_ext/853479/libc_syscalls.o ${OBJECTDIR}/_ext/853479/tasks.o ${OBJECTDIR}/_ext/364212162/credentials_storage.o ${OBJECTDIR}/_ext/935147988/atcacert_client.o ${OBJECTDIR}/_ext/935147988/atcacert_date.o ${OBJECTDIR}/_ext/935147988/atcacert_def.o ${OBJECTDIR}/_ext/935147988/atcacert_der.o ${OBJECTDIR}/_ext/935147988/atcacert_host_hw.o ${OBJECTDIR}/_ext/935147988/atcacert_host_sw.o ${OBJECTDIR}/_ext/935147988/atcacert_pem.o ${OBJECTDIR}/_ext/2028850473/atca_basic.o ${OBJECTDIR}/_ext/2028850473/atca_basic_aes.o ${OBJECTDIR}/_ext/2028850473/atca_basic_checkmac.o ${OBJECTDIR}/_ext/2028850473/atca_basic_counter.o ${OBJECTDIR}/_ext/2028850473/atca_basic_derivekey.o ${OBJECTDIR}/_ext/2028850473/atca_basic_ecdh.o ${OBJECTDIR}/_ext/2028850473/atca_basic_gendig.o ${OBJECTDIR}/_ext/2028850473/atca_basic_genkey.o ${OBJECTDIR}/_ext/2028850473/atca_basic_hmac.o ${OBJECTDIR}/_ext/2028850473/atca_basic_info.o ${OBJECTDIR}/_ext/2028850473/atca_basic_kdf.o ${OBJECTDIR}/_ext/2028850473/atca_basic_lock.o ${OBJECTDIR}/_ext/2028850473/atca_basic_mac.o ${OBJECTDIR}/_ext/2028850473/atca_basic_nonce.o ${OBJECTDIR}/_ext/2028850473/atca_basic_privwrite.o ${OBJECTDIR}/_ext/2028850473/atca_basic_random.o ${OBJECTDIR}/_ext/2028850473/atca_basic_read.o ${OBJECTDIR}/_ext/2028850473/atca_basic_secureboot.o ${OBJECTDIR}/_ext/2028850473/atca_basic_selftest.o ${OBJECTDIR}/_ext/2028850473/atca_basic_sha.o ${OBJECTDIR}/_ext/2028850473/atca_basic_sign.o ${OBJECTDIR}/_ext/2028850473/atca_basic_updateextra.o ${OBJECTDIR}/_ext/2028850473/atca_basic_verify.o ${OBJECTDIR}/_ext/2028850473/atca_basic_write.o ${OBJECTDIR}/_ext/2028850473/atca_helpers.o ${OBJECTDIR}/_ext/626928883/sha1_routines.o ${OBJECTDIR}/_ext/626928883/sha2_routines.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_ecdsa.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_rand.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_sha1.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_sha2.o ${OBJECTDIR}/_ext/672495748/atca_hal.o ${OBJECTDIR}/_ext/672495748/hal_i2c.o ${OBJECTDIR}/_ext/672495748/hal_timer.o ${OBJECTDIR}/_ext/627482079/atca_host.o ${OBJECTDIR}/_ext/672493136/atca_jwt.o ${OBJECTDIR}/_ext/672483868/atcatls.o ${OBJECTDIR}/_ext/672483868/atcatls_cfg.o ${OBJECTDIR}/_ext/1837493384/atca_cfgs.o ${OBJECTDIR}/_ext/1837493384/atca_command.o ${OBJECTDIR}/_ext/1837493384/atca_device.o ${OBJECTDIR}/_ext/1837493384/atca_execution.o ${OBJECTDIR}/_ext/1837493384/atca_iface.o ${OBJECTDIR}/_ext/1207317302/mqtt_comm_layer.o ${OBJECTDIR}/_ext/1731314967/mqtt_core.o ${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o ${OBJECTDIR}/_ext/1019103266/mqtt_packetTransfer_interface.o ${OBJECTDIR}/_ext/695851535/bsdWINC.o ${OBJECTDIR}/_ext/1688231369/cryptoauthlib_main.o ${OBJECTDIR}/_ext/1688231369/crypto_client.o ${OBJECTDIR}/_ext/347544798/mqtt_packetPopulate.o ${OBJECTDIR}/_ext/347544798/mqtt_iothub_packetPopulate.o ${OBJECTDIR}/_ext/347544798/mqtt_iotprovisioning_packetPopulate.o ${OBJECTDIR}/_ext/711616579/cloud_service.o ${OBJECTDIR}/_ext/711616579/wifi_service.o ${OBJECTDIR}/_ext/1360937237/debug_print.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/app.o ${OBJECTDIR}/_ext/1360937237/led.o ${OBJECTDIR}/_ext/2034671162/az_json_reader.o ${OBJECTDIR}/_ext/2034671162/az_json_token.o ${OBJECTDIR}/_ext/2034671162/az_json_writer.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/2034671162/az_precondition.o.d ${OBJECTDIR}/_ext/2034671162/az_span.o.d ${OBJECTDIR}/_ext/2034671162/az_log.o.d ${OBJECTDIR}/_ext/758376979/az_iot_common.o.d ${OBJECTDIR}/_ext/758376979/az_iot_hub_client.o.d ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_c2d.o.d ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_methods.o.d ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_sas.o.d ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_telemetry.o.d ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_twin.o.d ${OBJECTDIR}/_ext/758376979/az_iot_provisioning_client.o.d ${OBJECTDIR}/_ext/758376979/az_iot_provisioning_client_sas.o.d ${OBJECTDIR}/_ext/1678205250/drv_spi.o.d ${OBJECTDIR}/_ext/328869906/wdrv_winc_eint.o.d ${OBJECTDIR}/_ext/328869906/wdrv_winc_gpio.o.d ${OBJECTDIR}/_ext/2088830217/wdrv_winc_spi.o.d ${OBJECTDIR}/_ext/373976187/nm_common.o.d ${OBJECTDIR}/_ext/405265080/m2m_hif.o.d ${OBJECTDIR}/_ext/405265080/m2m_periph.o.d ${OBJECTDIR}/_ext/405265080/m2m_wifi.o.d ${OBJECTDIR}/_ext/405265080/nmasic.o.d ${OBJECTDIR}/_ext/405265080/nmbus.o.d ${OBJECTDIR}/_ext/405265080/nmdrv.o.d ${OBJECTDIR}/_ext/405265080/nmspi.o.d ${OBJECTDIR}/_ext/405265080/m2m_ota.o.d ${OBJECTDIR}/_ext/405265080/m2m_ssl.o.d ${OBJECTDIR}/_ext/831742467/socket.o.d ${OBJECTDIR}/_ext/831742467/inet_ntop.o.d ${OBJECTDIR}/_ext/831742467/inet_addr.o.d ${OBJECTDIR}/_ext/1091366131/spi_flash.o.d ${OBJECTDIR}/_ext/1091366131/flexible_flash.o.d ${OBJECTDIR}/_ext/1461284888/wdrv_winc_osal.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_assoc.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_authctx.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_bssctx.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_bssfind.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_custie.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_host_file.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_httpprovctx.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_nvm.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_powersave.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_socket.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_softap.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_ssl.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_sta.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_systime.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_wps.o.d ${OBJECTDIR}/_ext/485667147/plib_adc.o.d ${OBJECTDIR}/_ext/1427407075/plib_clock.o.d ${OBJECTDIR}/_ext/2124285686/plib_dmac.o.d ${OBJECTDIR}/_ext/485663148/plib_eic.o.d ${OBJECTDIR}/_ext/1429556561/plib_evsys.o.d ${OBJECTDIR}/_ext/2124592493/plib_nvic.o.d ${OBJECTDIR}/_ext/1194272987/plib_nvmctrl.o.d ${OBJECTDIR}/_ext/2124645644/plib_port.o.d ${OBJECTDIR}/_ext/485650314/plib_rtc_clock.o.d ${OBJECTDIR}/_ext/1357986986/plib_sercom3_i2c_master.o.d ${OBJECTDIR}/_ext/693558660/plib_sercom4_spi.o.d ${OBJECTDIR}/_ext/27410978/plib_sercom5_usart.o.d ${OBJECTDIR}/_ext/708402758/plib_tc3.o.d ${OBJECTDIR}/_ext/1812770719/xc32_monitor.o.d ${OBJECTDIR}/_ext/131504744/sys_command.o.d ${OBJECTDIR}/_ext/325207436/sys_console.o.d ${OBJECTDIR}/_ext/325207436/sys_console_uart.o.d ${OBJECTDIR}/_ext/1268222528/sys_dma.o.d ${OBJECTDIR}/_ext/1335837964/sys_int.o.d ${OBJECTDIR}/_ext/157239130/sys_time.o.d ${OBJECTDIR}/_ext/853479/initialization.o.d ${OBJECTDIR}/_ext/853479/interrupts.o.d ${OBJECTDIR}/_ext/853479/exceptions.o.d ${OBJECTDIR}/_ext/853479/startup_xc32.o.d ${OBJECTDIR}/_ext/853479/libc_syscalls.o.d ${OBJECTDIR}/_ext/853479/tasks.o.d ${OBJECTDIR}/_ext/364212162/credentials_storage.o.d ${OBJECTDIR}/_ext/935147988/atcacert_client.o.d ${OBJECTDIR}/_ext/935147988/atcacert_date.o.d ${OBJECTDIR}/_ext/935147988/atcacert_def.o.d ${OBJECTDIR}/_ext/935147988/atcacert_der.o.d ${OBJECTDIR}/_ext/935147988/atcacert_host_hw.o.d ${OBJECTDIR}/_ext/935147988/atcacert_host_sw.o.d ${OBJECTDIR}/_ext/935147988/atcacert_pem.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_aes.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_checkmac.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_counter.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_derivekey.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_ecdh.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_gendig.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_genkey.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_hmac.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_info.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_kdf.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_lock.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_mac.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_nonce.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_privwrite.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_random.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_read.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_secureboot.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_selftest.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_sha.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_sign.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_updateextra.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_verify.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_write.o.d ${OBJECTDIR}/_ext/2028850473/atca_helpers.o.d ${OBJECTDIR}/_ext/626928883/sha1_routines.o.d ${OBJECTDIR}/_ext/626928883/sha2_routines.o.d ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_ecdsa.o.d ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_rand.o.d ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_sha1.o.d ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_sha2.o.d ${OBJECTDIR}/_ext/672495748/atca_hal.o.d ${OBJECTDIR}/_ext/672495748/hal_i2c.o.d ${OBJECTDIR}/_ext/672495748/hal_timer.o.d ${OBJECTDIR}/_ext/627482079/atca_host.o.d ${OBJECTDIR}/_ext/672493136/atca_jwt.o.d ${OBJECTDIR}/_ext/672483868/atcatls.o.d ${OBJECTDIR}/_ext/672483868/atcatls_cfg.o.d ${OBJECTDIR}/_ext/1837493384/atca_cfgs.o.d ${OBJECTDIR}/_ext/1837493384/atca_command.o.d ${OBJECTDIR}/_ext/1837493384/atca_device.o.d ${OBJECTDIR}/_ext/1837493384/atca_execution.o.d ${OBJECTDIR}/_ext/1837493384/atca_iface.o.d ${OBJECTDIR}/_ext/1207317302/mqtt_comm_layer.o.d ${OBJECTDIR}/_ext/1731314967/mqtt_core.o.d ${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o.d ${OBJECTDIR}/_ext/1019103266/mqtt_packetTransfer_interface.o.d ${OBJECTDIR}/_ext/695851535/bsdWINC.o.d ${OBJECTDIR}/_ext/1688231369/cryptoauthlib_main.o.d ${OBJECTDIR}/_ext/1688231369/crypto_client.o.d ${OBJECTDIR}/_ext/347544798/mqtt_packetPopulate.o.d ${OBJECTDIR}/_ext/347544798/mqtt_iothub_packetPopulate.o.d ${OBJECTDIR}/_ext/347544798/mqtt_iotprovisioning_packetPopulate.o.d ${OBJECTDIR}/_ext/711616579/cloud_service.o.d ${OBJECTDIR}/_ext/711616579/wifi_service.o.d ${OBJECTDIR}/_ext/1360937237/debug_print.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d ${OBJECTDIR}/_ext/1360937237/app.o.d ${OBJECTDIR}/_ext/1360937237/led.o.d ${OBJECTDIR}/_ext/2034671162/az_json_reader.o.d ${OBJECTDIR}/_ext/2034671162/az_json_token.o.d ${OBJECTDIR}/_ext/2034671162/az_json_writer.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/2034671162/az_precondition.o ${OBJECTDIR}/_ext/2034671162/az_span.o ${OBJECTDIR}/_ext/2034671162/az_log.o ${OBJECTDIR}/_ext/758376979/az_iot_common.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_c2d.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_methods.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_sas.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_telemetry.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_twin.o ${OBJECTDIR}/_ext/758376979/az_iot_provisioning_client.o ${OBJECTDIR}/_ext/758376979/az_iot_provisioning_client_sas.o ${OBJECTDIR}/_ext/1678205250/drv_spi.o ${OBJECTDIR}/_ext/328869906/wdrv_winc_eint.o ${OBJECTDIR}/_ext/328869906/wdrv_winc_gpio.o ${OBJECTDIR}/_ext/2088830217/wdrv_winc_spi.o ${OBJECTDIR}/_ext/373976187/nm_common.o ${OBJECTDIR}/_ext/405265080/m2m_hif.o ${OBJECTDIR}/_ext/405265080/m2m_periph.o ${OBJECTDIR}/_ext/405265080/m2m_wifi.o ${OBJECTDIR}/_ext/405265080/nmasic.o ${OBJECTDIR}/_ext/405265080/nmbus.o ${OBJECTDIR}/_ext/405265080/nmdrv.o ${OBJECTDIR}/_ext/405265080/nmspi.o ${OBJECTDIR}/_ext/405265080/m2m_ota.o ${OBJECTDIR}/_ext/405265080/m2m_ssl.o ${OBJECTDIR}/_ext/831742467/socket.o ${OBJECTDIR}/_ext/831742467/inet_ntop.o ${OBJECTDIR}/_ext/831742467/inet_addr.o ${OBJECTDIR}/_ext/1091366131/spi_flash.o ${OBJECTDIR}/_ext/1091366131/flexible_flash.o ${OBJECTDIR}/_ext/1461284888/wdrv_winc_osal.o ${OBJECTDIR}/_ext/845676186/wdrv_winc.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_assoc.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_authctx.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_bssctx.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_bssfind.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_custie.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_host_file.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_httpprovctx.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_nvm.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_powersave.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_socket.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_softap.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_ssl.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_sta.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_systime.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_wps.o ${OBJECTDIR}/_ext/485667147/plib_adc.o ${OBJECTDIR}/_ext/1427407075/plib_clock.o ${OBJECTDIR}/_ext/2124285686/plib_dmac.o ${OBJECTDIR}/_ext/485663148/plib_eic.o ${OBJECTDIR}/_ext/1429556561/plib_evsys.o ${OBJECTDIR}/_ext/2124592493/plib_nvic.o ${OBJECTDIR}/_ext/1194272987/plib_nvmctrl.o ${OBJECTDIR}/_ext/2124645644/plib_port.o ${OBJECTDIR}/_ext/485650314/plib_rtc_clock.o ${OBJECTDIR}/_ext/1357986986/plib_sercom3_i2c_master.o ${OBJECTDIR}/_ext/693558660/plib_sercom4_spi.o ${OBJECTDIR}/_ext/27410978/plib_sercom5_usart.o ${OBJECTDIR}/_ext/708402758/plib_tc3.o ${OBJECTDIR}/_ext/1812770719/xc32_monitor.o ${OBJECTDIR}/_ext/131504744/sys_command.o ${OBJECTDIR}/_ext/325207436/sys_console.o ${OBJECTDIR}/_ext/325207436/sys_console_uart.o ${OBJECTDIR}/_ext/1268222528/sys_dma.o ${OBJECTDIR}/_ext/1335837964/sys_int.o ${OBJECTDIR}/_ext/157239130/sys_time.o ${OBJECTDIR}/_ext/853479/initialization.o ${OBJECTDIR}/_ext/853479/interrupts.o ${OBJECTDIR}/_ext/853479/exceptions.o ${OBJECTDIR}/_ext/853479/startup_xc32.o ${OBJECTDIR}/_ext/853479/libc_syscalls.o ${OBJECTDIR}/_ext/853479/tasks.o ${OBJECTDIR}/_ext/364212162/credentials_storage.o ${OBJECTDIR}/_ext/935147988/atcacert_client.o ${OBJECTDIR}/_ext/935147988/atcacert_date.o ${OBJECTDIR}/_ext/935147988/atcacert_def.o ${OBJECTDIR}/_ext/935147988/atcacert_der.o ${OBJECTDIR}/_ext/935147988/atcacert_host_hw.o ${OBJECTDIR}/_ext/935147988/atcacert_host_sw.o ${OBJECTDIR}/_ext/935147988/atcacert_pem.o ${OBJECTDIR}/_ext/2028850473/atca_basic.o ${OBJECTDIR}/_ext/2028850473/atca_basic_aes.o ${OBJECTDIR}/_ext/2028850473/atca_basic_checkmac.o ${OBJECTDIR}/_ext/2028850473/atca_basic_counter.o ${OBJECTDIR}/_ext/2028850473/atca_basic_derivekey.o ${OBJECTDIR}/_ext/2028850473/atca_basic_ecdh.o ${OBJECTDIR}/_ext/2028850473/atca_basic_gendig.o ${OBJECTDIR}/_ext/2028850473/atca_basic_genkey.o ${OBJECTDIR}/_ext/2028850473/atca_basic_hmac.o ${OBJECTDIR}/_ext/2028850473/atca_basic_info.o ${OBJECTDIR}/_ext/2028850473/atca_basic_kdf.o ${OBJECTDIR}/_ext/2028850473/atca_basic_lock.o ${OBJECTDIR}/_ext/2028850473/atca_basic_mac.o ${OBJECTDIR}/_ext/2028850473/atca_basic_nonce.o ${OBJECTDIR}/_ext/2028850473/atca_basic_privwrite.o ${OBJECTDIR}/_ext/2028850473/atca_basic_random.o ${OBJECTDIR}/_ext/2028850473/atca_basic_read.o ${OBJECTDIR}/_ext/2028850473/atca_basic_secureboot.o ${OBJECTDIR}/_ext/2028850473/atca_basic_selftest.o ${OBJECTDIR}/_ext/2028850473/atca_basic_sha.o ${OBJECTDIR}/_ext/2028850473/atca_basic_sign.o ${OBJECTDIR}/_ext/2028850473/atca_basic_updateextra.o ${OBJECTDIR}/_ext/2028850473/atca_basic_verify.o ${OBJECTDIR}/_ext/2028850473/atca_basic_write.o ${OBJECTDIR}/_ext/2028850473/atca_helpers.o ${OBJECTDIR}/_ext/626928883/sha1_routines.o ${OBJECTDIR}/_ext/626928883/sha2_routines.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_ecdsa.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_rand.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_sha1.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_sha2.o ${OBJECTDIR}/_ext/672495748/atca_hal.o ${OBJECTDIR}/_ext/672495748/hal_i2c.o ${OBJECTDIR}/_ext/672495748/hal_timer.o ${OBJECTDIR}/_ext/627482079/atca_host.o ${OBJECTDIR}/_ext/672493136/atca_jwt.o ${OBJECTDIR}/_ext/672483868/atcatls.o ${OBJECTDIR}/_ext/672483868/atcatls_cfg.o ${OBJECTDIR}/_ext/1837493384/atca_cfgs.o ${OBJECTDIR}/_ext/1837493384/atca_command.o ${OBJECTDIR}/_ext/1837493384/atca_device.o ${OBJECTDIR}/_ext/1837493384/atca_execution.o ${OBJECTDIR}/_ext/1837493384/atca_iface.o ${OBJECTDIR}/_ext/1207317302/mqtt_comm_layer.o ${OBJECTDIR}/_ext/1731314967/mqtt_core.o ${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o ${OBJECTDIR}/_ext/1019103266/mqtt_packetTransfer_interface.o ${OBJECTDIR}/_ext/695851535/bsdWINC.o ${OBJECTDIR}/_ext/1688231369/cryptoauthlib_main.o ${OBJECTDIR}/_ext/1688231369/crypto_client.o ${OBJECTDIR}/_ext/347544798/mqtt_packetPopulate.o ${OBJECTDIR}/_ext/347544798/mqtt_iothub_packetPopulate.o ${OBJECTDIR}/_ext/347544798/mqtt_iotprovisioning_packetPopulate.o ${OBJECTDIR}/_ext/711616579/cloud_service.o ${OBJECTDIR}/_ext/711616579/wifi_service.o ${OBJECTDIR}/_ext/1360937237/debug_print.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/app.o ${OBJECTDIR}/_ext/1360937237/led.o ${OBJECTDIR}/_ext/1360937237/i2c_bus.o ${OBJECTDIR}/_ext/1360937237/flash_storage.o ${OBJECTDIR}/_ext/2034671162/az_json_reader.o ${OBJECTDIR}/_ext/2034671162/az_json_token.o ${OBJECTDIR}/_ext/2034671162/az_json_writer.o ${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/2034671162/az_precondition.o.d ${OBJECTDIR}/_ext/2034671162/az_span.o.d ${OBJECTDIR}/_ext/2034671162/az_log.o.d ${OBJECTDIR}/_ext/758376979/az_iot_common.o.d ${OBJECTDIR}/_ext/758376979/az_iot_hub_client.o.d ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_c2d.o.d ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_methods.o.d ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_sas.o.d ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_telemetry.o.d ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_twin.o.d ${OBJECTDIR}/_ext/758376979/az_iot_provisioning_client.o.d ${OBJECTDIR}/_ext/758376979/az_iot_provisioning_client_sas.o.d ${OBJECTDIR}/_ext/1678205250/drv_spi.o.d ${OBJECTDIR}/_ext/328869906/wdrv_winc_eint.o.d ${OBJECTDIR}/_ext/328869906/wdrv_winc_gpio.o.d ${OBJECTDIR}/_ext/2088830217/wdrv_winc_spi.o.d ${OBJECTDIR}/_ext/373976187/nm_common.o.d ${OBJECTDIR}/_ext/405265080/m2m_hif.o.d ${OBJECTDIR}/_ext/405265080/m2m_periph.o.d ${OBJECTDIR}/_ext/405265080/m2m_wifi.o.d ${OBJECTDIR}/_ext/405265080/nmasic.o.d ${OBJECTDIR}/_ext/405265080/nmbus.o.d ${OBJECTDIR}/_ext/405265080/nmdrv.o.d ${OBJECTDIR}/_ext/405265080/nmspi.o.d ${OBJECTDIR}/_ext/405265080/m2m_ota.o.d ${OBJECTDIR}/_ext/405265080/m2m_ssl.o.d ${OBJECTDIR}/_ext/831742467/socket.o.d ${OBJECTDIR}/_ext/831742467/inet_ntop.o.d ${OBJECTDIR}/_ext/831742467/inet_addr.o.d ${OBJECTDIR}/_ext/1091366131/spi_flash.o.d ${OBJECTDIR}/_ext/1091366131/flexible_flash.o.d ${OBJECTDIR}/_ext/1461284888/wdrv_winc_osal.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_assoc.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_authctx.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_bssctx.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_bssfind.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_custie.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_host_file.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_httpprovctx.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_nvm.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_powersave.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_socket.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_softap.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_ssl.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_sta.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_systime.o.d ${OBJECTDIR}/_ext/845676186/wdrv_winc_wps.o.d ${OBJECTDIR}/_ext/485667147/plib_adc.o.d ${OBJECTDIR}/_ext/1427407075/plib_clock.o.d ${OBJECTDIR}/_ext/2124285686/plib_dmac.o.d ${OBJECTDIR}/_ext/485663148/plib_eic.o.d ${OBJECTDIR}/_ext/1429556561/plib_evsys.o.d ${OBJECTDIR}/_ext/2124592493/plib_nvic.o.d ${OBJECTDIR}/_ext/1194272987/plib_nvmctrl.o.d ${OBJECTDIR}/_ext/2124645644/plib_port.o.d ${OBJECTDIR}/_ext/485650314/plib_rtc_clock.o.d ${OBJECTDIR}/_ext/1357986986/plib_sercom3_i2c_master.o.d ${OBJECTDIR}/_ext/693558660/plib_sercom4_spi.o.d ${OBJECTDIR}/_ext/27410978/plib_sercom5_usart.o.d ${OBJECTDIR}/_ext/708402758/plib_tc3.o.d ${OBJECTDIR}/_ext/1812770719/xc32_monitor.o.d ${OBJECTDIR}/_ext/131504744/sys_command.o.d ${OBJECTDIR}/_ext/325207436/sys_console.o.d ${OBJECTDIR}/_ext/325207436/sys_console_uart.o.d ${OBJECTDIR}/_ext/1268222528/sys_dma.o.d ${OBJECTDIR}/_ext/1335837964/sys_int.o.d ${OBJECTDIR}/_ext/157239130/sys_time.o.d ${OBJECTDIR}/_ext/853479/initialization.o.d ${OBJECTDIR}/_ext/853479/interrupts.o.d ${OBJECTDIR}/_ext/853479/exceptions.o.d ${OBJECTDIR}/_ext/853479/startup_xc32.o.d ${OBJECTDIR}/_ext/853479/libc_syscalls.o.d ${OBJECTDIR}/_ext/853479/tasks.o.d ${OBJECTDIR}/_ext/364212162/credentials_storage.o.d ${OBJECTDIR}/_ext/935147988/atcacert_client.o.d ${OBJECTDIR}/_ext/935147988/atcacert_date.o.d ${OBJECTDIR}/_ext/935147988/atcacert_def.o.d ${OBJECTDIR}/_ext/935147988/atcacert_der.o.d ${OBJECTDIR}/_ext/935147988/atcacert_host_hw.o.d ${OBJECTDIR}/_ext/935147988/atcacert_host_sw.o.d ${OBJECTDIR}/_ext/935147988/atcacert_pem.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_aes.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_checkmac.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_counter.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_derivekey.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_ecdh.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_gendig.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_genkey.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_hmac.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_info.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_kdf.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_lock.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_mac.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_nonce.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_privwrite.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_random.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_read.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_secureboot.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_selftest.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_sha.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_sign.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_updateextra.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_verify.o.d ${OBJECTDIR}/_ext/2028850473/atca_basic_write.o.d ${OBJECTDIR}/_ext/2028850473/atca_helpers.o.d ${OBJECTDIR}/_ext/626928883/sha1_routines.o.d ${OBJECTDIR}/_ext/626928883/sha2_routines.o.d ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_ecdsa.o.d ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_rand.o.d ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_sha1.o.d ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_sha2.o.d ${OBJECTDIR}/_ext/672495748/atca_hal.o.d ${OBJECTDIR}/_ext/672495748/hal_i2c.o.d ${OBJECTDIR}/_ext/672495748/hal_timer.o.d ${OBJECTDIR}/_ext/627482079/atca_host.o.d ${OBJECTDIR}/_ext/672493136/atca_jwt.o.d ${OBJECTDIR}/_ext/672483868/atcatls.o.d ${OBJECTDIR}/_ext/672483868/atcatls_cfg.o.d ${OBJECTDIR}/_ext/1837493384/atca_cfgs.o.d ${OBJECTDIR}/_ext/1837493384/atca_command.o.d ${OBJECTDIR}/_ext/1837493384/atca_device.o.d ${OBJECTDIR}/_ext/1837493384/atca_execution.o.d ${OBJECTDIR}/_ext/1837493384/atca_iface.o.d ${OBJECTDIR}/_ext/1207317302/mqtt_comm_layer.o.d ${OBJECTDIR}/_ext/1731314967/mqtt_core.o.d ${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o.d ${OBJECTDIR}/_ext/1019103266/mqtt_packetTransfer_interface.o.d ${OBJECTDIR}/_ext/695851535/bsdWINC.o.d ${OBJECTDIR}/_ext/1688231369/cryptoauthlib_main.o.d ${OBJECTDIR}/_ext/1688231369/crypto_client.o.d ${OBJECTDIR}/_ext/347544798/mqtt_packetPopulate.o.d ${OBJECTDIR}/_ext/347544798/mqtt_iothub_packetPopulate.o.d ${OBJECTDIR}/_ext/347544798/mqtt_iotprovisioning_packetPopulate.o.d ${OBJECTDIR}/_ext/711616579/cloud_service.o.d ${OBJECTDIR}/_ext/711616579/wifi_service.o.d ${OBJECTDIR}/_ext/1360937237/debug_print.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d ${OBJECTDIR}/_ext/1360937237/app.o.d ${OBJECTDIR}/_ext/1360937237/led.o.d ${OBJECTDIR}/_ext/1360937237/i2c_bus.o.d ${OBJECTDIR}/_ext/1360937237/flash_storage.o.d ${OBJECTDIR}/_ext/2034671162/az_json_reader.o.d ${OBJECTDIR}/_ext/2034671162/az_json_token.o.d ${OBJECTDIR}/_ext/2034671162/az_json_writer.o.d ${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/2034671162/az_precondition.o ${OBJECTDIR}/_ext/2034671162/az_span.o ${OBJECTDIR}/_ext/2034671162/az_log.o ${OBJECTDIR}/_ext/758376979/az_iot_common.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_c2d.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_methods.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_sas.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_telemetry.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_twin.o ${OBJECTDIR}/_ext/758376979/az_iot_provisioning_client.o ${OBJECTDIR}/_ext/758376979/az_iot_provisioning_client_sas.o ${OBJECTDIR}/_ext/1678205250/drv_spi.o ${OBJECTDIR}/_ext/328869906/wdrv_winc_eint.o ${OBJECTDIR}/_ext/328869906/wdrv_winc_gpio.o ${OBJECTDIR}/_ext/2088830217/wdrv_winc_spi.o ${OBJECTDIR}/_ext/373976187/nm_common.o ${OBJECTDIR}/_ext/405265080/m2m_hif.o ${OBJECTDIR}/_ext/405265080/m2m_periph.o ${OBJECTDIR}/_ext/405265080/m2m_wifi.o ${OBJECTDIR}/_ext/405265080/nmasic.o ${OBJECTDIR}/_ext/405265080/nmbus.o ${OBJECTDIR}/_ext/405265080/nmdrv.o ${OBJECTDIR}/_ext/405265080/nmspi.o ${OBJECTDIR}/_ext/405265080/m2m_ota.o ${OBJECTDIR}/_ext/405265080/m2m_ssl.o ${OBJECTDIR}/_ext/831742467/socket.o ${OBJECTDIR}/_ext/831742467/inet_ntop.o ${OBJECTDIR}/_ext/831742467/inet_addr.o ${OBJECTDIR}/_ext/1091366131/spi_flash.o ${OBJECTDIR}/_ext/1091366131/flexible_flash.o ${OBJECTDIR}/_ext/1461284888/wdrv_winc_osal.o ${OBJECTDIR}/_ext/845676186/wdrv_winc.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_assoc.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_authctx.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_bssctx.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_bssfind.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_custie.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_host_file.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_httpprovctx.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_nvm.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_powersave.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_socket.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_softap.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_ssl.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_sta.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_systime.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_wps.o ${OBJECTDIR}/_ext/485667147/plib_adc.o ${OBJECTDIR}/_ext/1427407075/plib_clock.o ${OBJECTDIR}/_ext/2124285686/plib_dmac.o ${OBJECTDIR}/_ext/485663148/plib_eic.o ${OBJECTDIR}/_ext/1429556561/plib_evsys.o ${OBJECTDIR}/_ext/2124592493/plib_nvic.o ${OBJECTDIR}/_ext/1194272987/plib_nvmctrl.o ${OBJECTDIR}/_ext/2124645644/plib_port.o ${OBJECTDIR}/_ext/485650314/plib_rtc_clock.o ${OBJECTDIR}/_ext/1357986986/plib_sercom3_i2c_master.o ${OBJECTDIR}/_ext/693558660/plib_sercom4_spi.o ${OBJECTDIR}/_ext/27410978/plib_sercom5_usart.o ${OBJECTDIR}/_ext/708402758/plib_tc3.o ${OBJECTDIR}/_ext/1812770719/xc32_monitor.o ${OBJECTDIR}/_ext/131504744/sys_command.o ${OBJECTDIR}/_ext/325207436/sys_console.o ${OBJECTDIR}/_ext/325207436/sys_console_uart.o ${OBJECTDIR}/_ext/1268222528/sys_dma.o ${OBJECTDIR}/_ext/1335837964/sys_int.o ${OBJECTDIR}/_ext/157239130/sys_time.o ${OBJECTDIR}/_ext/853479/initialization.o ${OBJECTDIR}/_ext/853479/interrupts.o ${OBJECTDIR}/_ext/853479/exceptions.o ${OBJECTDIR}/_ext/853479/startup_xc32.o ${OBJECTDIR}/_ext/853479/libc_syscalls.o ${OBJECTDIR}/_ext/853479/tasks.o ${OBJECTDIR}/_ext/364212162/credentials_storage.o ${OBJECTDIR}/_ext/935147988/atcacert_client.o ${OBJECTDIR}/_ext/935147988/atcacert_date.o ${OBJECTDIR}/_ext/935147988/atcacert_def.o ${OBJECTDIR}/_ext/935147988/atcacert_der.o ${OBJECTDIR}/_ext/935147988/atcacert_host_hw.o ${OBJECTDIR}/_ext/935147988/atcacert_host_sw.o ${OBJECTDIR}/_ext/935147988/atcacert_pem.o ${OBJECTDIR}/_ext/2028850473/atca_basic.o ${OBJECTDIR}/_ext/2028850473/atca_basic_aes.o ${OBJECTDIR}/_ext/2028850473/atca_basic_checkmac.o ${OBJECTDIR}/_ext/2028850473/atca_basic_counter.o ${OBJECTDIR}/_ext/2028850473/atca_basic_derivekey.o ${OBJECTDIR}/_ext/2028850473/atca_basic_ecdh.o ${OBJECTDIR}/_ext/2028850473/atca_basic_gendig.o ${OBJECTDIR}/_ext/2028850473/atca_basic_genkey.o ${OBJECTDIR}/_ext/2028850473/atca_basic_hmac.o ${OBJECTDIR}/_ext/2028850473/atca_basic_info.o ${OBJECTDIR}/_ext/2028850473/atca_basic_kdf.o ${OBJECTDIR}/_ext/2028850473/atca_basic_lock.o ${OBJECTDIR}/_ext/2028850473/atca_basic_mac.o ${OBJECTDIR}/_ext/2028850473/atca_basic_nonce.o ${OBJECTDIR}/_ext/2028850473/atca_basic_privwrite.o ${OBJECTDIR}/_ext/2028850473/atca_basic_random.o ${OBJECTDIR}/_ext/2028850473/atca_basic_read.o ${OBJECTDIR}/_ext/2028850473/atca_basic_secureboot.o ${OBJECTDIR}/_ext/2028850473/atca_basic_selftest.o ${OBJECTDIR}/_ext/2028850473/atca_basic_sha.o ${OBJECTDIR}/_ext/2028850473/atca_basic_sign.o ${OBJECTDIR}/_ext/2028850473/atca_basic_updateextra.o ${OBJECTDIR}/_ext/2028850473/atca_basic_verify.o ${OBJECTDIR}/_ext/2028850473/atca_basic_write.o ${OBJECTDIR}/_ext/2028850473/atca_helpers.o ${OBJECTDIR}/_ext/626928883/sha1_routines.o ${OBJECTDIR}/_ext/626928883/sha2_routines.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_ecdsa.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_rand.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_sha1.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_sha2.o ${OBJECTDIR}/_ext/672495748/atca_hal.o ${OBJECTDIR}/_ext/672495748/hal_i2c.o ${OBJECTDIR}/_ext/672495748/hal_timer.o ${OBJECTDIR}/_ext/627482079/atca_host.o ${OBJECTDIR}/_ext/672493136/atca_jwt.o ${OBJECTDIR}/_ext/672483868/atcatls.o ${OBJECTDIR}/_ext/672483868/atcatls_cfg.o ${OBJECTDIR}/_ext/1837493384/atca_cfgs.o ${OBJECTDIR}/_ext/1837493384/atca_command.o ${OBJECTDIR}/_ext/1837493384/atca_device.o ${OBJECTDIR}/_ext/1837493384/atca_execution.o ${OBJECTDIR}/_ext/1837493384/atca_iface.o ${OBJECTDIR}/_ext/1207317302/mqtt_comm_layer.o ${OBJECTDIR}/_ext/1731314967/mqtt_core.o ${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o ${OBJECTDIR}/_ext/1019103266/mqtt_packetTransfer_interface.o ${OBJECTDIR}/_ext/695851535/bsdWINC.o ${OBJECTDIR}/_ext/1688231369/cryptoauthlib_main.o ${OBJECTDIR}/_ext/1688231369/crypto_client.o ${OBJECTDIR}/_ext/347544798/mqtt_packetPopulate.o ${OBJECTDIR}/_ext/347544798/mqtt_iothub_packetPopulate.o ${OBJECTDIR}/_ext/347544798/mqtt_iotprovisioning_packetPopulate.o ${OBJECTDIR}/_ext/711616579/cloud_service.o ${OBJECTDIR}/_ext/711616579/wifi_service.o ${OBJECTDIR}/_ext/1360937237/debug_print.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/app.o ${OBJECTDIR}/_ext/1360937237/led.o ${OBJECTDIR}/_ext/2034671162/az_json_reader.o ${OBJECTDIR}/_ext/2034671162/az_json_token.o ${OBJECTDIR}/_ext/2034671162/az_json_writer.o
+OBJECTFILES=${OBJECTDIR}/_ext/2034671162/az_precondition.o ${OBJECTDIR}/_ext/2034671162/az_span.o ${OBJECTDIR}/_ext/2034671162/az_log.o ${OBJECTDIR}/_ext/758376979/az_iot_common.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_c2d.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_methods.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_sas.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_telemetry.o ${OBJECTDIR}/_ext/758376979/az_iot_hub_client_twin.o ${OBJECTDIR}/_ext/758376979/az_iot_provisioning_client.o ${OBJECTDIR}/_ext/758376979/az_iot_provisioning_client_sas.o ${OBJECTDIR}/_ext/1678205250/drv_spi.o ${OBJECTDIR}/_ext/328869906/wdrv_winc_eint.o ${OBJECTDIR}/_ext/328869906/wdrv_winc_gpio.o ${OBJECTDIR}/_ext/2088830217/wdrv_winc_spi.o ${OBJECTDIR}/_ext/373976187/nm_common.o ${OBJECTDIR}/_ext/405265080/m2m_hif.o ${OBJECTDIR}/_ext/405265080/m2m_periph.o ${OBJECTDIR}/_ext/405265080/m2m_wifi.o ${OBJECTDIR}/_ext/405265080/nmasic.o ${OBJECTDIR}/_ext/405265080/nmbus.o ${OBJECTDIR}/_ext/405265080/nmdrv.o ${OBJECTDIR}/_ext/405265080/nmspi.o ${OBJECTDIR}/_ext/405265080/m2m_ota.o ${OBJECTDIR}/_ext/405265080/m2m_ssl.o ${OBJECTDIR}/_ext/831742467/socket.o ${OBJECTDIR}/_ext/831742467/inet_ntop.o ${OBJECTDIR}/_ext/831742467/inet_addr.o ${OBJECTDIR}/_ext/1091366131/spi_flash.o ${OBJECTDIR}/_ext/1091366131/flexible_flash.o ${OBJECTDIR}/_ext/1461284888/wdrv_winc_osal.o ${OBJECTDIR}/_ext/845676186/wdrv_winc.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_assoc.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_authctx.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_bssctx.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_bssfind.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_custie.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_host_file.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_httpprovctx.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_nvm.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_powersave.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_socket.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_softap.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_ssl.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_sta.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_systime.o ${OBJECTDIR}/_ext/845676186/wdrv_winc_wps.o ${OBJECTDIR}/_ext/485667147/plib_adc.o ${OBJECTDIR}/_ext/1427407075/plib_clock.o ${OBJECTDIR}/_ext/2124285686/plib_dmac.o ${OBJECTDIR}/_ext/485663148/plib_eic.o ${OBJECTDIR}/_ext/1429556561/plib_evsys.o ${OBJECTDIR}/_ext/2124592493/plib_nvic.o ${OBJECTDIR}/_ext/1194272987/plib_nvmctrl.o ${OBJECTDIR}/_ext/2124645644/plib_port.o ${OBJECTDIR}/_ext/485650314/plib_rtc_clock.o ${OBJECTDIR}/_ext/1357986986/plib_sercom3_i2c_master.o ${OBJECTDIR}/_ext/693558660/plib_sercom4_spi.o ${OBJECTDIR}/_ext/27410978/plib_sercom5_usart.o ${OBJECTDIR}/_ext/708402758/plib_tc3.o ${OBJECTDIR}/_ext/1812770719/xc32_monitor.o ${OBJECTDIR}/_ext/131504744/sys_command.o ${OBJECTDIR}/_ext/325207436/sys_console.o ${OBJECTDIR}/_ext/325207436/sys_console_uart.o ${OBJECTDIR}/_ext/1268222528/sys_dma.o ${OBJECTDIR}/_ext/1335837964/sys_int.o ${OBJECTDIR}/_ext/157239130/sys_time.o ${OBJECTDIR}/_ext/853479/initialization.o ${OBJECTDIR}/_ext/853479/interrupts.o ${OBJECTDIR}/_ext/853479/exceptions.o ${OBJECTDIR}/_ext/853479/startup_xc32.o ${OBJECTDIR}/_ext/853479/libc_syscalls.o ${OBJECTDIR}/_ext/853479/tasks.o ${OBJECTDIR}/_ext/364212162/credentials_storage.o ${OBJECTDIR}/_ext/935147988/atcacert_client.o ${OBJECTDIR}/_ext/935147988/atcacert_date.o ${OBJECTDIR}/_ext/935147988/atcacert_def.o ${OBJECTDIR}/_ext/935147988/atcacert_der.o ${OBJECTDIR}/_ext/935147988/atcacert_host_hw.o ${OBJECTDIR}/_ext/935147988/atcacert_host_sw.o ${OBJECTDIR}/_ext/935147988/atcacert_pem.o ${OBJECTDIR}/_ext/2028850473/atca_basic.o ${OBJECTDIR}/_ext/2028850473/atca_basic_aes.o ${OBJECTDIR}/_ext/2028850473/atca_basic_checkmac.o ${OBJECTDIR}/_ext/2028850473/atca_basic_counter.o ${OBJECTDIR}/_ext/2028850473/atca_basic_derivekey.o ${OBJECTDIR}/_ext/2028850473/atca_basic_ecdh.o ${OBJECTDIR}/_ext/2028850473/atca_basic_gendig.o ${OBJECTDIR}/_ext/2028850473/atca_basic_genkey.o ${OBJECTDIR}/_ext/2028850473/atca_basic_hmac.o ${OBJECTDIR}/_ext/2028850473/atca_basic_info.o ${OBJECTDIR}/_ext/2028850473/atca_basic_kdf.o ${OBJECTDIR}/_ext/2028850473/atca_basic_lock.o ${OBJECTDIR}/_ext/2028850473/atca_basic_mac.o ${OBJECTDIR}/_ext/2028850473/atca_basic_nonce.o ${OBJECTDIR}/_ext/2028850473/atca_basic_privwrite.o ${OBJECTDIR}/_ext/2028850473/atca_basic_random.o ${OBJECTDIR}/_ext/2028850473/atca_basic_read.o ${OBJECTDIR}/_ext/2028850473/atca_basic_secureboot.o ${OBJECTDIR}/_ext/2028850473/atca_basic_selftest.o ${OBJECTDIR}/_ext/2028850473/atca_basic_sha.o ${OBJECTDIR}/_ext/2028850473/atca_basic_sign.o ${OBJECTDIR}/_ext/2028850473/atca_basic_updateextra.o ${OBJECTDIR}/_ext/2028850473/atca_basic_verify.o ${OBJECTDIR}/_ext/2028850473/atca_basic_write.o ${OBJECTDIR}/_ext/2028850473/atca_helpers.o ${OBJECTDIR}/_ext/626928883/sha1_routines.o ${OBJECTDIR}/_ext/626928883/sha2_routines.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_ecdsa.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_rand.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_sha1.o ${OBJECTDIR}/_ext/1574659896/atca_crypto_sw_sha2.o ${OBJECTDIR}/_ext/672495748/atca_hal.o ${OBJECTDIR}/_ext/672495748/hal_i2c.o ${OBJECTDIR}/_ext/672495748/hal_timer.o ${OBJECTDIR}/_ext/627482079/atca_host.o ${OBJECTDIR}/_ext/672493136/atca_jwt.o ${OBJECTDIR}/_ext/672483868/atcatls.o ${OBJECTDIR}/_ext/672483868/atcatls_cfg.o ${OBJECTDIR}/_ext/1837493384/atca_cfgs.o ${OBJECTDIR}/_ext/1837493384/atca_command.o ${OBJECTDIR}/_ext/1837493384/atca_device.o ${OBJECTDIR}/_ext/1837493384/atca_execution.o ${OBJECTDIR}/_ext/1837493384/atca_iface.o ${OBJECTDIR}/_ext/1207317302/mqtt_comm_layer.o ${OBJECTDIR}/_ext/1731314967/mqtt_core.o ${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o ${OBJECTDIR}/_ext/1019103266/mqtt_packetTransfer_interface.o ${OBJECTDIR}/_ext/695851535/bsdWINC.o ${OBJECTDIR}/_ext/1688231369/cryptoauthlib_main.o ${OBJECTDIR}/_ext/1688231369/crypto_client.o ${OBJECTDIR}/_ext/347544798/mqtt_packetPopulate.o ${OBJECTDIR}/_ext/347544798/mqtt_iothub_packetPopulate.o ${OBJECTDIR}/_ext/347544798/mqtt_iotprovisioning_packetPopulate.o ${OBJECTDIR}/_ext/711616579/cloud_service.o ${OBJECTDIR}/_ext/711616579/wifi_service.o ${OBJECTDIR}/_ext/1360937237/debug_print.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/app.o ${OBJECTDIR}/_ext/1360937237/led.o ${OBJECTDIR}/_ext/1360937237/i2c_bus.o ${OBJECTDIR}/_ext/1360937237/flash_storage.o ${OBJECTDIR}/_ext/2034671162/az_json_reader.o ${OBJECTDIR}/_ext/2034671162/az_json_token.o ${OBJECTDIR}/_ext/2034671162/az_json_writer.o ${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o
 
 # Source Files
-SOURCEFILES=../src/azure-sdk-for-c/sdk/src/azure/core/az_precondition.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_span.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_log.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_common.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_c2d.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_methods.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_sas.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_telemetry.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_twin.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_provisioning_client.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_provisioning_client_sas.c ../src/config/SAMD21_WG_IOT/driver/spi/src/drv_spi.c ../src/config/SAMD21_WG_IOT/driver/winc/dev/gpio/wdrv_winc_eint.c ../src/config/SAMD21_WG_IOT/driver/winc/dev/gpio/wdrv_winc_gpio.c ../src/config/SAMD21_WG_IOT/driver/winc/dev/spi/wdrv_winc_spi.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/common/nm_common.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_hif.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_periph.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_wifi.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmasic.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmbus.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmdrv.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmspi.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_ota.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_ssl.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/socket/socket.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/socket/inet_ntop.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/socket/inet_addr.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/spi_flash/spi_flash.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/spi_flash/flexible_flash.c ../src/config/SAMD21_WG_IOT/driver/winc/osal/wdrv_winc_osal.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_assoc.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_authctx.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_bssctx.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_bssfind.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_custie.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_host_file.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_httpprovctx.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_nvm.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_powersave.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_socket.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_softap.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_ssl.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_sta.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_systime.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_wps.c ../src/config/SAMD21_WG_IOT/peripheral/adc/plib_adc.c ../src/config/SAMD21_WG_IOT/peripheral/clock/plib_clock.c ../src/config/SAMD21_WG_IOT/peripheral/dmac/plib_dmac.c ../src/config/SAMD21_WG_IOT/peripheral/eic/plib_eic.c ../src/config/SAMD21_WG_IOT/peripheral/evsys/plib_evsys.c ../src/config/SAMD21_WG_IOT/peripheral/nvic/plib_nvic.c ../src/config/SAMD21_WG_IOT/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/SAMD21_WG_IOT/peripheral/port/plib_port.c ../src/config/SAMD21_WG_IOT/peripheral/rtc/plib_rtc_clock.c ../src/config/SAMD21_WG_IOT/peripheral/sercom/i2c_master/plib_sercom3_i2c_master.c ../src/config/SAMD21_WG_IOT/peripheral/sercom/spim/plib_sercom4_spi.c ../src/config/SAMD21_WG_IOT/peripheral/sercom/usart/plib_sercom5_usart.c ../src/config/SAMD21_WG_IOT/peripheral/tc/plib_tc3.c ../src/config/SAMD21_WG_IOT/stdio/xc32_monitor.c ../src/config/SAMD21_WG_IOT/system/command/src/sys_command.c ../src/config/SAMD21_WG_IOT/system/console/src/sys_console.c ../src/config/SAMD21_WG_IOT/system/console/src/sys_console_uart.c ../src/config/SAMD21_WG_IOT/system/dma/sys_dma.c ../src/config/SAMD21_WG_IOT/system/int/src/sys_int.c ../src/config/SAMD21_WG_IOT/system/time/src/sys_time.c ../src/config/SAMD21_WG_IOT/initialization.c ../src/config/SAMD21_WG_IOT/interrupts.c ../src/config/SAMD21_WG_IOT/exceptions.c ../src/config/SAMD21_WG_IOT/startup_xc32.c ../src/config/SAMD21_WG_IOT/libc_syscalls.c ../src/config/SAMD21_WG_IOT/tasks.c ../src/credentials_storage/credentials_storage.c ../src/cryptoauthlib/lib/atcacert/atcacert_client.c ../src/cryptoauthlib/lib/atcacert/atcacert_date.c ../src/cryptoauthlib/lib/atcacert/atcacert_def.c ../src/cryptoauthlib/lib/atcacert/atcacert_der.c ../src/cryptoauthlib/lib/atcacert/atcacert_host_hw.c ../src/cryptoauthlib/lib/atcacert/atcacert_host_sw.c ../src/cryptoauthlib/lib/atcacert/atcacert_pem.c ../src/cryptoauthlib/lib/basic/atca_basic.c ../src/cryptoauthlib/lib/basic/atca_basic_aes.c ../src/cryptoauthlib/lib/basic/atca_basic_checkmac.c ../src/cryptoauthlib/lib/basic/atca_basic_counter.c ../src/cryptoauthlib/lib/basic/atca_basic_derivekey.c ../src/cryptoauthlib/lib/basic/atca_basic_ecdh.c ../src/cryptoauthlib/lib/basic/atca_basic_gendig.c ../src/cryptoauthlib/lib/basic/atca_basic_genkey.c ../src/cryptoauthlib/lib/basic/atca_basic_hmac.c ../src/cryptoauthlib/lib/basic/atca_basic_info.c ../src/cryptoauthlib/lib/basic/atca_basic_kdf.c ../src/cryptoauthlib/lib/basic/atca_basic_lock.c ../src/cryptoauthlib/lib/basic/atca_basic_mac.c ../src/cryptoauthlib/lib/basic/atca_basic_nonce.c ../src/cryptoauthlib/lib/basic/atca_basic_privwrite.c ../src/cryptoauthlib/lib/basic/atca_basic_random.c ../src/cryptoauthlib/lib/basic/atca_basic_read.c ../src/cryptoauthlib/lib/basic/atca_basic_secureboot.c ../src/cryptoauthlib/lib/basic/atca_basic_selftest.c ../src/cryptoauthlib/lib/basic/atca_basic_sha.c ../src/cryptoauthlib/lib/basic/atca_basic_sign.c ../src/cryptoauthlib/lib/basic/atca_basic_updateextra.c ../src/cryptoauthlib/lib/basic/atca_basic_verify.c ../src/cryptoauthlib/lib/basic/atca_basic_write.c ../src/cryptoauthlib/lib/basic/atca_helpers.c ../src/cryptoauthlib/lib/crypto/hashes/sha1_routines.c ../src/cryptoauthlib/lib/crypto/hashes/sha2_routines.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_ecdsa.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_rand.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_sha1.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_sha2.c ../src/cryptoauthlib/lib/hal/atca_hal.c ../src/cryptoauthlib/lib/hal/hal_i2c.c ../src/cryptoauthlib/lib/hal/hal_timer.c ../src/cryptoauthlib/lib/host/atca_host.c ../src/cryptoauthlib/lib/jwt/atca_jwt.c ../src/cryptoauthlib/lib/tls/atcatls.c ../src/cryptoauthlib/lib/tls/atcatls_cfg.c ../src/cryptoauthlib/lib/atca_cfgs.c ../src/cryptoauthlib/lib/atca_command.c ../src/cryptoauthlib/lib/atca_device.c ../src/cryptoauthlib/lib/atca_execution.c ../src/cryptoauthlib/lib/atca_iface.c ../src/mqtt/mqtt_comm_bsd/mqtt_comm_layer.c ../src/mqtt/mqtt_core/mqtt_core.c ../src/mqtt/mqtt_exchange_buffer/mqtt_exchange_buffer.c ../src/mqtt/mqtt_packetTransfer_interface.c ../src/services/iot/cloud/bsd_adapter/bsdWINC.c ../src/services/iot/cloud/crypto_client/cryptoauthlib_main.c ../src/services/iot/cloud/crypto_client/crypto_client.c ../src/services/iot/cloud/mqtt_packetPopulation/mqtt_packetPopulate.c ../src/services/iot/cloud/mqtt_packetPopulation/mqtt_iothub_packetPopulate.c ../src/services/iot/cloud/mqtt_packetPopulation/mqtt_iotprovisioning_packetPopulate.c ../src/services/iot/cloud/cloud_service.c ../src/services/iot/cloud/wifi_service.c ../src/debug_print.c ../src/main.c ../src/app.c ../src/led.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_reader.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_token.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_writer.c
+SOURCEFILES=../src/azure-sdk-for-c/sdk/src/azure/core/az_precondition.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_span.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_log.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_common.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_c2d.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_methods.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_sas.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_telemetry.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_hub_client_twin.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_provisioning_client.c ../src/azure-sdk-for-c/sdk/src/azure/iot/az_iot_provisioning_client_sas.c ../src/config/SAMD21_WG_IOT/driver/spi/src/drv_spi.c ../src/config/SAMD21_WG_IOT/driver/winc/dev/gpio/wdrv_winc_eint.c ../src/config/SAMD21_WG_IOT/driver/winc/dev/gpio/wdrv_winc_gpio.c ../src/config/SAMD21_WG_IOT/driver/winc/dev/spi/wdrv_winc_spi.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/common/nm_common.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_hif.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_periph.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_wifi.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmasic.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmbus.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmdrv.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/nmspi.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_ota.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/driver/m2m_ssl.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/socket/socket.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/socket/inet_ntop.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/socket/inet_addr.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/spi_flash/spi_flash.c ../src/config/SAMD21_WG_IOT/driver/winc/drv/spi_flash/flexible_flash.c ../src/config/SAMD21_WG_IOT/driver/winc/osal/wdrv_winc_osal.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_assoc.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_authctx.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_bssctx.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_bssfind.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_custie.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_host_file.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_httpprovctx.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_nvm.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_powersave.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_socket.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_softap.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_ssl.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_sta.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_systime.c ../src/config/SAMD21_WG_IOT/driver/winc/wdrv_winc_wps.c ../src/config/SAMD21_WG_IOT/peripheral/adc/plib_adc.c ../src/config/SAMD21_WG_IOT/peripheral/clock/plib_clock.c ../src/config/SAMD21_WG_IOT/peripheral/dmac/plib_dmac.c ../src/config/SAMD21_WG_IOT/peripheral/eic/plib_eic.c ../src/config/SAMD21_WG_IOT/peripheral/evsys/plib_evsys.c ../src/config/SAMD21_WG_IOT/peripheral/nvic/plib_nvic.c ../src/config/SAMD21_WG_IOT/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/SAMD21_WG_IOT/peripheral/port/plib_port.c ../src/config/SAMD21_WG_IOT/peripheral/rtc/plib_rtc_clock.c ../src/config/SAMD21_WG_IOT/peripheral/sercom/i2c_master/plib_sercom3_i2c_master.c ../src/config/SAMD21_WG_IOT/peripheral/sercom/spim/plib_sercom4_spi.c ../src/config/SAMD21_WG_IOT/peripheral/sercom/usart/plib_sercom5_usart.c ../src/config/SAMD21_WG_IOT/peripheral/tc/plib_tc3.c ../src/config/SAMD21_WG_IOT/stdio/xc32_monitor.c ../src/config/SAMD21_WG_IOT/system/command/src/sys_command.c ../src/config/SAMD21_WG_IOT/system/console/src/sys_console.c ../src/config/SAMD21_WG_IOT/system/console/src/sys_console_uart.c ../src/config/SAMD21_WG_IOT/system/dma/sys_dma.c ../src/config/SAMD21_WG_IOT/system/int/src/sys_int.c ../src/config/SAMD21_WG_IOT/system/time/src/sys_time.c ../src/config/SAMD21_WG_IOT/initialization.c ../src/config/SAMD21_WG_IOT/interrupts.c ../src/config/SAMD21_WG_IOT/exceptions.c ../src/config/SAMD21_WG_IOT/startup_xc32.c ../src/config/SAMD21_WG_IOT/libc_syscalls.c ../src/config/SAMD21_WG_IOT/tasks.c ../src/credentials_storage/credentials_storage.c ../src/cryptoauthlib/lib/atcacert/atcacert_client.c ../src/cryptoauthlib/lib/atcacert/atcacert_date.c ../src/cryptoauthlib/lib/atcacert/atcacert_def.c ../src/cryptoauthlib/lib/atcacert/atcacert_der.c ../src/cryptoauthlib/lib/atcacert/atcacert_host_hw.c ../src/cryptoauthlib/lib/atcacert/atcacert_host_sw.c ../src/cryptoauthlib/lib/atcacert/atcacert_pem.c ../src/cryptoauthlib/lib/basic/atca_basic.c ../src/cryptoauthlib/lib/basic/atca_basic_aes.c ../src/cryptoauthlib/lib/basic/atca_basic_checkmac.c ../src/cryptoauthlib/lib/basic/atca_basic_counter.c ../src/cryptoauthlib/lib/basic/atca_basic_derivekey.c ../src/cryptoauthlib/lib/basic/atca_basic_ecdh.c ../src/cryptoauthlib/lib/basic/atca_basic_gendig.c ../src/cryptoauthlib/lib/basic/atca_basic_genkey.c ../src/cryptoauthlib/lib/basic/atca_basic_hmac.c ../src/cryptoauthlib/lib/basic/atca_basic_info.c ../src/cryptoauthlib/lib/basic/atca_basic_kdf.c ../src/cryptoauthlib/lib/basic/atca_basic_lock.c ../src/cryptoauthlib/lib/basic/atca_basic_mac.c ../src/cryptoauthlib/lib/basic/atca_basic_nonce.c ../src/cryptoauthlib/lib/basic/atca_basic_privwrite.c ../src/cryptoauthlib/lib/basic/atca_basic_random.c ../src/cryptoauthlib/lib/basic/atca_basic_read.c ../src/cryptoauthlib/lib/basic/atca_basic_secureboot.c ../src/cryptoauthlib/lib/basic/atca_basic_selftest.c ../src/cryptoauthlib/lib/basic/atca_basic_sha.c ../src/cryptoauthlib/lib/basic/atca_basic_sign.c ../src/cryptoauthlib/lib/basic/atca_basic_updateextra.c ../src/cryptoauthlib/lib/basic/atca_basic_verify.c ../src/cryptoauthlib/lib/basic/atca_basic_write.c ../src/cryptoauthlib/lib/basic/atca_helpers.c ../src/cryptoauthlib/lib/crypto/hashes/sha1_routines.c ../src/cryptoauthlib/lib/crypto/hashes/sha2_routines.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_ecdsa.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_rand.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_sha1.c ../src/cryptoauthlib/lib/crypto/atca_crypto_sw_sha2.c ../src/cryptoauthlib/lib/hal/atca_hal.c ../src/cryptoauthlib/lib/hal/hal_i2c.c ../src/cryptoauthlib/lib/hal/hal_timer.c ../src/cryptoauthlib/lib/host/atca_host.c ../src/cryptoauthlib/lib/jwt/atca_jwt.c ../src/cryptoauthlib/lib/tls/atcatls.c ../src/cryptoauthlib/lib/tls/atcatls_cfg.c ../src/cryptoauthlib/lib/atca_cfgs.c ../src/cryptoauthlib/lib/atca_command.c ../src/cryptoauthlib/lib/atca_device.c ../src/cryptoauthlib/lib/atca_execution.c ../src/cryptoauthlib/lib/atca_iface.c ../src/mqtt/mqtt_comm_bsd/mqtt_comm_layer.c ../src/mqtt/mqtt_core/mqtt_core.c ../src/mqtt/mqtt_exchange_buffer/mqtt_exchange_buffer.c ../src/mqtt/mqtt_packetTransfer_interface.c ../src/services/iot/cloud/bsd_adapter/bsdWINC.c ../src/services/iot/cloud/crypto_client/cryptoauthlib_main.c ../src/services/iot/cloud/crypto_client/crypto_client.c ../src/services/iot/cloud/mqtt_packetPopulation/mqtt_packetPopulate.c ../src/services/iot/cloud/mqtt_packetPopulation/mqtt_iothub_packetPopulate.c ../src/services/iot/cloud/mqtt_packetPopulation/mqtt_iotprovisioning_packetPopulate.c ../src/services/iot/cloud/cloud_service.c ../src/services/iot/cloud/wifi_service.c ../src/debug_print.c ../src/main.c ../src/app.c ../src/led.c ../src/i2c_bus.c ../src/flash_storage.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_reader.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_token.c ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_writer.c ../src/mqtt/mqtt_session_storage/mqtt_session_storage.c
 
 # Pack Options 
 PACK_COMMON_OPTIONS=-I "${CMSIS_DIR}/CMSIS/Core/Include"
@@ -1006,6 +1006,14 @@ ${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o: ../src/mqtt/mqtt_exchange_bu
 	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION) -I"../src/azure-sdk-for-c/sdk/inc" -ffunction-sections -fdata-sections -I"../src/config/SAMD21_WG_IOT/driver/winc/include/" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/dev" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp/include" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/common" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/driver" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/socket" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/spi_flash" -I"../src" -I"../src/config/SAMD21_WG_IOT" -I"../src/packs/ATSAMD21G18A_DFP" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/CMSIS/" -Werror -Wall -MMD -MF "${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o.d" -o ${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o ../src/mqtt/mqtt_exchange_buffer/mqtt_exchange_buffer.c    -DXPRJ_SAMD21_WG_IOT=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/samd21a" ${PACK_COMMON_OPTIONS} 
 	@${FIXDEPS} "${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
 	
+
+${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o: ../src/mqtt/mqtt_session_storage/mqtt_session_storage.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1356015544" 
+	@${RM} ${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION) -I"../src/azure-sdk-for-c/sdk/inc" -ffunction-sections -fdata-sections -I"../src/config/SAMD21_WG_IOT/driver/winc/include/" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/dev" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp/include" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/common" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/driver" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/socket" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/spi_flash" -I"../src" -I"../src/config/SAMD21_WG_IOT" -I"../src/packs/ATSAMD21G18A_DFP" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/CMSIS/" -Werror -Wall -MMD -MF "${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o.d" -o ${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o ../src/mqtt/mqtt_session_storage/mqtt_session_storage.c    -DXPRJ_SAMD21_WG_IOT=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/samd21a" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/1019103266/mqtt_packetTransfer_interface.o: ../src/mqtt/mqtt_packetTransfer_interface.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/1019103266" 
 	@${RM} ${OBJECTDIR}/_ext/1019103266/mqtt_packetTransfer_interface.o.d 
@@ -1097,6 +1105,20 @@ ${OBJECTDIR}/_ext/1360937237/led.o: ../src/led.c  nbproject/Makefile-${CND_CONF}
 	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION) -I"../src/azure-sdk-for-c/sdk/inc" -ffunction-sections -fdata-sections -I"../src/config/SAMD21_WG_IOT/driver/winc/include/" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/dev" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp/include" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/common" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/driver" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/socket" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/spi_flash" -I"../src" -I"../src/config/SAMD21_WG_IOT" -I"../src/packs/ATSAMD21G18A_DFP" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/CMSIS/" -Werror -Wall -MMD -MF "${OBJECTDIR}/_ext/1360937237/led.o.d" -o ${OBJECTDIR}/_ext/1360937237/led.o ../src/led.c    -DXPRJ_SAMD21_WG_IOT=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/samd21a" ${PACK_COMMON_OPTIONS} 
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/led.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1360937237/i2c_bus.o: ../src/i2c_bus.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/i2c_bus.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/i2c_bus.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION) -I"../src/azure-sdk-for-c/sdk/inc" -ffunction-sections -fdata-sections -I"../src/config/SAMD21_WG_IOT/driver/winc/include/" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/dev" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp/include" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/common" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/driver" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/socket" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/spi_flash" -I"../src" -I"../src/config/SAMD21_WG_IOT" -I"../src/packs/ATSAMD21G18A_DFP" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/CMSIS/" -Werror -Wall -MMD -MF "${OBJECTDIR}/_ext/1360937237/i2c_bus.o.d" -o ${OBJECTDIR}/_ext/1360937237/i2c_bus.o ../src/i2c_bus.c    -DXPRJ_SAMD21_WG_IOT=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/samd21a" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/i2c_bus.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1360937237/flash_storage.o: ../src/flash_storage.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/flash_storage.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/flash_storage.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION) -I"../src/azure-sdk-for-c/sdk/inc" -ffunction-sections -fdata-sections -I"../src/config/SAMD21_WG_IOT/driver/winc/include/" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/dev" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp/include" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/common" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/driver" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/socket" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/spi_flash" -I"../src" -I"../src/config/SAMD21_WG_IOT" -I"../src/packs/ATSAMD21G18A_DFP" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/CMSIS/" -Werror -Wall -MMD -MF "${OBJECTDIR}/_ext/1360937237/flash_storage.o.d" -o ${OBJECTDIR}/_ext/1360937237/flash_storage.o ../src/flash_storage.c    -DXPRJ_SAMD21_WG_IOT=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/samd21a" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/flash_storage.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/2034671162/az_json_reader.o: ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_reader.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/2034671162" 
 	@${RM} ${OBJECTDIR}/_ext/2034671162/az_json_reader.o.d 
@@ -2015,6 +2037,14 @@ ${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o: ../src/mqtt/mqtt_exchange_bu
 	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION) -I"../src/azure-sdk-for-c/sdk/inc" -ffunction-sections -fdata-sections -I"../src/config/SAMD21_WG_IOT/driver/winc/include/" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/dev" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp/include" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/common" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/driver" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/socket" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/spi_flash" -I"../src" -I"../src/config/SAMD21_WG_IOT" -I"../src/packs/ATSAMD21G18A_DFP" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/CMSIS/" -Werror -Wall -MMD -MF "${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o.d" -o ${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o ../src/mqtt/mqtt_exchange_buffer/mqtt_exchange_buffer.c    -DXPRJ_SAMD21_WG_IOT=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/samd21a" ${PACK_COMMON_OPTIONS} 
 	@${FIXDEPS} "${OBJECTDIR}/_ext/781924270/mqtt_exchange_buffer.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
 	
+
+${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o: ../src/mqtt/mqtt_session_storage/mqtt_session_storage.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1356015544" 
+	@${RM} ${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION) -I"../src/azure-sdk-for-c/sdk/inc" -ffunction-sections -fdata-sections -I"../src/config/SAMD21_WG_IOT/driver/winc/include/" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/dev" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp/include" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/common" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/driver" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/socket" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/spi_flash" -I"../src" -I"../src/config/SAMD21_WG_IOT" -I"../src/packs/ATSAMD21G18A_DFP" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/CMSIS/" -Werror -Wall -MMD -MF "${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o.d" -o ${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o ../src/mqtt/mqtt_session_storage/mqtt_session_storage.c    -DXPRJ_SAMD21_WG_IOT=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/samd21a" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1356015544/mqtt_session_storage.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/1019103266/mqtt_packetTransfer_interface.o: ../src/mqtt/mqtt_packetTransfer_interface.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/1019103266" 
 	@${RM} ${OBJECTDIR}/_ext/1019103266/mqtt_packetTransfer_interface.o.d 
@@ -2106,6 +2136,20 @@ ${OBJECTDIR}/_ext/1360937237/led.o: ../src/led.c  nbproject/Makefile-${CND_CONF}
 	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION) -I"../src/azure-sdk-for-c/sdk/inc" -ffunction-sections -fdata-sections -I"../src/config/SAMD21_WG_IOT/driver/winc/include/" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/dev" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp/include" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/common" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/driver" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/socket" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/spi_flash" -I"../src" -I"../src/config/SAMD21_WG_IOT" -I"../src/packs/ATSAMD21G18A_DFP" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/CMSIS/" -Werror -Wall -MMD -MF "${OBJECTDIR}/_ext/1360937237/led.o.d" -o ${OBJECTDIR}/_ext/1360937237/led.o ../src/led.c    -DXPRJ_SAMD21_WG_IOT=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/samd21a" ${PACK_COMMON_OPTIONS} 
 	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/led.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1360937237/i2c_bus.o: ../src/i2c_bus.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/i2c_bus.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/i2c_bus.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION) -I"../src/azure-sdk-for-c/sdk/inc" -ffunction-sections -fdata-sections -I"../src/config/SAMD21_WG_IOT/driver/winc/include/" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/dev" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp/include" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/common" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/driver" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/socket" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/spi_flash" -I"../src" -I"../src/config/SAMD21_WG_IOT" -I"../src/packs/ATSAMD21G18A_DFP" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/CMSIS/" -Werror -Wall -MMD -MF "${OBJECTDIR}/_ext/1360937237/i2c_bus.o.d" -o ${OBJECTDIR}/_ext/1360937237/i2c_bus.o ../src/i2c_bus.c    -DXPRJ_SAMD21_WG_IOT=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/samd21a" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/i2c_bus.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1360937237/flash_storage.o: ../src/flash_storage.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/flash_storage.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/flash_storage.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION) -I"../src/azure-sdk-for-c/sdk/inc" -ffunction-sections -fdata-sections -I"../src/config/SAMD21_WG_IOT/driver/winc/include/" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/dev" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/bsp/include" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/common" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/driver" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/socket" -I"../src/config/SAMD21_WG_IOT/driver/winc/include/drv/spi_flash" -I"../src" -I"../src/config/SAMD21_WG_IOT" -I"../src/packs/ATSAMD21G18A_DFP" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/CMSIS/" -Werror -Wall -MMD -MF "${OBJECTDIR}/_ext/1360937237/flash_storage.o.d" -o ${OBJECTDIR}/_ext/1360937237/flash_storage.o ../src/flash_storage.c    -DXPRJ_SAMD21_WG_IOT=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/samd21a" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1360937237/flash_storage.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
 ${OBJECTDIR}/_ext/2034671162/az_json_reader.o: ../src/azure-sdk-for-c/sdk/src/azure/core/az_json_reader.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/2034671162" 
 	@${RM} ${OBJECTDIR}/_ext/2034671162/az_json_reader.o.d 
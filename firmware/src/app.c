@@ -65,6 +65,7 @@
 #include "credentials_storage/credentials_storage.h"
 #include "debug_print.h"
 #include "led.h"
+#include "i2c_bus.h"
 #include "mqtt/mqtt_core/mqtt_core.h"
 #include "services/iot/cloud/mqtt_packetPopulation/mqtt_packetPopulate.h"
 #include "services/iot/cloud/mqtt_packetPopulation/mqtt_iothub_packetPopulate.h"
@@ -86,6 +87,8 @@
 // *****************************************************************************
 static void APP_SendToCloud(void);
 static float APP_GetTempSensorValue(void);
+static void APP_ReadTempSensor(void);
+static void APP_TempSensorReadCb(i2cBusTransfer_t *transfer);
 static void APP_DataTask(void);
 static void APP_WiFiConnectionStateChanged(uint8_t status);
 static void APP_ProvisionRespCb(DRV_HANDLE handle, WDRV_WINC_SSID * targetSSID, WDRV_WINC_AUTH_CONTEXT * authCtx, bool status);
@@ -178,7 +181,6 @@ static char request_id_buf[8];
 // IoT Hub Telemetry Values
 char telemetry_topic[128];
 static const az_span telemetry_name = AZ_SPAN_LITERAL_FROM_STR("temperature");
-static char telemetry_payload[256];
 
 // IoT Hub Commands Values
 static char commands_response_topic[128];
@@ -196,6 +198,51 @@ static char incoming_since_value[32];
 // IoT Hub Twin Values
 //static char twin_get_topic[128];
 static char reported_property_topic[128];
+
+// Longest property name the twin scanner needs to recognise
+#define TWIN_KEY_SIZE       24
+// Longest number kept, sign included
+#define TWIN_NUMBER_SIZE    12
+// Nesting levels told apart as objects or arrays, deeper ones are skipped
+#define TWIN_MAX_DEPTH      32
+
+// Member whose value the scanner waits for
+typedef enum
+{
+    TWIN_VALUE_NONE = 0,
+    TWIN_VALUE_DESIRED,         // "desired" object of a twin GET response
+    TWIN_VALUE_TEMPERATURE,
+    TWIN_VALUE_VERSION
+} twin_value_t;
+
+// Twin GET response or desired properties patch being received. The payload
+// is scanned as it streams in rather than kept, so the document may be of
+// any size: only the current property name and number are held.
+typedef struct
+{
+    az_iot_hub_client_twin_response response;
+    bool valid;                 // Topic parsed, payload being scanned
+    bool failed;                // Not JSON the scanner can follow
+    uint8_t depth;              // Objects and arrays open
+    uint8_t desiredDepth;       // Depth of the desired properties, 0 until found
+    uint32_t arrays;            // Bit n set: level n + 1 is an array
+    bool inString;
+    bool escape;
+    bool stringIsKey;
+    bool expectingKey;
+    twin_value_t value;
+    char key[TWIN_KEY_SIZE];
+    uint8_t keyLength;          // TWIN_KEY_SIZE once too long to be of interest
+    char number[TWIN_NUMBER_SIZE];
+    uint8_t numberLength;
+    bool desiredFound;
+    bool temperatureFound;
+    bool versionFound;
+    int32_t temperature;
+    int32_t version;
+} twin_document_t;
+
+static twin_document_t twin_document;
 static const az_span desired_property_name = AZ_SPAN_LITERAL_FROM_STR("desired");
 static const az_span desired_property_version_name = AZ_SPAN_LITERAL_FROM_STR("$version");
 static const az_span desired_temp_property_name = AZ_SPAN_LITERAL_FROM_STR("targetTemperature");
@@ -212,6 +259,22 @@ static bool max_temp_changed = false;
 static int32_t current_device_temp;
 static int32_t device_temperature_avg_total;
 static uint32_t device_temperature_avg_count = 0;
+
+/* MCP9808 read, TA: AMBIENT TEMPERATURE REGISTER ADDRESS: 0x5 */
+static uint8_t tempSensorRegisterAddr = 0x5;
+/* Temp sensor read buffer */
+static uint8_t tempSensorRxBuffer[2];
+static i2cBusTransfer_t tempSensorTransfer =
+{
+    .address = 0x18,
+    .writeData = &tempSensorRegisterAddr,
+    .writeLength = 1,
+    .readData = tempSensorRxBuffer,
+    .readLength = 2,
+    .callback = APP_TempSensorReadCb
+};
+static float tempSensorValue = 0;
+
 static int32_t device_max_temp;
 static int32_t device_min_temp;
 static int32_t device_avg_temp;
@@ -304,6 +367,8 @@ void APP_Initialize(void)
         }
     }
     /* Open I2C driver client */
+    I2C_BUS_init();
+    APP_ReadTempSensor();
     ADC_Enable();
     LED_test();
 #if (CFG_APP_WINC_DEBUG == 1)    
@@ -368,11 +433,25 @@ static void APP_ProvisionRespCb(DRV_HANDLE handle, WDRV_WINC_SSID * targetSSID,
 void iot_provisioning_completed(void)
 {
     debug_printGOOD("Azure IoT Provisioning Completed.");
-    CLOUD_init_host(hub_hostname, attDeviceID, &pf_mqqt_iothub_client);
+    CLOUD_init_host(hub_hostname, assigned_device_id_buf, &pf_mqqt_iothub_client);
     CLOUD_disconnect();
-    CLOUD_reset();
+    // Same access point, another host
+    CLOUD_recover(CLOUD_RECOVER_SOCKET);
     App_DataTaskHandle = SYS_TIME_CallbackRegisterMS(APP_DataTaskcb, 0, APP_DATATASK_INTERVAL, SYS_TIME_PERIODIC);
 }
+
+// The hub DPS assigned does not know the device or rejects its credentials,
+// or kept refusing it: moved or disabled since. Called by CLOUD_task().
+static void iot_assignment_refused(void)
+{
+    debug_printError("APP: IoT Hub refused the device, provisioning again");
+    dps_assignment_forget();
+    SYS_TIME_TimerDestroy(App_DataTaskHandle);
+    App_DataTaskHandle = SYS_TIME_HANDLE_INVALID;
+    CLOUD_init_host(CFG_MQTT_PROVISIONING_HOST, attDeviceID, &pf_mqqt_iotprovisioning_client);
+    CLOUD_disconnect();
+    CLOUD_recover(CLOUD_RECOVER_SOCKET);
+}
 #endif //CFG_MQTT_PROVISIONING_HOST 
 
 void APP_Tasks(void)
@@ -466,7 +545,17 @@ void APP_Tasks(void)
 
 #ifdef CFG_MQTT_PROVISIONING_HOST
             pf_mqqt_iotprovisioning_client.MQTT_CLIENT_task_completed = iot_provisioning_completed;
-            CLOUD_init_host(CFG_MQTT_PROVISIONING_HOST, attDeviceID, &pf_mqqt_iotprovisioning_client);
+            pf_mqqt_iothub_client.MQTT_CLIENT_connect_refused = iot_assignment_refused;
+            if (dps_assignment_restore(attDeviceID) == true)
+            {
+                // Straight to the hub DPS assigned before the reboot
+                CLOUD_init_host(hub_hostname, assigned_device_id_buf, &pf_mqqt_iothub_client);
+                App_DataTaskHandle = SYS_TIME_CallbackRegisterMS(APP_DataTaskcb, 0, APP_DATATASK_INTERVAL, SYS_TIME_PERIODIC);
+            }
+            else
+            {
+                CLOUD_init_host(CFG_MQTT_PROVISIONING_HOST, attDeviceID, &pf_mqqt_iotprovisioning_client);
+            }
 #else
             CLOUD_init_host(hub_hostname, attDeviceID, &pf_mqqt_iothub_client);
 #endif //CFG_MQTT_PROVISIONING_HOST 
@@ -487,6 +576,8 @@ void APP_Tasks(void)
             }
             CLOUD_sched();
             wifi_sched();
+            CRYPTO_CLIENT_sched();
+            I2C_BUS_sched();
             MQTT_sched();
             LED_sched();
             break;
@@ -511,6 +602,8 @@ static void APP_DataTask(void)
    RTC_RTCCTimeGet(&sys_time);
    timeNow = mktime(&sys_time);
 
+   APP_ReadTempSensor();
+
    // Example of how to send data when MQTT is connected every 1 second based on the system clock
     if (CLOUD_isConnected()) {
         // How many seconds since the last time this loop ran?
@@ -736,91 +829,184 @@ void APP_ReceivedFromCloud_methods(uint8_t* topic, uint8_t* payload)
   handle_command_message(az_span_create_from_str((char*)payload), &method_request);
 }
 
-// Parse the desired temperature property from the incoming JSON
-static az_result parse_twin_desired_temperature_property(
-    az_span twin_payload_span,
-    bool is_twin_get,
-    int32_t* parsed_value,
-    int32_t* version_number)
+static bool twin_key_is(const twin_document_t *document, az_span name)
 {
-  az_json_reader jp;
-  bool desired_found = false;
-  RETURN_IF_AZ_RESULT_FAILED(az_json_reader_init(&jp, twin_payload_span, NULL));
-  RETURN_IF_AZ_RESULT_FAILED(az_json_reader_next_token(&jp));
-  if (jp.token.kind != AZ_JSON_TOKEN_BEGIN_OBJECT)
-  {
-    return AZ_ERROR_UNEXPECTED_CHAR;
-  }
+    return ((document->keyLength == az_span_size(name))
+        && (memcmp(document->key, az_span_ptr(name), document->keyLength) == 0));
+}
 
-  if (is_twin_get)
-  {
-    // If is twin get payload, we have to parse one level deeper for "desired" wrapper
-    RETURN_IF_AZ_RESULT_FAILED(az_json_reader_next_token(&jp));
-    while (jp.token.kind != AZ_JSON_TOKEN_END_OBJECT)
-    {
-      if (az_json_token_is_text_equal(&jp.token, desired_property_name))
-      {
-        desired_found = true;
-        RETURN_IF_AZ_RESULT_FAILED(az_json_reader_next_token(&jp));
-        break;
-      }
-      else
-      {
-        // else ignore token.
-        RETURN_IF_AZ_RESULT_FAILED(az_json_reader_skip_children(&jp));
-      }
+// A number ends at the first character that is not part of it
+static void twin_end_number(twin_document_t *document)
+{
+    int32_t number;
 
-      RETURN_IF_AZ_RESULT_FAILED(az_json_reader_next_token(&jp));
+    if (document->numberLength == 0)
+    {
+        return;
     }
-  }
-  else
-  {
-    desired_found = true;
-  }
-
-  if (!desired_found)
-  {
-    debug_printError("Desired property object not found in twin");
-    return AZ_ERROR_ITEM_NOT_FOUND;
-  }
-
-  if (jp.token.kind != AZ_JSON_TOKEN_BEGIN_OBJECT)
-  {
-    return AZ_ERROR_UNEXPECTED_CHAR;
-  }
-  RETURN_IF_AZ_RESULT_FAILED(az_json_reader_next_token(&jp));
-
-  bool temp_found = false;
-  bool version_found = false;
-  while (!(temp_found && version_found) || (jp.token.kind != AZ_JSON_TOKEN_END_OBJECT))
-  {
-    if (az_json_token_is_text_equal(&jp.token, desired_temp_property_name))
+    if (az_result_failed(az_span_atoi32(az_span_create((uint8_t *)document->number, document->numberLength), &number)))
     {
-      RETURN_IF_AZ_RESULT_FAILED(az_json_reader_next_token(&jp));
-      RETURN_IF_AZ_RESULT_FAILED(az_json_token_get_int32(&jp.token, parsed_value));
-      temp_found = true;
+        // Not an integer: as if the property was missing
+        document->numberLength = 0;
+        return;
     }
-    else if (az_json_token_is_text_equal(&jp.token, desired_property_version_name))
+    if (document->value == TWIN_VALUE_TEMPERATURE)
     {
-      RETURN_IF_AZ_RESULT_FAILED(az_json_reader_next_token(&jp));
-      RETURN_IF_AZ_RESULT_FAILED(az_json_token_get_int32(&jp.token, version_number));
-      version_found = true;
+        document->temperature = number;
+        document->temperatureFound = true;
     }
-    else
+    else if (document->value == TWIN_VALUE_VERSION)
     {
-      // else ignore token.
-      RETURN_IF_AZ_RESULT_FAILED(az_json_reader_skip_children(&jp));
+        document->version = number;
+        document->versionFound = true;
     }
-    RETURN_IF_AZ_RESULT_FAILED(az_json_reader_next_token(&jp));
-  }
+    document->numberLength = 0;
+    document->value = TWIN_VALUE_NONE;
+}
 
-  if (temp_found && version_found)
-  {
-    debug_printInfo("Desired temperature: %d\tVersion number: %d", (int)*parsed_value, (int)*version_number);
-    return AZ_OK;
-  }
+static bool twin_is_number_char(char c)
+{
+    return (((c >= '0') && (c <= '9')) || (c == '-') || (c == '+') || (c == '.') || (c == 'e') || (c == 'E'));
+}
+
+// Finds "targetTemperature" and "$version" among the desired properties: the
+// members of the "desired" object of a twin GET response, or of the top
+// level object of a patch. Fed chunk by chunk, in order.
+static void twin_scan(twin_document_t *document, const uint8_t *data, uint16_t length)
+{
+    uint16_t i;
+    char c;
+
+    for (i = 0; (i < length) && (document->failed == false); i++)
+    {
+        c = (char)data[i];
+        if (document->inString == true)
+        {
+            if (document->escape == true)
+            {
+                document->escape = false;
+            }
+            else if (c == '\\')
+            {
+                // None of the names looked for has an escape
+                document->escape = true;
+                document->keyLength = TWIN_KEY_SIZE;
+            }
+            else if (c == '"')
+            {
+                document->inString = false;
+            }
+            else if ((document->stringIsKey == true) && (document->keyLength < TWIN_KEY_SIZE))
+            {
+                document->key[document->keyLength++] = c;
+            }
+            continue;
+        }
 
-  return AZ_ERROR_ITEM_NOT_FOUND;
+        if ((document->numberLength > 0) && (twin_is_number_char(c) == false))
+        {
+            twin_end_number(document);
+        }
+        switch (c)
+        {
+        case '"':
+            document->inString = true;
+            document->stringIsKey = document->expectingKey;
+            document->expectingKey = false;
+            if (document->stringIsKey == true)
+            {
+                document->keyLength = 0;
+            }
+            else
+            {
+                document->value = TWIN_VALUE_NONE;
+            }
+            break;
+        case ':':
+            document->value = TWIN_VALUE_NONE;
+            if ((document->desiredDepth == 0) && (document->depth == 1) && twin_key_is(document, desired_property_name))
+            {
+                document->value = TWIN_VALUE_DESIRED;
+            }
+            else if ((document->desiredDepth != 0) && (document->depth == document->desiredDepth))
+            {
+                if (twin_key_is(document, desired_temp_property_name))
+                {
+                    document->value = TWIN_VALUE_TEMPERATURE;
+                }
+                else if (twin_key_is(document, desired_property_version_name))
+                {
+                    document->value = TWIN_VALUE_VERSION;
+                }
+            }
+            break;
+        case '{':
+        case '[':
+            if (document->depth == UINT8_MAX - 1)
+            {
+                document->failed = true;
+                break;
+            }
+            if ((c == '{') && (document->value == TWIN_VALUE_DESIRED))
+            {
+                document->desiredFound = true;
+                document->desiredDepth = document->depth + 1;
+            }
+            if (document->depth < TWIN_MAX_DEPTH)
+            {
+                if (c == '[')
+                {
+                    document->arrays |= (1UL << document->depth);
+                }
+                else
+                {
+                    document->arrays &= ~(1UL << document->depth);
+                }
+            }
+            document->depth++;
+            document->expectingKey = (c == '{');
+            document->value = TWIN_VALUE_NONE;
+            break;
+        case '}':
+        case ']':
+            if (document->depth == 0)
+            {
+                document->failed = true;
+                break;
+            }
+            if (document->depth == document->desiredDepth)
+            {
+                // Nothing else of interest follows the desired properties
+                document->desiredDepth = UINT8_MAX;
+            }
+            document->depth--;
+            document->expectingKey = false;
+            document->value = TWIN_VALUE_NONE;
+            break;
+        case ',':
+            // Keys follow in objects; levels deeper than tracked are skipped
+            document->expectingKey = (document->depth > 0) && (document->depth <= TWIN_MAX_DEPTH)
+                && ((document->arrays & (1UL << (document->depth - 1))) == 0);
+            document->value = TWIN_VALUE_NONE;
+            break;
+        default:
+            if ((twin_is_number_char(c) == true)
+                && ((document->value == TWIN_VALUE_TEMPERATURE) || (document->value == TWIN_VALUE_VERSION)))
+            {
+                if (document->numberLength < TWIN_NUMBER_SIZE)
+                {
+                    document->number[document->numberLength++] = c;
+                }
+                else
+                {
+                    // Too long for an int32_t
+                    document->numberLength = 0;
+                    document->value = TWIN_VALUE_NONE;
+                }
+            }
+            break;
+        }
+    }
 }
 
 // Build the JSON payload for the reported property
@@ -931,45 +1117,39 @@ static int send_reported_temperature_property(
 
 // Switch on the type of twin message and handle accordingly | On desired prop, respond with max
 // temp reported prop.
-static void handle_twin_message(
-    az_span payload,
-    az_iot_hub_client_twin_response* twin_response)
+static void handle_twin_message(twin_document_t *document)
 {
-  az_result result;
-
-  int32_t desired_temp;
-  int32_t version_num;
   // Determine what type of incoming twin message this is. Print relevant data for the message.
-  switch (twin_response->response_type)
+  switch (document->response.response_type)
   {
     // A response from a twin GET publish message with the twin document as a payload.
     case AZ_IOT_HUB_CLIENT_TWIN_RESPONSE_TYPE_GET:
       debug_printInfo("A twin GET response was received");
-      if (az_result_failed(
-              result = parse_twin_desired_temperature_property(
-                  payload, true, &desired_temp, &version_num)))
+      if (document->desiredFound == false)
       {
-        // If the item can't be found, the desired temp might not be set so take no action
+        debug_printError("Desired property object not found in twin");
         break;
       }
-      else
+      if ((document->temperatureFound == false) || (document->versionFound == false))
       {
-        send_reported_temperature_property(desired_temp, version_num, false);
+        // If the item can't be found, the desired temp might not be set so take no action
+        break;
       }
+      debug_printInfo("Desired temperature: %d\tVersion number: %d", (int)document->temperature, (int)document->version);
+      send_reported_temperature_property(document->temperature, document->version, false);
       break;
     // An update to the desired properties with the properties as a JSON payload.
     case AZ_IOT_HUB_CLIENT_TWIN_RESPONSE_TYPE_DESIRED_PROPERTIES:
       debug_printInfo("A twin desired properties message was received");
 
       // Get the new temperature
-      if (az_result_failed(
-              result = parse_twin_desired_temperature_property(
-                  payload, false, &desired_temp, &version_num)))
+      if ((document->temperatureFound == false) || (document->versionFound == false))
       {
-        debug_printError("Could not parse desired temperature property, az_result %04x", result);
+        debug_printError("Could not parse desired temperature property");
         break;
       }
-      send_reported_temperature_property(desired_temp, version_num, false);
+      debug_printInfo("Desired temperature: %d\tVersion number: %d", (int)document->temperature, (int)document->version);
+      send_reported_temperature_property(document->temperature, document->version, false);
 
       break;
 
@@ -981,95 +1161,105 @@ static void handle_twin_message(
   }
 }
 
-void APP_ReceivedFromCloud_twin(uint8_t* topic, uint8_t* payload)
+void *APP_GetTwinDocument(void)
 {
-    debug_printInfo("Device Twin Get");
-	if (topic == NULL)
-	{
-        debug_printError("NULL topic");
-		return;
-	}
+    return &twin_document;
+}
 
-	az_iot_hub_client_twin_response twin_response;
-	az_span twin_topic = az_span_create_from_str((char*)topic);
-	az_result result = az_iot_hub_client_twin_parse_received_topic(&hub_client, twin_topic, &twin_response);
-	if (az_result_failed(result))
-	{
-		debug_printError("az_iot_hub_client_twin_parse_received_topic failed");
-		return;
-	}
+// Twin GET responses and desired properties patches are streamed in and
+// scanned chunk by chunk, so they are not limited by any buffer
+void APP_ReceivedFromCloud_twin_begin(void *context, uint8_t *topic, uint32_t payloadLength)
+{
+    twin_document_t *document = (twin_document_t *)context;
 
-	if (az_span_size(twin_response.request_id) != 0 && IOT_DEBUG_PRINT)
-	{
-		char request_id_buf[50];
-		az_span_to_str(request_id_buf, sizeof(request_id_buf), twin_response.request_id);
-		debug_printInfo("Twin request, request_id:%s, status: %d", request_id_buf, twin_response.status);
-	}
+    memset(document, 0, sizeof(twin_document_t));
 
-	if (payload == NULL)
-	{
-        debug_printError("NULL payload");
-		return; // no payload, nothing to process
-	}
+    az_span twin_topic = az_span_create_from_str((char*)topic);
+    az_result result = az_iot_hub_client_twin_parse_received_topic(&hub_client, twin_topic, &document->response);
+    if (az_result_failed(result))
+    {
+        debug_printError("az_iot_hub_client_twin_parse_received_topic failed");
+        return;
+    }
+
+    if (az_span_size(document->response.request_id) != 0 && IOT_DEBUG_PRINT)
+    {
+        char request_id_buf[50];
+        az_span_to_str(request_id_buf, sizeof(request_id_buf), document->response.request_id);
+        debug_printInfo("Twin request, request_id:%s, status: %d", request_id_buf, document->response.status);
+    }
 
-  handle_twin_message(az_span_create_from_str((char*)payload), &twin_response);
+    if (document->response.response_type == AZ_IOT_HUB_CLIENT_TWIN_RESPONSE_TYPE_DESIRED_PROPERTIES)
+    {
+        // A patch holds the desired properties at its top level
+        document->desiredFound = true;
+        document->desiredDepth = 1;
+    }
+    document->valid = true;
 }
 
-void APP_ReceivedFromCloud_patch(uint8_t* topic, uint8_t* payload)
+void APP_ReceivedFromCloud_twin_data(void *context, uint8_t *data, uint16_t length)
 {
-    debug_printInfo("Device Twin Patch");
-	if (topic == NULL)
-	{
-        debug_printError("NULL topic");
-		return;
-	}
+    twin_document_t *document = (twin_document_t *)context;
 
-	az_iot_hub_client_twin_response twin_response;
-	az_span twin_topic = az_span_create_from_str((char*)topic);
-	az_result result = az_iot_hub_client_twin_parse_received_topic(&hub_client, twin_topic, &twin_response);
-	if (az_result_failed(result))
-	{
-		debug_printError("az_iot_hub_client_twin_parse_received_topic failed");
-		return;
+    if (document->valid == false)
+    {
+        return;
     }
+    twin_scan(document, data, length);
+}
+
+void APP_ReceivedFromCloud_twin_end(void *context, bool complete)
+{
+    twin_document_t *document = (twin_document_t *)context;
 
-    if (payload)
+    if (document->valid == false)
     {
-        debug_printGOOD("Payload: %s", payload);
+        return;
     }
-    else
+    document->valid = false;
+    if (complete == false)
+    {
+        debug_printError("Twin document lost with the connection");
+        return;
+    }
+    // A number may end the payload
+    twin_end_number(document);
+    if ((document->failed == true) || (document->depth != 0) || (document->inString == true))
     {
-        debug_printError("NULL payload");
+        debug_printError("Twin document is not valid JSON");
+        return;
+    }
+
+    handle_twin_message(document);
+}
+
+static void APP_TempSensorReadCb(i2cBusTransfer_t *transfer)
+{
+    uint8_t *rxBuffer = tempSensorRxBuffer;
+
+    /* Keep the last reading if this one failed */
+    if (transfer->failed == true) {
+        return;
     }
+    rxBuffer[0] = rxBuffer[0] & 0x1F; //Clear flag bits
+    if ((rxBuffer[0] & 0x10) == 0x10) { 
+        rxBuffer[0] = rxBuffer[0] & 0x0F; //Clear SIGN
+        tempSensorValue = 256.0 - (rxBuffer[0] * 16.0 + rxBuffer[1] / 16.0);
+    } else {
+        tempSensorValue = ((rxBuffer[0] * 16.0) + (rxBuffer[1] / 16.0));
+    }
+}
 
-    handle_twin_message(az_span_create_from_str((char*)payload), &twin_response);
+/* Queues a read of the sensor behind the ECC608 transfers, unless one is already on its way */
+static void APP_ReadTempSensor(void)
+{
+    I2C_BUS_submit(I2C_BUS_SENSOR, &tempSensorTransfer);
 }
 
 static float APP_GetTempSensorValue(void)
 {
-    float retVal = 0;
-    /* TA: AMBIENT TEMPERATURE REGISTER ADDRESS: 0x5 */
-    uint8_t registerAddr = 0x5;
-    /* Temp sensor read buffer */
-    uint8_t rxBuffer[2];
-    
-    while (SERCOM3_I2C_IsBusy() == true);
-    if (SERCOM3_I2C_WriteRead(0x18, (uint8_t *)&registerAddr, 1, (uint8_t *)rxBuffer, 2) == true) {        
-        /* Wait for the I2C transfer to complete */
-        while (SERCOM3_I2C_IsBusy() == true);
-
-        /* Transfer complete. Check if the transfer was successful */
-        if (SERCOM3_I2C_ErrorGet() == SERCOM_I2C_ERROR_NONE) {
-            rxBuffer[0] = rxBuffer[0] & 0x1F; //Clear flag bits
-            if ((rxBuffer[0] & 0x10) == 0x10) { 
-                rxBuffer[0] = rxBuffer[0] & 0x0F; //Clear SIGN
-                retVal = 256.0 - (rxBuffer[0] * 16.0 + rxBuffer[1] / 16.0);
-            } else {
-                retVal = ((rxBuffer[0] * 16.0) + (rxBuffer[1] / 16.0));
-            }
-        }                   
-    }            
-    return retVal;
+    return tempSensorValue;
 }        
 
 static void update_device_temp(void)
@@ -1096,11 +1286,11 @@ static void update_device_temp(void)
     max_temp_changed = ret;
 }
 
-static az_result build_telemetry_message(az_span* out_payload)
+static az_result build_telemetry_message(az_span destination, az_span* out_payload)
 {
   az_json_writer json_builder;
   RETURN_IF_AZ_RESULT_FAILED(
-      az_json_writer_init(&json_builder, AZ_SPAN_FROM_BUFFER(telemetry_payload), NULL));
+      az_json_writer_init(&json_builder, destination, NULL));
   RETURN_IF_AZ_RESULT_FAILED(az_json_writer_append_begin_object(&json_builder));
   RETURN_IF_AZ_RESULT_FAILED(az_json_writer_append_property_name(&json_builder, telemetry_name));
   RETURN_IF_AZ_RESULT_FAILED(az_json_writer_append_int32(
@@ -1124,17 +1314,40 @@ static int send_telemetry_message(void)
 
     update_device_temp();
 
+    // The payload is written straight into the MQTT Tx buffer
+    mqttPublishPacket cloudPublishPacket;
+    memset(&cloudPublishPacket, 0, sizeof(cloudPublishPacket));
+    cloudPublishPacket.topic = (uint8_t*)telemetry_topic;
+
+    uint16_t payload_capacity;
+    uint8_t* payload_buffer = MQTT_ReservePublishPacket(&cloudPublishPacket, &payload_capacity);
+    if (payload_buffer == NULL)
+    {
+      if (MQTT_GetConnectionState() != CONNECTED)
+      {
+        debug_printError("MQTT: Connection lost PUBLISH failed");
+        return AZ_ERROR_CANCELED;
+      }
+      debug_printError("MQTT: tx queue full, telemetry dropped");
+      return AZ_ERROR_NOT_ENOUGH_SPACE;
+    }
+
     az_span telemetry_payload_span;
-    if (az_result_failed(rc = build_telemetry_message(&telemetry_payload_span)))
+    if (az_result_failed(rc = build_telemetry_message(az_span_create(payload_buffer, payload_capacity), &telemetry_payload_span)))
     {
+      MQTT_CancelPublishPacket();
       debug_printError("Could not build telemetry payload, az_result %d", rc);
       return rc;
     }
 
     debug_printInfo("Sending Telemetry Message: temp %d", (int)current_device_temp);
-    rc = mqtt_publish_message(telemetry_topic, telemetry_payload_span, 0);
+    if (MQTT_CommitPublishPacket(az_span_size(telemetry_payload_span)) != true)
+    {
+      debug_printError("MQTT: Connection lost PUBLISH failed");
+      return AZ_ERROR_CANCELED;
+    }
 
-    return rc;
+    return 0;
 }
 
 // This will get called every 1 second only while we have a valid Cloud connection
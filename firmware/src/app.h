@@ -218,8 +218,10 @@ extern shared_networking_params_t shared_networking_params;
 
 void APP_application_post_provisioning(void);
 void APP_ReceivedFromCloud_methods(uint8_t *topic, uint8_t *payload);
-void APP_ReceivedFromCloud_patch(uint8_t *topic, uint8_t *payload);
-void APP_ReceivedFromCloud_twin(uint8_t *topic, uint8_t *payload);
+void *APP_GetTwinDocument(void);
+void APP_ReceivedFromCloud_twin_begin(void *context, uint8_t *topic, uint32_t payloadLength);
+void APP_ReceivedFromCloud_twin_data(void *context, uint8_t *data, uint16_t length);
+void APP_ReceivedFromCloud_twin_end(void *context, bool complete);
 
 #endif /* _APP_H */
 
@@ -52,6 +52,60 @@
 #define ATCA_POLLING_MAX_TIME_MSEC        2500
 #endif
 
+#ifndef ATCA_SESSION_AWAKE_MAX_MSEC
+// The watchdog of the device puts it to sleep 1.3 s after the wake
+#define ATCA_SESSION_AWAKE_MAX_MSEC       1000
+#endif
+
+#define ATCA_WAKE_SPEED                   100000
+#define ATCA_RUN_SPEED                    400000
+#define ATCA_WORD_ADDRESS_COMMAND         0x03
+#define ATCA_WORD_ADDRESS_IDLE            0x02
+
+/** \brief Commands run between atca_session_begin() and atca_session_end()
+ *         share a single wake and idle
+ */
+static struct
+{
+    bool active;
+    bool awake;                 // woken by a command of the session, not idled since
+    uint32_t wake_stamp;
+} atca_session;
+
+#ifdef ATCA_HAL_I2C
+/** \brief Steps of a command started by atca_start_command() */
+typedef enum
+{
+    ATCA_CMD_STEP_NONE,
+    ATCA_CMD_STEP_REFRESH_IDLE,
+    ATCA_CMD_STEP_WAKE_PULSE,
+    ATCA_CMD_STEP_WAKE_DELAY,
+    ATCA_CMD_STEP_WAKE_READ,
+    ATCA_CMD_STEP_SEND,
+    ATCA_CMD_STEP_EXECUTE,
+    ATCA_CMD_STEP_RECEIVE_COUNT,
+    ATCA_CMD_STEP_RECEIVE_DATA,
+    ATCA_CMD_STEP_IDLE
+} atca_command_step_t;
+
+/** \brief The command in progress; the device runs one at a time */
+static struct
+{
+    atca_command_step_t step;
+    bool started;               // the I2C transfer or the delay of the step is under way
+    bool transfer;              // the step waits on an I2C transfer rather than on a delay
+    ATCAPacket* packet;
+    ATCADevice device;
+    atca_command_cb callback;
+    void* context;
+    ATCA_STATUS status;
+    uint32_t delay_us;
+    uint32_t polls;
+    uint8_t wake_data[4];
+    uint8_t token;
+} atca_command;
+#endif
+
 #ifdef ATCA_NO_POLL
 /*Execution times for ATSHA204A supported commands...*/
 static const device_execution_time_t device_execution_time_204[] = {
@@ -272,8 +326,92 @@ ATCA_STATUS atGetExecTime(uint8_t opcode, ATCACommand ca_cmd)
 }
 #endif
 
+/** \brief Checks whether the device, left awake by an earlier command of the
+ *         session, has to be idled before its watchdog puts it to sleep.
+ *         Idle keeps TempKey and the Message Digest Buffer, sleep does not.
+ */
+static bool atca_session_expired(void)
+{
+    return ((atca_session.awake == true) && (atca_timer_elapsed_ms(atca_session.wake_stamp) >= ATCA_SESSION_AWAKE_MAX_MSEC));
+}
+
+/** \brief Records the wake of a command run in a session
+ */
+static void atca_session_woken(void)
+{
+    if (atca_session.active == true)
+    {
+        atca_session.awake = true;
+        atca_session.wake_stamp = atca_timer_stamp();
+    }
+}
+
+/** \brief Checks whether the device can be left awake after a command.
+ *         After an error it is idled, the next command wakes it again.
+ */
+static bool atca_session_stay_awake(ATCA_STATUS status)
+{
+    if ((atca_session.active == true) && (atca_session.awake == true) && (status == ATCA_SUCCESS))
+    {
+        return true;
+    }
+    atca_session.awake = false;
+    return false;
+}
+
+/** \brief Starts a batch of commands run with a single wake and idle, as in a
+ *         TLS handshake. The device is woken by the first command and kept
+ *         awake until atca_session_end(), or idled and woken again after an
+ *         error or when its watchdog is about to put it to sleep.
+ *
+ * \return ATCA_SUCCESS, or ATCA_FUNC_FAIL if a session is already open
+ */
+ATCA_STATUS atca_session_begin(void)
+{
+    if (atca_session.active == true)
+    {
+        return ATCA_FUNC_FAIL;
+    }
+    atca_session.active = true;
+    atca_session.awake = false;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Ends the session started by atca_session_begin(), idling the device
+ *
+ * \param[in] device  CryptoAuthentication device the commands were sent to.
+ *
+ * \return ATCA_SUCCESS, ATCA_FUNC_FAIL while a command started by
+ *         atca_start_command() is in progress, otherwise an error code.
+ */
+ATCA_STATUS atca_session_end(ATCADevice device)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+
+#ifdef ATCA_HAL_I2C
+    if (atca_command_busy() == true)
+    {
+        return ATCA_FUNC_FAIL;
+    }
+#endif
+    if (atca_session.awake == true)
+    {
+        status = atidle(device->mIface);
+        if (atca_session_expired() == true)
+        {
+            // May have been put to sleep by the watchdog already
+            status = ATCA_SUCCESS;
+        }
+    }
+    atca_session.active = false;
+    atca_session.awake = false;
+    return status;
+}
+
 /** \brief Wakes up device, sends the packet, waits for command completion,
  *         receives response, and puts the device into the idle state.
+ *         In a session, the wake and idle are left to the first command
+ *         and to atca_session_end().
  *
  * \param[inout] packet  As input, the packet to be sent. As output, the
  *                       data buffer in the packet structure will contain the
@@ -289,6 +427,14 @@ ATCA_STATUS atca_execute_command(ATCAPacket* packet, ATCADevice device)
     uint32_t max_delay_count;
     uint16_t rxsize;
 
+#ifdef ATCA_HAL_I2C
+    // Would wake or idle the device in the middle of the other command
+    if (atca_command_busy() == true)
+    {
+        return ATCA_FUNC_FAIL;
+    }
+#endif
+
     do
     {
 #ifdef ATCA_NO_POLL
@@ -303,9 +449,18 @@ ATCA_STATUS atca_execute_command(ATCAPacket* packet, ATCADevice device)
         max_delay_count = ATCA_POLLING_MAX_TIME_MSEC / ATCA_POLLING_FREQUENCY_TIME_MSEC;
 #endif
 
-        if ((status = atwake(device->mIface)) != ATCA_SUCCESS)
+        if (atca_session_expired() == true)
         {
-            break;
+            atidle(device->mIface);
+            atca_session.awake = false;
+        }
+        if (atca_session.awake == false)
+        {
+            if ((status = atwake(device->mIface)) != ATCA_SUCCESS)
+            {
+                break;
+            }
+            atca_session_woken();
         }
 
         // send the command
@@ -364,8 +519,320 @@ ATCA_STATUS atca_execute_command(ATCAPacket* packet, ATCADevice device)
     }
     while (0);
 
-    atidle(device->mIface);
+    if (atca_session_stay_awake(status) == false)
+    {
+        atidle(device->mIface);
+    }
     return status;
 }
 
+#ifdef ATCA_HAL_I2C
+/** \brief Checks the response of the device, as atca_execute_command() does
+ */
+static ATCA_STATUS atca_command_check_response(ATCAPacket* packet)
+{
+    if (packet->data[ATCA_COUNT_IDX] < 4)
+    {
+        return (packet->data[ATCA_COUNT_IDX] > 0) ? ATCA_RX_FAIL : ATCA_RX_NO_RESPONSE;
+    }
+    if (atCheckCrc(packet->data) != ATCA_SUCCESS)
+    {
+        return ATCA_RX_CRC_ERROR;
+    }
+    return isATCAError(packet->data);
+}
+
+static void atca_command_next(atca_command_step_t step)
+{
+    atca_command.step = step;
+    atca_command.started = false;
+}
+
+/** \brief Calls back the command over, which may start the next one
+ */
+static void atca_command_complete(void)
+{
+    atca_command_cb callback = atca_command.callback;
+
+    atca_command_next(ATCA_CMD_STEP_NONE);
+    callback(atca_command.status, atca_command.packet, atca_command.context);
+}
+
+/** \brief Ends the command with the given status, idling the device first
+ *         unless a session keeps it awake
+ */
+static void atca_command_finish(ATCA_STATUS status)
+{
+    atca_command.status = status;
+    if (atca_session_stay_awake(status) == true)
+    {
+        atca_command_complete();
+        return;
+    }
+    atca_command_next(ATCA_CMD_STEP_IDLE);
+}
+
+/** \brief Starts the I2C transfer or the delay of the current step
+ *
+ * \return false if the bus is in use, to be tried again on the next pass
+ */
+static bool atca_command_begin_step(void)
+{
+    ATCAIfaceCfg* cfg = atgetifacecfg(atca_command.device->mIface);
+    uint16_t address = cfg->atcai2c.slave_address >> 1;
+    uint8_t* data = NULL;
+    uint16_t length = 0;
+    bool read = false;
+
+    atca_command.transfer = true;
+    switch (atca_command.step)
+    {
+    case ATCA_CMD_STEP_WAKE_PULSE:
+        // SDA held low through a byte to the general call address, at a speed
+        // slow enough for it to last tWLO
+        if (hal_i2c_set_speed(ATCA_WAKE_SPEED) != ATCA_SUCCESS)
+        {
+            return false;
+        }
+        atca_command.token = 0;
+        address = 0;
+        data = &atca_command.token;
+        length = 1;
+        break;
+
+    case ATCA_CMD_STEP_WAKE_DELAY:
+    case ATCA_CMD_STEP_EXECUTE:
+        atca_command.transfer = false;
+        return (atca_timer_start_us(atca_command.delay_us) == ATCA_SUCCESS);
+
+    case ATCA_CMD_STEP_WAKE_READ:
+        if (hal_i2c_set_speed(ATCA_RUN_SPEED) != ATCA_SUCCESS)
+        {
+            return false;
+        }
+        data = atca_command.wake_data;
+        length = sizeof(atca_command.wake_data);
+        read = true;
+        break;
+
+    case ATCA_CMD_STEP_SEND:
+        atca_command.packet->_reserved = ATCA_WORD_ADDRESS_COMMAND;
+        data = (uint8_t*)atca_command.packet;
+        length = atca_command.packet->txsize + 1;
+        break;
+
+    case ATCA_CMD_STEP_RECEIVE_COUNT:
+        memset(atca_command.packet->data, 0, sizeof(atca_command.packet->data));
+        data = atca_command.packet->data;
+        length = 1;
+        read = true;
+        break;
+
+    case ATCA_CMD_STEP_RECEIVE_DATA:
+        data = &atca_command.packet->data[1];
+        length = atca_command.packet->data[ATCA_COUNT_IDX] - 1;
+        read = true;
+        break;
+
+    case ATCA_CMD_STEP_REFRESH_IDLE:
+    case ATCA_CMD_STEP_IDLE:
+        atca_command.token = ATCA_WORD_ADDRESS_IDLE;
+        data = &atca_command.token;
+        length = 1;
+        break;
+
+    default:
+        return false;
+    }
+    return (hal_i2c_transfer_start(address, data, length, read) == ATCA_SUCCESS);
+}
+
+/** \brief Moves on once the I2C transfer or the delay of the current step is over
+ */
+static void atca_command_end_step(ATCA_STATUS result)
+{
+    static const uint8_t wake_response[4] = { 0x04, 0x11, 0x33, 0x43 };
+    ATCAPacket* packet = atca_command.packet;
+
+    switch (atca_command.step)
+    {
+    case ATCA_CMD_STEP_REFRESH_IDLE:
+        // Not acknowledged if the watchdog put the device to sleep already
+        atca_command_next(ATCA_CMD_STEP_WAKE_PULSE);
+        break;
+
+    case ATCA_CMD_STEP_WAKE_PULSE:
+        // Not acknowledged by design
+        atca_command.delay_us = atgetifacecfg(atca_command.device->mIface)->wake_delay;
+        atca_command_next(ATCA_CMD_STEP_WAKE_DELAY);
+        break;
+
+    case ATCA_CMD_STEP_WAKE_DELAY:
+        atca_command_next(ATCA_CMD_STEP_WAKE_READ);
+        break;
+
+    case ATCA_CMD_STEP_WAKE_READ:
+        if ((result != ATCA_SUCCESS) || (memcmp(atca_command.wake_data, wake_response, sizeof(wake_response)) != 0))
+        {
+            atca_command_finish(ATCA_COMM_FAIL);
+            break;
+        }
+        atca_session_woken();
+        atca_command_next(ATCA_CMD_STEP_SEND);
+        break;
+
+    case ATCA_CMD_STEP_SEND:
+        if (result != ATCA_SUCCESS)
+        {
+            atca_command_finish(ATCA_COMM_FAIL);
+            break;
+        }
+        atca_command_next(ATCA_CMD_STEP_EXECUTE);
+        break;
+
+    case ATCA_CMD_STEP_EXECUTE:
+        atca_command_next(ATCA_CMD_STEP_RECEIVE_COUNT);
+        break;
+
+    case ATCA_CMD_STEP_RECEIVE_COUNT:
+        if (result != ATCA_SUCCESS)
+        {
+            // Still executing: the device does not acknowledge its address
+            if (atca_command.polls-- == 0)
+            {
+                atca_command_finish(ATCA_RX_NO_RESPONSE);
+                break;
+            }
+            atca_command.delay_us = ATCA_POLLING_FREQUENCY_TIME_MSEC * 1000;
+            atca_command_next(ATCA_CMD_STEP_EXECUTE);
+            break;
+        }
+        if (packet->data[ATCA_COUNT_IDX] < ATCA_RSP_SIZE_MIN)
+        {
+            atca_command_finish(ATCA_INVALID_SIZE);
+            break;
+        }
+        if (packet->data[ATCA_COUNT_IDX] > sizeof(packet->data))
+        {
+            atca_command_finish(ATCA_SMALL_BUFFER);
+            break;
+        }
+        atca_command_next(ATCA_CMD_STEP_RECEIVE_DATA);
+        break;
+
+    case ATCA_CMD_STEP_RECEIVE_DATA:
+        atca_command_finish((result == ATCA_SUCCESS) ? atca_command_check_response(packet) : ATCA_COMM_FAIL);
+        break;
+
+    case ATCA_CMD_STEP_IDLE:
+    default:
+        // The next command started by the callback is run by the loop of
+        // atca_command_sched()
+        atca_command_complete();
+        break;
+    }
+}
+
+/** \brief Starts a command and returns at once, the command then runs from
+ *         atca_command_sched() while the I2C transfers and the execution
+ *         time go by. In a session, the wake and idle are shared as in
+ *         atca_execute_command().
+ *
+ * \param[inout] packet    As input, the packet to be sent. As output, the
+ *                         response, once the callback is called. Must stay
+ *                         valid until then.
+ * \param[in]    device    CryptoAuthentication device to send the command to.
+ * \param[in]    callback  Called from atca_command_sched() at the end.
+ * \param[in]    context   Passed to the callback.
+ *
+ * \return ATCA_SUCCESS if the command started, ATCA_FUNC_FAIL while another
+ *         one is in progress, otherwise an error code.
+ */
+ATCA_STATUS atca_start_command(ATCAPacket* packet, ATCADevice device, atca_command_cb callback, void* context)
+{
+    uint32_t execution_time;
+
+    if ((packet == NULL) || (device == NULL) || (callback == NULL))
+    {
+        return ATCA_BAD_PARAM;
+    }
+    if (atca_command_busy() == true)
+    {
+        return ATCA_FUNC_FAIL;
+    }
+
+#ifdef ATCA_NO_POLL
+    {
+        ATCA_STATUS status;
+
+        if ((status = atGetExecTime(packet->opcode, device->mCommands)) != ATCA_SUCCESS)
+        {
+            return status;
+        }
+    }
+    execution_time = device->mCommands->execution_time_msec;
+#else
+    execution_time = ATCA_POLLING_INIT_TIME_MSEC;
+#endif
+
+    atca_command.packet = packet;
+    atca_command.device = device;
+    atca_command.callback = callback;
+    atca_command.context = context;
+    atca_command.status = ATCA_SUCCESS;
+    atca_command.delay_us = execution_time * 1000;
+    atca_command.polls = ATCA_POLLING_MAX_TIME_MSEC / ATCA_POLLING_FREQUENCY_TIME_MSEC;
+    if (atca_session_expired() == true)
+    {
+        atca_session.awake = false;
+        atca_command_next(ATCA_CMD_STEP_REFRESH_IDLE);
+    }
+    else
+    {
+        atca_command_next((atca_session.awake == true) ? ATCA_CMD_STEP_SEND : ATCA_CMD_STEP_WAKE_PULSE);
+    }
+    return ATCA_SUCCESS;
+}
+
+/** \brief Runs the command started by atca_start_command() as far as it
+ *         can go without waiting. Called from the main loop.
+ */
+void atca_command_sched(void)
+{
+    ATCA_STATUS result;
+
+    while (atca_command.step != ATCA_CMD_STEP_NONE)
+    {
+        if (atca_command.started == false)
+        {
+            if (atca_command_begin_step() == false)
+            {
+                return;
+            }
+            atca_command.started = true;
+        }
+        result = ATCA_SUCCESS;
+        if (atca_command.transfer == true)
+        {
+            if (hal_i2c_transfer_done(&result) == false)
+            {
+                return;
+            }
+        }
+        else if (atca_timer_expired() == false)
+        {
+            return;
+        }
+        atca_command_end_step(result);
+    }
+}
+
+/** \brief Checks whether a command started by atca_start_command() is in progress
+ */
+bool atca_command_busy(void)
+{
+    return (atca_command.step != ATCA_CMD_STEP_NONE);
+}
+#endif
+
 /** @} */
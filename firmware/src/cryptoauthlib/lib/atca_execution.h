@@ -61,6 +61,20 @@ ATCA_STATUS atGetExecTime(uint8_t opcode, ATCACommand ca_cmd);
 #endif
 
 ATCA_STATUS atca_execute_command(ATCAPacket* packet, ATCADevice device);
+ATCA_STATUS atca_session_begin(void);
+ATCA_STATUS atca_session_end(ATCADevice device);
+
+#ifdef ATCA_HAL_I2C
+/** \brief Called by atca_command_sched() once a command started by
+ *         atca_start_command() is over, with the status atca_execute_command()
+ *         would have returned.
+ */
+typedef void (*atca_command_cb)(ATCA_STATUS status, ATCAPacket* packet, void* context);
+
+ATCA_STATUS atca_start_command(ATCAPacket* packet, ATCADevice device, atca_command_cb callback, void* context);
+void atca_command_sched(void);
+bool atca_command_busy(void);
+#endif
 
 #ifdef __cplusplus
 }
@@ -101,6 +101,10 @@ ATCA_STATUS hal_i2c_sleep(ATCAIface iface);
 ATCA_STATUS hal_i2c_release(void *hal_data);
 ATCA_STATUS hal_i2c_discover_buses(int i2c_buses[], int max_buses);
 ATCA_STATUS hal_i2c_discover_devices(int bus_num, ATCAIfaceCfg *cfg, int *found);
+// Transfers that complete in the background, for atca_start_command()
+ATCA_STATUS hal_i2c_set_speed(uint32_t speed);
+ATCA_STATUS hal_i2c_transfer_start(uint16_t address, uint8_t *data, uint16_t length, bool read);
+bool hal_i2c_transfer_done(ATCA_STATUS *status);
 #endif
 
 #ifdef ATCA_HAL_SWI
@@ -159,6 +163,10 @@ ATCA_STATUS hal_kit_hid_discover_devices(int bus_num, ATCAIfaceCfg *cfg, int *fo
 void atca_delay_us(uint32_t delay);
 void atca_delay_10us(uint32_t delay);
 void atca_delay_ms(uint32_t delay);
+ATCA_STATUS atca_timer_start_us(uint32_t delay);
+bool atca_timer_expired(void);
+uint32_t atca_timer_stamp(void);
+uint32_t atca_timer_elapsed_ms(uint32_t stamp);
 
 #ifdef __cplusplus
 }
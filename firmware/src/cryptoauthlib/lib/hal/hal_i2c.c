@@ -47,6 +47,39 @@
 #include "../atca_device.h"
 #include "../atca_status.h"
 #include "definitions.h"
+#include "i2c_bus.h"
+
+/** \brief Transfer of the blocking functions, and the one started by
+ *         hal_i2c_transfer_start(), on the bus shared with the sensor
+ */
+static i2cBusTransfer_t hal_i2c_transfer;
+static i2cBusTransfer_t hal_i2c_async_transfer;
+static uint32_t hal_i2c_async_speed = 0;
+
+static void hal_i2c_describe(i2cBusTransfer_t *transfer, uint16_t address, uint8_t *data, uint16_t length, bool read, uint32_t speed)
+{
+    transfer->address = address;
+    transfer->clkSpeed = speed;
+    transfer->writeData = (read == true) ? NULL : data;
+    transfer->writeLength = (read == true) ? 0 : length;
+    transfer->readData = (read == true) ? data : NULL;
+    transfer->readLength = (read == true) ? length : 0;
+    transfer->callback = NULL;
+}
+
+/** \brief Queue a transfer and sleep until it is over
+ * \param[in] speed  clock frequency in Hz, 0 for the bus default
+ * \return ATCA_SUCCESS, or ATCA_COMM_FAIL if it was not acknowledged
+ */
+static ATCA_STATUS hal_i2c_run(uint16_t address, uint8_t *data, uint16_t length, bool read, uint32_t speed)
+{
+    hal_i2c_describe(&hal_i2c_transfer, address, data, length, read, speed);
+    if (I2C_BUS_submit(I2C_BUS_CRYPTO, &hal_i2c_transfer) == false)
+    {
+        return ATCA_COMM_FAIL;
+    }
+    return (I2C_BUS_wait(&hal_i2c_transfer) == true) ? ATCA_SUCCESS : ATCA_COMM_FAIL;
+}
 
 
 /** \brief initialize an I2C interface using given config
@@ -55,6 +88,7 @@
  */
 ATCA_STATUS hal_i2c_init(void *hal, ATCAIfaceCfg *cfg)
 {
+    // SERCOM3 is set up by I2C_BUS_init()
 	return ATCA_SUCCESS;
 }
 
@@ -81,25 +115,7 @@ ATCA_STATUS hal_i2c_send(ATCAIface iface, uint8_t *txdata, int txlength)
 	txdata[0] = 0x03; // insert the Word Address Value, Command token
 	txlength++;       // account for word address value byte.
 
-    while (SERCOM3_I2C_IsBusy() == true);
-    
-    if (SERCOM3_I2C_Write(0x58, txdata, txlength) == true)
-    {
-        /* Wait for the I2C transfer to complete */
-        while (SERCOM3_I2C_IsBusy() == true);
-        
-        /* Transfer complete. Check if the transfer was successful */
-        if (SERCOM3_I2C_ErrorGet() != SERCOM_I2C_ERROR_NONE)
-        {
-            return ATCA_COMM_FAIL;
-        }  
-    }
-    else
-    {
-        return ATCA_COMM_FAIL;
-    }  
-	
-    return ATCA_SUCCESS;
+    return hal_i2c_run(0x58, txdata, txlength, false, 0);
 }
 
 /** \brief HAL implementation of I2C receive function for ASF I2C
@@ -123,22 +139,12 @@ ATCA_STATUS hal_i2c_receive(ATCAIface iface, uint8_t *rxdata, uint16_t *rxlength
         return ATCA_SMALL_BUFFER;
     }
     
-    /* Wait for the I2C bus to be ready */
-    while (SERCOM3_I2C_IsBusy() == true);
-
     while (retries-- > 0 && isSuccess == false)
     {
-        if (SERCOM3_I2C_Read(0x58, rxdata, 1) == true)
-        {        
-            /* Wait for the I2C transfer to complete */
-            while (SERCOM3_I2C_IsBusy() == true);
-
-            /* Transfer complete. Check if the transfer was successful */
-            if (SERCOM3_I2C_ErrorGet() == SERCOM_I2C_ERROR_NONE)
-            {
-                isSuccess = true;
-            }                   
-        }            
+        if (hal_i2c_run(0x58, rxdata, 1, true, 0) == ATCA_SUCCESS)
+        {
+            isSuccess = true;
+        }
     }
     if (isSuccess == false)
     {
@@ -156,18 +162,7 @@ ATCA_STATUS hal_i2c_receive(ATCAIface iface, uint8_t *rxdata, uint16_t *rxlength
                           
     count = rxdata[0] - 1;        
     
-    if (SERCOM3_I2C_Read(0x58, &rxdata[1], count) == true)       
-    {
-        /* Wait for the I2C transfer to complete */
-        while (SERCOM3_I2C_IsBusy() == true);
-        
-        /* Transfer complete. Check if the transfer was successful */
-        if (SERCOM3_I2C_ErrorGet() != SERCOM_I2C_ERROR_NONE)
-        {
-            return ATCA_COMM_FAIL;
-        }        
-    }    
-    else
+    if (hal_i2c_run(0x58, &rxdata[1], count, true, 0) != ATCA_SUCCESS)
     {
         return ATCA_COMM_FAIL;
     }       
@@ -183,23 +178,14 @@ ATCA_STATUS hal_i2c_receive(ATCAIface iface, uint8_t *rxdata, uint16_t *rxlength
 ATCA_STATUS hal_i2c_wake(ATCAIface iface)
 {
     SYS_TIME_HANDLE tmrHandle = SYS_TIME_HANDLE_INVALID;
-    SERCOM_I2C_TRANSFER_SETUP setup;
  
     uint8_t init_data[4] = {0,0,0,0};
 	uint8_t verif_data[4] = { 0x04, 0x11, 0x33, 0x43 };
 	uint8_t verification = true;
     uint8_t dummyData = 0x0;
-    bool isSuccess = false;
-    
-    setup.clkSpeed = 100000;
-    while (SERCOM3_I2C_IsBusy() == true);
-    
-    SERCOM3_I2C_TransferSetup(&setup, 0);   
-
-    while (SERCOM3_I2C_IsBusy() == true);
     
-    SERCOM3_I2C_Write(0, (void *)&dummyData,1);
-    while (SERCOM3_I2C_IsBusy() == true);
+    // Not acknowledged by design, SDA is held low long enough at 100 kHz
+    hal_i2c_run(0, &dummyData, 1, false, 100000);
     
     if (SYS_TIME_SUCCESS != SYS_TIME_DelayMS(5, &tmrHandle)) {
         return ATCA_COMM_FAIL;
@@ -208,37 +194,15 @@ ATCA_STATUS hal_i2c_wake(ATCAIface iface)
     while (true != SYS_TIME_DelayIsComplete(tmrHandle)) {
     }    
     
-    setup.clkSpeed = 400000;
-    while (SERCOM3_I2C_IsBusy() == true);
-    
-    SERCOM3_I2C_TransferSetup(&setup, 0);
-   
-     while (SERCOM3_I2C_IsBusy() == true);
-    
-    if (SERCOM3_I2C_Read(0x58, (void *)init_data, 4) == true)
-    {
-        /* Wait for the I2C transfer to complete */
-        while (SERCOM3_I2C_IsBusy() == true);
-
-        /* Transfer complete. Check if the transfer was successful */
-        if (SERCOM3_I2C_ErrorGet() == SERCOM_I2C_ERROR_NONE)
-        {
-            isSuccess = true;
-        } 
-    }       
-
-    if (isSuccess == true)
-    {    
-        for (uint8_t i=0; i<4; i++) {
-            if (init_data[i] != verif_data[i])
-                verification = false;
-        }
-    }
-    else
+    if (hal_i2c_run(0x58, init_data, 4, true, 0) != ATCA_SUCCESS)
     {
     	return ATCA_COMM_FAIL;
     }
-        
+
+    for (uint8_t i=0; i<4; i++) {
+        if (init_data[i] != verif_data[i])
+            verification = false;
+    }
 	
 	if (verification)
 		return ATCA_SUCCESS;
@@ -254,26 +218,7 @@ ATCA_STATUS hal_i2c_idle(ATCAIface iface)
 {
 	uint8_t data = 0x02;
   
-    /* Wait for the I2C bus to be ready */
-    while (SERCOM3_I2C_IsBusy() == true);
-    
-    if (SERCOM3_I2C_Write(0x58, (uint8_t*)&data, 1) == true)    
-    {
-        /* Wait for the I2C transfer to complete */
-        while (SERCOM3_I2C_IsBusy() == true);
-        
-        /* Transfer complete. Check if the transfer was successful */
-        if (SERCOM3_I2C_ErrorGet() != SERCOM_I2C_ERROR_NONE)
-        {
-            return ATCA_COMM_FAIL;
-        }        
-    }    
-    else
-    {
-        return ATCA_COMM_FAIL;
-    }         
-
-    return ATCA_SUCCESS;    
+    return hal_i2c_run(0x58, &data, 1, false, 0);
 }
 
 /** \brief sleep CryptoAuth device using I2C bus
@@ -284,26 +229,7 @@ ATCA_STATUS hal_i2c_sleep(ATCAIface iface)
 {
 	uint8_t data = 0x01;
 
-    /* Wait for the I2C bus to be ready */
-    while (SERCOM3_I2C_IsBusy() == true);
-    
-    if (SERCOM3_I2C_Write(0x58, (uint8_t*)&data, 1) == true)    
-    {
-        /* Wait for the I2C transfer to complete */
-        while (SERCOM3_I2C_IsBusy() == true);
-        
-        /* Transfer complete. Check if the transfer was successful */
-        if (SERCOM3_I2C_ErrorGet() != SERCOM_I2C_ERROR_NONE)
-        {
-            return ATCA_COMM_FAIL;
-        }        
-    }    
-    else
-    {
-        return ATCA_COMM_FAIL;
-    }         
-
-    return ATCA_SUCCESS;  
+    return hal_i2c_run(0x58, &data, 1, false, 0);
 }
 
 /** \brief manages reference count on given bus and releases resource if no more refences exist
@@ -348,4 +274,52 @@ ATCA_STATUS hal_i2c_discover_devices(int busNum, ATCAIfaceCfg cfg[], int *found)
     return ATCA_SUCCESS;
 }
 
+/** \brief Set the I2C clock of the transfers started by
+ *         hal_i2c_transfer_start(), the wake pulse is sent at 100 kHz
+ * \param[in] speed  clock frequency in Hz
+ * \return ATCA_SUCCESS
+ */
+ATCA_STATUS hal_i2c_set_speed(uint32_t speed)
+{
+    hal_i2c_async_speed = speed;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Queue an I2C transfer and return without waiting for it,
+ *         hal_i2c_transfer_done() tells when it is over.
+ * \param[in] address  7-bit I2C address
+ * \param[in] data     bytes to write, or space for the bytes read
+ * \param[in] length   number of bytes
+ * \param[in] read     true to read, false to write
+ * \return ATCA_SUCCESS if queued, ATCA_FUNC_FAIL while the previous one is
+ *         not over
+ */
+ATCA_STATUS hal_i2c_transfer_start(uint16_t address, uint8_t *data, uint16_t length, bool read)
+{
+    if (I2C_BUS_isPending(&hal_i2c_async_transfer) == true)
+    {
+        return ATCA_FUNC_FAIL;
+    }
+    hal_i2c_describe(&hal_i2c_async_transfer, address, data, length, read, hal_i2c_async_speed);
+    if (I2C_BUS_submit(I2C_BUS_CRYPTO, &hal_i2c_async_transfer) == false)
+    {
+        return ATCA_FUNC_FAIL;
+    }
+    return ATCA_SUCCESS;
+}
+
+/** \brief Check the transfer started by hal_i2c_transfer_start()
+ * \param[out] status  ATCA_SUCCESS, or ATCA_COMM_FAIL if it was not acknowledged
+ * \return true once it is over
+ */
+bool hal_i2c_transfer_done(ATCA_STATUS *status)
+{
+    if (I2C_BUS_isPending(&hal_i2c_async_transfer) == true)
+    {
+        return false;
+    }
+    *status = (hal_i2c_async_transfer.failed == true) ? ATCA_COMM_FAIL : ATCA_SUCCESS;
+    return true;
+}
+
 /** @} */
@@ -40,6 +40,10 @@
  */
 
 #include "definitions.h"
+#include "atca_hal.h"
+
+/** \brief Set by the SYS_TIME callback once the delay of atca_timer_start_us() is over */
+static volatile bool atca_timer_done = true;
 
 /** \defgroup hal_ Hardware abstraction layer (hal_)
  *
@@ -86,4 +90,50 @@ void atca_delay_ms(uint32_t delay)
     }
 }
 
+static void atca_timer_callback(uintptr_t context)
+{
+    atca_timer_done = true;
+}
+
+/** \brief Start a delay without waiting for it, atca_timer_expired() tells
+ *         when it is over.
+ * \param[in] delay number of microseconds to delay
+ * \return ATCA_SUCCESS, or ATCA_GEN_FAIL if no SYS_TIME timer is free
+ */
+ATCA_STATUS atca_timer_start_us(uint32_t delay)
+{
+    atca_timer_done = false;
+    if (SYS_TIME_CallbackRegisterUS(atca_timer_callback, 0, delay, SYS_TIME_SINGLE) == SYS_TIME_HANDLE_INVALID)
+    {
+        atca_timer_done = true;
+        return ATCA_GEN_FAIL;
+    }
+    return ATCA_SUCCESS;
+}
+
+/** \brief Check the delay started by atca_timer_start_us()
+ * \return true once it is over
+ */
+bool atca_timer_expired(void)
+{
+    return atca_timer_done;
+}
+
+/** \brief Take a time stamp for atca_timer_elapsed_ms()
+ * \return the system time counter
+ */
+uint32_t atca_timer_stamp(void)
+{
+    return SYS_TIME_CounterGet();
+}
+
+/** \brief Time gone by since a time stamp
+ * \param[in] stamp  returned by atca_timer_stamp()
+ * \return number of milliseconds
+ */
+uint32_t atca_timer_elapsed_ms(uint32_t stamp)
+{
+    return SYS_TIME_CountToMS(SYS_TIME_CounterGet() - stamp);
+}
+
 /** @} */
@@ -0,0 +1,93 @@
+/*
+    \file   flash_storage.c
+
+    \brief  Records kept in rows of the application flash, shared by the DNS
+            cache, the DPS assignment and the MQTT session state.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+#include <string.h>
+#include "definitions.h"
+#include "flash_storage.h"
+
+static uint32_t flashStoragePage[NVMCTRL_FLASH_PAGESIZE / sizeof(uint32_t)];
+
+static bool flashStorageWait(void)
+{
+    while (NVMCTRL_IsBusy() == true)
+    {
+    }
+    return (NVMCTRL_ErrorGet() == NVMCTRL_ERROR_NONE);
+}
+
+uint32_t FLASH_STORAGE_hash(const uint8_t *data, size_t length)
+{
+    uint32_t hash = 2166136261UL;
+
+    while (length-- > 0)
+    {
+        hash = (hash ^ *data++) * 16777619UL;
+    }
+    return hash;
+}
+
+bool FLASH_STORAGE_erase(uint32_t address, size_t length)
+{
+    size_t offset;
+
+    for (offset = 0; offset < length; offset += NVMCTRL_FLASH_ROWSIZE)
+    {
+        if ((NVMCTRL_RowErase(address + offset) == false) || (flashStorageWait() == false))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FLASH_STORAGE_writePage(const uint32_t *page, uint32_t address)
+{
+    if (NVMCTRL_PageWrite((uint32_t *)page, address) == false)
+    {
+        return false;
+    }
+    return flashStorageWait();
+}
+
+bool FLASH_STORAGE_write(uint32_t address, size_t size, const void *data, size_t length)
+{
+    size_t offset;
+    size_t chunk;
+    bool ret;
+
+    ret = FLASH_STORAGE_erase(address, size);
+    for (offset = 0; (ret == true) && (offset < length); offset += NVMCTRL_FLASH_PAGESIZE)
+    {
+        chunk = ((length - offset) > NVMCTRL_FLASH_PAGESIZE) ? NVMCTRL_FLASH_PAGESIZE : (length - offset);
+        memset(flashStoragePage, 0xFF, sizeof(flashStoragePage));
+        memcpy(flashStoragePage, (const uint8_t *)data + offset, chunk);
+        ret = FLASH_STORAGE_writePage(flashStoragePage, address + offset);
+    }
+    NVMCTRL_CacheInvalidate();
+    return ret;
+}
@@ -0,0 +1,49 @@
+/*
+    \file   flash_storage.h
+
+    \brief  Records kept in rows of the application flash.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+
+#ifndef FLASH_STORAGE_H_
+#define FLASH_STORAGE_H_
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Erasing and programming stall the CPU for several milliseconds per row:
+// records are written when they change, not on every pass.
+
+// FNV-1a, to check a record or to tag it with what it was made for
+uint32_t FLASH_STORAGE_hash(const uint8_t *data, size_t length);
+
+// Erases the rows from address, which is row aligned, over length bytes
+bool FLASH_STORAGE_erase(uint32_t address, size_t length);
+// Programs one page from a page sized buffer; the page must be erased
+bool FLASH_STORAGE_writePage(const uint32_t *page, uint32_t address);
+// Erases size bytes of rows from address, then programs the length bytes
+// of data at its start. NULL data and 0 length only erase.
+bool FLASH_STORAGE_write(uint32_t address, size_t size, const void *data, size_t length);
+
+#endif /* FLASH_STORAGE_H_ */
@@ -0,0 +1,247 @@
+/*
+    \file   i2c_bus.c
+
+    \brief  Queued transfers on the SERCOM3 I2C bus, shared by the ECC608 and
+            the MCP9808 temperature sensor.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+// The SERCOM3 interrupt ends a transfer and starts the next queued one
+// straight away, so the bus does not wait on the main loop between them.
+// Callbacks are left to I2C_BUS_sched(), as they may use the WINC driver.
+
+#include <stddef.h>
+#include "definitions.h"
+#include "i2c_bus.h"
+
+typedef struct
+{
+    i2cBusTransfer_t *head;
+    i2cBusTransfer_t *tail;
+} i2cBusQueue_t;
+
+// Shared with the interrupt: changed with interrupts off in the main loop
+static i2cBusQueue_t i2cBusQueues[I2C_BUS_CLIENTS];
+static i2cBusQueue_t i2cBusCompleted;
+static i2cBusTransfer_t *i2cBusActive = NULL;
+static uint8_t i2cBusLastClient = I2C_BUS_CLIENTS - 1;
+static uint32_t i2cBusClockSpeed = 0;
+
+static void i2cBusPush(i2cBusQueue_t *queue, i2cBusTransfer_t *transfer)
+{
+    transfer->next = NULL;
+    if (queue->tail == NULL)
+    {
+        queue->head = transfer;
+    }
+    else
+    {
+        queue->tail->next = transfer;
+    }
+    queue->tail = transfer;
+}
+
+static i2cBusTransfer_t *i2cBusPop(i2cBusQueue_t *queue)
+{
+    i2cBusTransfer_t *transfer = queue->head;
+
+    if (transfer != NULL)
+    {
+        queue->head = transfer->next;
+        if (queue->head == NULL)
+        {
+            queue->tail = NULL;
+        }
+        transfer->next = NULL;
+    }
+    return transfer;
+}
+
+static void i2cBusEnd(i2cBusTransfer_t *transfer, bool failed)
+{
+    transfer->failed = failed;
+    if (transfer->callback == NULL)
+    {
+        transfer->state = I2C_BUS_TRANSFER_DONE;
+    }
+    else
+    {
+        transfer->state = I2C_BUS_TRANSFER_COMPLETE;
+        i2cBusPush(&i2cBusCompleted, transfer);
+    }
+}
+
+// Called with interrupts off, or from the SERCOM3 interrupt
+static void i2cBusStartNext(void)
+{
+    SERCOM_I2C_TRANSFER_SETUP setup;
+    i2cBusTransfer_t *transfer;
+    uint8_t client = 0;
+    uint8_t turn;
+    bool started;
+
+    while (i2cBusActive == NULL)
+    {
+        // Round robin, starting after the client served last
+        transfer = NULL;
+        for (turn = 1; (turn <= I2C_BUS_CLIENTS) && (transfer == NULL); turn++)
+        {
+            client = (i2cBusLastClient + turn) % I2C_BUS_CLIENTS;
+            transfer = i2cBusPop(&i2cBusQueues[client]);
+        }
+        if (transfer == NULL)
+        {
+            return;
+        }
+        i2cBusLastClient = client;
+
+        setup.clkSpeed = (transfer->clkSpeed != 0) ? transfer->clkSpeed : I2C_BUS_CLOCK_SPEED;
+        if (setup.clkSpeed != i2cBusClockSpeed)
+        {
+            if (SERCOM3_I2C_TransferSetup(&setup, 0) == false)
+            {
+                i2cBusEnd(transfer, true);
+                continue;
+            }
+            i2cBusClockSpeed = setup.clkSpeed;
+        }
+
+        i2cBusActive = transfer;
+        transfer->state = I2C_BUS_TRANSFER_ACTIVE;
+        if ((transfer->writeLength != 0) && (transfer->readLength != 0))
+        {
+            started = SERCOM3_I2C_WriteRead(transfer->address, transfer->writeData, transfer->writeLength, transfer->readData, transfer->readLength);
+        }
+        else if (transfer->readLength != 0)
+        {
+            started = SERCOM3_I2C_Read(transfer->address, transfer->readData, transfer->readLength);
+        }
+        else
+        {
+            started = SERCOM3_I2C_Write(transfer->address, transfer->writeData, transfer->writeLength);
+        }
+        if (started == false)
+        {
+            i2cBusActive = NULL;
+            i2cBusEnd(transfer, true);
+        }
+    }
+}
+
+static void i2cBusInterrupt(uintptr_t context)
+{
+    i2cBusTransfer_t *transfer = i2cBusActive;
+
+    if (transfer == NULL)
+    {
+        return;
+    }
+    i2cBusActive = NULL;
+    i2cBusEnd(transfer, (SERCOM3_I2C_ErrorGet() != SERCOM_I2C_ERROR_NONE));
+    i2cBusStartNext();
+}
+
+void I2C_BUS_init(void)
+{
+    SERCOM3_I2C_CallbackRegister(i2cBusInterrupt, 0);
+}
+
+// Queues a transfer behind the ones of the same client. False if the
+// descriptor is still in use or asks for nothing.
+bool I2C_BUS_submit(i2cBusClient_t client, i2cBusTransfer_t *transfer)
+{
+    bool interruptState;
+
+    if ((client >= I2C_BUS_CLIENTS) || (transfer == NULL))
+    {
+        return false;
+    }
+    if ((transfer->writeLength == 0) && (transfer->readLength == 0))
+    {
+        return false;
+    }
+    if (transfer->state != I2C_BUS_TRANSFER_DONE)
+    {
+        return false;
+    }
+    transfer->failed = false;
+    transfer->state = I2C_BUS_TRANSFER_QUEUED;
+
+    interruptState = SYS_INT_Disable();
+    i2cBusPush(&i2cBusQueues[client], transfer);
+    i2cBusStartNext();
+    SYS_INT_Restore(interruptState);
+    return true;
+}
+
+// True while the transfer is queued or on the bus
+bool I2C_BUS_isPending(i2cBusTransfer_t *transfer)
+{
+    return ((transfer->state == I2C_BUS_TRANSFER_QUEUED) || (transfer->state == I2C_BUS_TRANSFER_ACTIVE));
+}
+
+// For the callers that cannot go on without the result: the CPU sleeps
+// until the transfer is over instead of polling the bus. Main loop only.
+bool I2C_BUS_wait(i2cBusTransfer_t *transfer)
+{
+    bool interruptState;
+
+    while (true)
+    {
+        interruptState = SYS_INT_Disable();
+        if (I2C_BUS_isPending(transfer) == false)
+        {
+            SYS_INT_Restore(interruptState);
+            break;
+        }
+        // A pending interrupt ends the sleep even with interrupts off, so
+        // the end of the transfer cannot slip in before it
+        __WFI();
+        SYS_INT_Restore(interruptState);
+    }
+    return (transfer->failed == false);
+}
+
+// Calls back the transfers over so far. Called from the main loop.
+void I2C_BUS_sched(void)
+{
+    i2cBusTransfer_t *transfer;
+    i2cBusTransfer_t *next;
+    bool interruptState;
+
+    interruptState = SYS_INT_Disable();
+    transfer = i2cBusCompleted.head;
+    i2cBusCompleted.head = NULL;
+    i2cBusCompleted.tail = NULL;
+    SYS_INT_Restore(interruptState);
+
+    while (transfer != NULL)
+    {
+        next = transfer->next;
+        transfer->next = NULL;
+        transfer->state = I2C_BUS_TRANSFER_DONE;
+        // May submit it again
+        transfer->callback(transfer);
+        transfer = next;
+    }
+}
@@ -0,0 +1,79 @@
+/*
+    \file   i2c_bus.h
+
+    \brief  Queued transfers on the SERCOM3 I2C bus.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+#ifndef I2C_BUS_H_
+#define I2C_BUS_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+// Clock of the transfers that do not ask for another one
+#define I2C_BUS_CLOCK_SPEED     400000
+
+// Devices sharing the bus, each with its own queue. The bus takes them in
+// turn, so a burst of one cannot hold back the other.
+typedef enum
+{
+    I2C_BUS_CRYPTO = 0,         // ECC608
+    I2C_BUS_SENSOR,             // MCP9808
+    I2C_BUS_CLIENTS
+} i2cBusClient_t;
+
+typedef enum
+{
+    I2C_BUS_TRANSFER_DONE = 0,
+    I2C_BUS_TRANSFER_QUEUED,
+    I2C_BUS_TRANSFER_ACTIVE,
+    I2C_BUS_TRANSFER_COMPLETE   // Over, callback not called yet
+} i2cBusTransferState_t;
+
+struct i2cBusTransfer;
+typedef void (*i2cBusCallback_t)(struct i2cBusTransfer *transfer);
+
+// The descriptor belongs to the bus from I2C_BUS_submit() until its state
+// is back to I2C_BUS_TRANSFER_DONE, and must stay valid until then
+typedef struct i2cBusTransfer
+{
+    uint16_t address;           // 7-bit address
+    uint32_t clkSpeed;          // 0 for I2C_BUS_CLOCK_SPEED
+    uint8_t *writeData;         // Written first, NULL for none
+    uint16_t writeLength;
+    uint8_t *readData;          // Then read after a repeated start, NULL for none
+    uint16_t readLength;
+    i2cBusCallback_t callback;  // Called from I2C_BUS_sched(), may be NULL
+    void *context;
+    volatile i2cBusTransferState_t state;
+    volatile bool failed;       // Not acknowledged, or bus error
+    struct i2cBusTransfer *next;
+} i2cBusTransfer_t;
+
+void I2C_BUS_init(void);
+bool I2C_BUS_submit(i2cBusClient_t client, i2cBusTransfer_t *transfer);
+bool I2C_BUS_isPending(i2cBusTransfer_t *transfer);
+bool I2C_BUS_wait(i2cBusTransfer_t *transfer);
+void I2C_BUS_sched(void);
+
+#endif /* I2C_BUS_H_ */
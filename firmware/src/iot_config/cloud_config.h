@@ -28,6 +28,16 @@
 // <id> id
 #define PROVISIONING_ID_SCOPE "0nexxxxxxx"
 
+// <o> DNS cache time to live
+// <i> Seconds a resolved host address is used before it is looked up again
+// <id> dns_cache_ttl
+#define CFG_DNS_CACHE_TTL 3600
+
+// <q> TLS session caching
+// <i> Resume the TLS session of the MQTT socket on reconnects, which saves the ECC operations of a full handshake
+// <id> tls_session_caching
+#define CFG_TLS_SESSION_CACHING 1
+
 // </h>
 
 
@@ -33,5 +33,18 @@
 #define PAYLOAD_SIZE                1024U	// Defines the payload size supported for published packets
 #define MAX_NUM_TOPICS_SUBSCRIBE	3U      // Defines number of topics supported for Subscription
 #define NUM_TOPICS_UNSUBSCRIBE	    MAX_NUM_TOPICS_SUBSCRIBE	// Client can Un-subscribe only from those topics already subscribed 
+#define MAX_NUM_PUBLISH_HANDLERS    32U     // Defines number of topic filters with a publish reception handler, not tied to the subscriptions: one subscribed filter may have many routes, e.g. one per direct method
+#define MAX_NUM_TOPIC_TRIE_NODES    64U     // Defines number of topic levels in the subscription index, at most 255
+#define MAX_NUM_INFLIGHT_PUBLISH    4U      // Defines number of QoS 1 PUBLISH packets awaiting a PUBACK
+// Every QoS 1 PUBLISH is kept until its PUBACK, so larger ones are refused
+// when created. QoS 1 is only used by CLOUD_publishData(): a telemetry topic
+// of at most 63 bytes leaves over 300 bytes of payload, which the telemetry
+// messages stay well under. The table takes 4 x 384 = 1.5 KB of the 32 KB RAM.
+#define INFLIGHT_PUBLISH_SIZE       384U    // Defines the largest QoS 1 PUBLISH packet, kept for retransmission
+#define MQTT_SESSION_ID_BLOCK       256U    // Defines how many packet identifiers are used between two saves of the session state
+#define MQTT_SESSION_STORAGE_SIZE   (2U + MAX_NUM_INFLIGHT_PUBLISH * (4U + INFLIGHT_PUBLISH_SIZE)) // Packet identifier counter and in-flight PUBLISH packets
+#define MQTT_KEEP_ALIVE_ADAPTIVE    0       // 1: stretch the PINGREQ interval while idle connections are kept open
+#define MQTT_KEEP_ALIVE_MAX         1767U   // Defines the keep-alive announced in adaptive mode, in s (the IoT Hub maximum)
+#define MQTT_KEEP_ALIVE_STEP        60U     // Defines by how much the adaptive PINGREQ interval grows, in s
 
 #endif // MQTT_CONFIG_H
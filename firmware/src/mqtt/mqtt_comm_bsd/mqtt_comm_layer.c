@@ -70,8 +70,10 @@ bool MQTT_Send(mqttContext *connectionPtr)
 {
 	bool ret = false;
 	int sendRet;
-	if((sendRet = BSD_send(*connectionPtr->tcpClientSocket, connectionPtr->mqttDataExchangeBuffers.txbuff.start, connectionPtr->mqttDataExchangeBuffers.txbuff.dataLength, 0)) > BSD_SUCCESS)
+	if((sendRet = BSD_send(*connectionPtr->tcpClientSocket, connectionPtr->mqttDataExchangeBuffers.txbuff.currentLocation, connectionPtr->mqttDataExchangeBuffers.txbuff.dataLength, 0)) > BSD_SUCCESS)
 	{
+		// Sent data is consumed; on failure it stays queued for a retry
+		MQTT_ExchangeBufferInit(&connectionPtr->mqttDataExchangeBuffers.txbuff);
 		ret = true;
 	}
 	
@@ -79,6 +81,32 @@ bool MQTT_Send(mqttContext *connectionPtr)
 	return ret;
 }
 
+bool MQTT_IsWritable(mqttContext *connectionPtr)
+{
+	int credits = BSD_GetSendCredits(*connectionPtr->tcpClientSocket);
+
+	// Room for what is queued, or for a new packet when nothing is
+	return (credits > 0) && (credits >= connectionPtr->mqttDataExchangeBuffers.txbuff.dataLength);
+}
+
+bool MQTT_HasSendCredits(mqttContext *connectionPtr, uint16_t length)
+{
+	return (BSD_GetSendCredits(*connectionPtr->tcpClientSocket) >= (int) length);
+}
+
+bool MQTT_SendData(mqttContext *connectionPtr, uint8_t *data, uint16_t length)
+{
+	int sendRet;
+
+	// A single send: the socket takes at most SOCKET_BUFFER_MAX_LENGTH bytes
+	if((sendRet = BSD_send(*connectionPtr->tcpClientSocket, data, length, 0)) <= BSD_SUCCESS)
+	{
+		debug_printError("MQTT: send failed (%d)", sendRet);
+		return false;
+	}
+	return true;
+}
+
 bool MQTT_Close(mqttContext *connectionPtr)
 {
 	bool ret = false;
@@ -89,8 +117,44 @@ bool MQTT_Close(mqttContext *connectionPtr)
 	return ret;
 }
 
+bool MQTT_Receive(mqttContext *connectionPtr)
+{
+	exchangeBuffer *rxBuffer = &connectionPtr->mqttDataExchangeBuffers.rxbuff;
+	bool ret = false;
+	uint8_t *recvSpan;
+	uint16_t recvLength;
+	int recvRet;
+
+	// Read what the socket holds straight into the free space of the Rx ring.
+	// Whatever does not fit stays in the socket until the ring is dispatched.
+	while (true)
+	{
+		recvSpan = MQTT_ExchangeBufferGetWriteSpan(rxBuffer, &recvLength);
+		if (recvLength == 0)
+		{
+			break;
+		}
+		recvRet = BSD_recv(*connectionPtr->tcpClientSocket, recvSpan, recvLength, 0);
+		if (recvRet <= 0)
+		{
+			// Nothing more for now (EWOULDBLOCK), or the connection is closed
+			break;
+		}
+		MQTT_ExchangeBufferCommit(rxBuffer, recvRet);
+		ret = true;
+	}
+	return ret;
+}
+
 void MQTT_GetReceivedData(uint8_t *pData, uint16_t len)
 {
-	MQTT_ExchangeBufferInit(&mqttConn.mqttDataExchangeBuffers.rxbuff);
-	MQTT_ExchangeBufferWrite(&mqttConn.mqttDataExchangeBuffers.rxbuff, pData, len);
+	// The data is kept by the socket until MQTT_Receive() reads it: have it 
+	// read and dispatched on the next pass of the main loop
+	MQTT_SetRunnable();
+}
+
+void MQTT_GetSendCompleted(int16_t sentLength)
+{
+	// The socket can take more data: flush whatever was queued meanwhile
+	MQTT_SetRunnable();
 }
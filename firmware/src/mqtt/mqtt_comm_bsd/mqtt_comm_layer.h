@@ -49,6 +49,15 @@ void MQTT_ClientInitialise(void);
 mqttContext* MQTT_GetClientConnectionInfo();
 
 bool MQTT_Send(mqttContext *connectionPtr);
+// Whether the socket can take the queued data (or a new packet) now; 
+// MQTT_GetSendCompleted() is called as it gets room again
+bool MQTT_IsWritable(mqttContext *connectionPtr);
+// Whether the socket takes length bytes now, without waiting
+bool MQTT_HasSendCredits(mqttContext *connectionPtr, uint16_t length);
+// Send data as is, in a single send of at most SOCKET_BUFFER_MAX_LENGTH bytes
+bool MQTT_SendData(mqttContext *connectionPtr, uint8_t *data, uint16_t length);
 bool MQTT_Close(mqttContext *connectionPtr);
+bool MQTT_Receive(mqttContext *connectionPtr);
 void MQTT_GetReceivedData(uint8_t *pData, uint16_t len);
+void MQTT_GetSendCompleted(int16_t sentLength);
 #endif /* MQTT_COMM_LAYER_H */
@@ -38,6 +38,7 @@ IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
 #include <stdbool.h>
 #include "mqtt_core.h"
 #include "../mqtt_packetTransfer_interface.h"
+#include "../mqtt_session_storage/mqtt_session_storage.h"
 #include "../../iot_config/mqtt_config.h"
 #include "../../iot_config/IoT_Sensor_Node_config.h"
 #include "../../debug_print.h"
@@ -50,6 +51,8 @@ extern pf_MQTT_CLIENT* pf_mqtt_client;
 #define MQTT_TX_PACKET_DECISION_CONSTANT    0x01
 #define KEEP_ALIVE_CALCULATION_CONSTANT     0x01
 #define CONNECT_CLEAN_SESSION_MASK          0x02
+#define MQTT_MAX_REMAINING_LENGTH_BYTES     4
+#define MQTT_PACKET_IDENTIFIER(packet)      (((uint16_t) (packet).packetIdentifierMSB << 8) | (packet).packetIdentifierLSB)
 
 
 // MQTT packet transmission flags. The creation and transmission processes of
@@ -83,8 +86,7 @@ typedef union {
       unsigned newRxSubackPacket : 1; // Indicates new SUBACK packet has been received
       unsigned newRxUnsubackPacket : 1; // Indicates new UNSUBACK packet has been received
       unsigned newRxPingrespPacket : 1; // Indicates new PINGRESP packet has been received
-      unsigned newRxPubackPacket : 1; // Indicates new PUBACK packet has been received
-      unsigned : 2; // Reserved
+      unsigned : 3; // Reserved
    };
 } newRxDataFlags;
 
@@ -101,6 +103,56 @@ typedef enum {
    SENDPINGREQ = 32,
 } mqttConnectCurrentTxSubstate;
 
+// Result of framing the data at the head of the Rx buffer. TCP delivers a
+// byte stream, so the buffer may hold a partial MQTT packet, exactly one, or
+// several back to back.
+
+typedef enum {
+   FRAME_INCOMPLETE = 0,
+   FRAME_COMPLETE,
+   FRAME_MALFORMED
+} mqttFrameStatus;
+
+// Protocol timeouts. They share a single SYS_TIME timer, armed for the one
+// that expires first.
+
+typedef enum {
+   DEADLINE_CONNACK = 0,
+   DEADLINE_PINGREQ,
+   DEADLINE_PINGRESP,
+   DEADLINE_SUBACK,
+   DEADLINE_UNSUBACK,
+   DEADLINE_PUBACK
+} mqttDeadlineType;
+
+typedef struct {
+   uint32_t expiry; // SYS_TIME counter at which the timeout occurs
+   uint16_t packetIdentifier; // Packet awaiting a response, 0 if none
+   uint8_t type; // mqttDeadlineType
+   bool active;
+} mqttDeadline;
+
+// One PUBACK timeout per in-flight PUBLISH, one for each other type
+#define MQTT_NUM_DEADLINES                  (DEADLINE_PUBACK + MAX_NUM_INFLIGHT_PUBLISH)
+
+// QoS 1 PUBLISH packet awaiting its PUBACK. The serialized packet is kept so
+// that it can be retransmitted with the DUP flag set.
+
+typedef struct {
+   uint16_t packetIdentifier; // 0 when the entry is free
+   uint16_t packetLength;
+   bool retransmitPending; // Resend at the next opportunity (reconnect or PUBACK timeout)
+   uint8_t packet[INFLIGHT_PUBLISH_SIZE];
+} mqttInflightPublish;
+
+// Outcome of trying to deliver a received PUBLISH packet as a stream.
+
+typedef enum {
+   STREAM_NOT_USED = 0,
+   STREAM_STARTED,
+   STREAM_WAIT
+} mqttStreamStatus;
+
 // Function pointer for handling QoS levels.
 typedef void (*qosLevelHandler)(uint8_t);
 
@@ -153,6 +205,9 @@ static volatile bool subackTimeoutOccured = false;
 /** \brief SUBACK packet timeout indicator. */
 static volatile bool unsubackTimeoutOccured = false;
 
+/** \brief Return code of the last CONNACK refusing the connection. */
+static connectReturnCode connackRefusal = CONN_ACCEPTED;
+
 /** \brief Store the timestamp at the last CONNACK. */
 time_t connectTime = 0;
 
@@ -174,6 +229,61 @@ static mqttCurrentState mqttState = DISCONNECTED;
 /** \brief Tx substate for the state machine inside the CONNECTED state. */
 static mqttConnectCurrentTxSubstate mqttConnectTxSubstate;
 
+/** \brief QoS 1 PUBLISH packets sent and not yet acknowledged. */
+static mqttInflightPublish inflightPublish[MAX_NUM_INFLIGHT_PUBLISH];
+
+/** \brief PUBLISH packet whose payload the application is writing in place. */
+static struct {
+   bool active;
+   uint16_t packetOffset; // Offset of the packet in the Tx buffer
+   uint8_t lengthBytes; // Bytes reserved for the remaining length
+   uint16_t variableHeaderLength;
+   uint16_t payloadCapacity; // Largest payload that can be committed
+   uint16_t packetIdentifier;
+} reservedPublish;
+
+/** \brief PUBLISH packet too large to be queued, sent from the caller's payload. */
+static struct {
+   bool active;
+   uint8_t *payload;
+   uint32_t payloadLength;
+   uint32_t payloadOffset; // Payload bytes handed to the socket so far
+} largePublish;
+
+/** \brief Last packet identifier handed out to a QoS 1 PUBLISH. */
+static uint16_t lastPacketIdentifier = 0;
+
+/** \brief Topic of the PUBLISH packet being delivered to the application. */
+static uint8_t rxPublishTopic[TOPIC_SIZE];
+
+/** \brief PUBLISH packet being streamed to the application. */
+static struct {
+   const publishReceptionHandler_t *handler; // NULL when no stream is active
+   uint32_t remainingLength; // Payload bytes not yet delivered
+} rxPublishStream;
+
+/** \brief Bytes still to be dropped from a packet larger than the Rx buffer. */
+static uint32_t rxDiscardLength = 0;
+
+/** \brief Client side state of a persistent session (cleanSession = 0). */
+static struct {
+   bool persistent; // The last CONNECT asked the server to keep the session
+   bool present; // The server resumed a session (CONNACK sessionPresent)
+   bool restored; // The saved state has been loaded since power up
+   bool dirty; // The in-flight packets changed since the last save
+   uint16_t identifierLimit; // Packet identifiers up to this one are covered by the saved state
+} mqttSession;
+
+/** \brief Keep-alive bookkeeping; the intervals are in seconds. */
+static struct {
+   uint32_t lastTxTimestamp; // SYS_TIME counter at the last packet sent
+   uint32_t lastRxTimestamp; // SYS_TIME counter at the last packet received
+   uint16_t baseInterval; // PINGREQ interval derived from the keep-alive of the application
+   uint16_t interval; // PINGREQ interval in use
+   uint16_t ceiling; // Shortest adaptive interval that lost the connection
+   bool probe; // The outstanding PINGREQ follows a full idle interval
+} mqttKeepAlive;
+
 /***********************MQTT Client variables*(END)****************************/
 
 
@@ -189,7 +299,7 @@ static mqttConnectCurrentTxSubstate mqttConnectTxSubstate;
  * @return
  *  - The number of bytes encoded
  */
-static uint8_t mqttEncodeLength(uint16_t length, uint8_t *output);
+static uint8_t mqttEncodeLength(uint32_t length, uint8_t *output);
 
 /** \brief Decode the MQTT packet length.
  *
@@ -203,6 +313,123 @@ static uint8_t mqttEncodeLength(uint16_t length, uint8_t *output);
  */
 static uint32_t mqttDecodeLength(uint8_t *encodedData);
 
+/** \brief Frame the MQTT packet at the head of the Rx buffer.
+ *
+ * This function peeks at the fixed header of the next buffered packet without
+ * consuming it and decodes the remaining length incrementally, since the
+ * length bytes themselves may not all have arrived yet.
+ *
+ * @param rxBuffer
+ * @param *packetLength Total packet length (fixed header included), or 0 if
+ * the remaining length field is still incomplete
+ *
+ * @return
+ *  - Whether the whole packet is buffered, still incomplete or malformed
+ */
+static mqttFrameStatus mqttPeekPacketFrame(exchangeBuffer *rxBuffer, uint32_t *packetLength);
+
+/** \brief Start streaming a PUBLISH packet to the application.
+ *
+ * This function is called as soon as the variable header of a PUBLISH packet
+ * is buffered. When the handler for its topic uses streaming delivery, the
+ * headers are consumed and the payload is delivered as it is received,
+ * without waiting for the complete packet.
+ *
+ * @param rxBuffer
+ * @param packetLength
+ *
+ * @return
+ *  - Whether the stream was started, is not used for this packet, or more
+ * data is needed to decide
+ */
+static mqttStreamStatus mqttStartPublishStream(exchangeBuffer *rxBuffer, uint32_t packetLength);
+
+/** \brief Save the session state to flash.
+ *
+ * The packet identifier counter and the in-flight QoS 1 PUBLISH packets are
+ * written so that a persistent session can be resumed after a reset. A block
+ * of MQTT_SESSION_ID_BLOCK packet identifiers is reserved with each save, so 
+ * that identifiers still known to the server are not handed out again.
+ */
+static void mqttSessionSave(void);
+
+/** \brief Load the session state saved for the client, once after power up.
+ */
+static void mqttSessionRestore(void);
+
+/** \brief Deliver the buffered payload of the PUBLISH packet being streamed.
+ *
+ * @param rxBuffer
+ */
+static void mqttContinuePublishStream(exchangeBuffer *rxBuffer);
+
+/** \brief Dispatch one complete MQTT packet.
+ *
+ * This function hands the packet at the head of the Rx buffer to the handler
+ * matching its type and the current state of the client.
+ *
+ * @param mqttConnectionPtr
+ */
+static void mqttProcessPacket(mqttContext *mqttConnectionPtr);
+
+/** \brief Send the content of the Tx buffer and note the time for the keep-alive.
+ *
+ * @param mqttConnectionPtr
+ *
+ * @return
+ *  - true if the packet was sent
+ */
+static bool mqttSend(mqttContext *mqttConnectionPtr);
+
+/** \brief Make room in the Tx buffer for a control packet queued behind the
+ * PUBLISH packets waiting there, flushing them first if both do not fit one
+ * send.
+ *
+ * @param mqttConnectionPtr
+ * @param packetLength Length of the control packet
+ *
+ * @return
+ *  - false if the queued packets could not be flushed
+ */
+static bool mqttMakeRoom(mqttContext *mqttConnectionPtr, uint32_t packetLength);
+
+/** \brief Time in ms since the given SYS_TIME counter value.
+ */
+static uint32_t mqttElapsedMS(uint32_t timestamp);
+
+/** \brief Start or restart a protocol timeout.
+ *
+ * A timeout is identified by its type and the identifier of the packet that
+ * awaits a response (0 for CONNACK, PINGREQ and PINGRESP).
+ *
+ * @param type
+ * @param packetIdentifier
+ * @param timeout
+ *  - in ms
+ */
+static void mqttDeadlineSet(mqttDeadlineType type, uint16_t packetIdentifier, uint32_t timeout);
+
+/** \brief Cancel a protocol timeout, if started.
+ */
+static void mqttDeadlineClear(mqttDeadlineType type, uint16_t packetIdentifier);
+
+/** \brief Arm the shared timer for the first protocol timeout to expire.
+ */
+static void mqttDeadlineArm(void);
+
+/** \brief Account for the outcome of a PINGREQ sent after a full idle interval.
+ *
+ * In adaptive mode (MQTT_KEEP_ALIVE_ADAPTIVE) a PINGRESP to such a PINGREQ 
+ * shows that the NAT mappings and the broker keep an idle connection for 
+ * that long, so the interval is stretched by MQTT_KEEP_ALIVE_STEP. A lost
+ * connection brings it back to the last interval that worked, which is then
+ * no longer exceeded.
+ *
+ * @param answered
+ *  - true if the PINGRESP was received
+ */
+static void mqttKeepAliveProbeDone(bool answered);
+
 /** \brief Send the MQTT CONNECT packet.
  *
  * This function sends the MQTT CONNECT packet using the underlying
@@ -216,10 +443,10 @@ transmission.
  */
 static bool mqttSendConnect(mqttContext *mqttConnectionPtr);
 
-/** \brief Send the MQTT PUBLISH packet.
+/** \brief Send the queued MQTT PUBLISH packets.
  *
- * This function sends the MQTT PUBLISH packet using the underlying
-TCP layer.
+ * This function sends the MQTT PUBLISH packets queued in the Tx buffer using
+the underlying TCP layer.
  *
  * @param mqttConnectionPtr
  *
@@ -229,6 +456,70 @@ transmission.
  */
 static bool mqttSendPublish(mqttContext *mqttConnectionPtr);
 
+/** \brief Queue the start of a PUBLISH packet too large to be queued whole.
+ *
+ * This function queues the headers of the PUBLISH packet serialized in
+ * txPublishPacket, with as much of the payload as fits the next send. The
+ * rest is left in the application buffer for mqttSendLargePublish().
+ *
+ * @param txBuffer
+ *
+ * @return
+ *  - false if the headers do not fit behind the queued packets
+ */
+static bool mqttQueueLargePublish(exchangeBuffer *txBuffer);
+
+/** \brief Carry on with the PUBLISH packet started by mqttQueueLargePublish().
+ *
+ * This function flushes the queued packets, then pushes the payload from
+ * the application buffer in SOCKET_BUFFER_MAX_LENGTH slices for as long as
+ * the socket has room. It returns without waiting when the socket is full:
+ * MQTT_GetSendCompleted() runs the transmission handler again, which calls
+ * it back until the payload has been sent.
+ *
+ * @param mqttConnectionPtr
+ *
+ * @return
+ *  - false if the connection had to be closed
+ */
+static bool mqttSendLargePublish(mqttContext *mqttConnectionPtr);
+
+/** \brief Allocate a packet identifier for a QoS 1 PUBLISH.
+ *
+ * This function returns the next non-zero packet identifier that is not used
+ * by an in-flight PUBLISH.
+ *
+ * @return
+ *  - The packet identifier, or 0 if the in-flight window is full
+ */
+static uint16_t mqttAllocatePacketIdentifier(void);
+
+/** \brief Track a QoS 1 PUBLISH until its PUBACK is received.
+ *
+ * This function stores a copy of the serialized PUBLISH packet in a free
+ * in-flight entry.
+ *
+ * @param packetIdentifier
+ * @param *packet
+ * @param packetLength
+ */
+static void mqttInflightAdd(uint16_t packetIdentifier, uint8_t *packet, uint32_t packetLength);
+
+/** \brief Retransmit the unacknowledged QoS 1 PUBLISH packets.
+ *
+ * This function resends, with the DUP flag set, every in-flight PUBLISH whose
+ * PUBACK timed out or which was outstanding when the connection was lost.
+ *
+ * @param mqttConnectionPtr
+ */
+static void mqttInflightRetransmit(mqttContext *mqttConnectionPtr);
+
+/** \brief Have a PUBLISH packet retransmitted, its PUBACK is overdue.
+ *
+ * @param packetIdentifier
+ */
+static void mqttInflightTimeout(uint16_t packetIdentifier);
+
 /** \brief Send the MQTT SUBSCRIBE packet.
  *
  * This function sends the MQTT SUBSCRIBE packet using the underlying
@@ -359,15 +650,13 @@ within 30s.
 //static uint32_t checkConnackTimeoutState();
 void checkConnackTimeoutState(void);
 //timerstruct_t connackTimer = {checkConnackTimeoutState, NULL};
-SYS_TIME_HANDLE checkConnackTimeoutStateHandle      = SYS_TIME_HANDLE_INVALID;
-volatile bool checkConnackTimeoutStateTmrExpired    = false;
 
-/** \brief Check whether timeout has occurred after receiving CONNACK
-or PINGRESP packet.
+/** \brief Check whether the client has been idle for the keep-alive interval.
  *
- * This function checks whether a timeout of (keepAliveTime)s has occurred after
-receiving CONNACK or PINGRESP packet, since a client is expected to send some
-packet to the broker within (keepAliveTime)s time period.
+ * This function checks whether nothing has been sent for the keep-alive 
+interval, since a client is expected to send some packet to the broker within
+(keepAliveTime)s time period. If something was sent in the meantime, the check
+is postponed until the interval has elapsed since then.
  *
  * @param none
  *
@@ -377,8 +666,6 @@ packet to the broker within (keepAliveTime)s time period.
 //static uint32_t checkPingreqTimeoutState();
 void checkPingreqTimeoutState(void);
 //timerstruct_t pingreqTimer = {checkPingreqTimeoutState, NULL};
-SYS_TIME_HANDLE checkPingreqTimeoutStateHandle      = SYS_TIME_HANDLE_INVALID;
-volatile bool checkPingreqTimeoutStateTmrExpired    = false;
 
 /** \brief Check whether timeout has occurred after sending PINGREQ
 packet.
@@ -396,8 +683,6 @@ packet.
 //static uint32_t checkPingrespTimeoutState();
 void checkPingrespTimeoutState(void);
 //timerstruct_t pingrespTimer = {checkPingrespTimeoutState, NULL};
-SYS_TIME_HANDLE checkPingrespTimeoutStateHandle     = SYS_TIME_HANDLE_INVALID;
-volatile bool checkPingrespTimeoutStateTmrExpired   = false;
 
 /** \brief Check whether timeout has occurred after sending SUBSCRIBE
 packet.
@@ -419,8 +704,6 @@ Connection by checking subackTimeoutOccured flag (MQTT RFC, section 4.8).
 //static uint32_t checkSubackTimeoutState();
 void checkSubackTimeoutState(void);
 //timerstruct_t subackTimer = {checkSubackTimeoutState, NULL};
-SYS_TIME_HANDLE checkSubackTimeoutStateHandle   = SYS_TIME_HANDLE_INVALID;	
-volatile bool checkSubackTimeoutStateTmrExpired = false;
 
 /** \brief Check whether timeout has occurred after sending UNSUBSCRIBE
 packet.
@@ -442,31 +725,29 @@ Connection by checking unsubackTimeoutOccured flag (MQTT RFC, section 4.8).
 //static uint32_t checkUnsubackTimeoutState();
 void checkUnsubackTimeoutState(void);
 //timerstruct_t unsubackTimer = {checkUnsubackTimeoutState, NULL};
-SYS_TIME_HANDLE checkUnsubackTimeoutStateHandle     = SYS_TIME_HANDLE_INVALID;
-volatile bool checkUnsubackTimeoutStateTmrExpired   = false;
+
+/** \brief Protocol timeouts of the connection. */
+static mqttDeadline mqttDeadlines[MQTT_NUM_DEADLINES];
+
+/** \brief The SYS_TIME timer shared by the protocol timeouts. */
+static SYS_TIME_HANDLE mqttDeadlineTimerHandle = SYS_TIME_HANDLE_INVALID;
+
+/** \brief SYS_TIME counter at which the shared timer expires, if armed. */
+static uint32_t mqttDeadlineTimerExpiry;
+static bool mqttDeadlineTimerArmed = false;
+static volatile bool mqttDeadlineTimerExpired = false;
+
+/** \brief Set when the MQTT engine has work to do: data was received or sent
+ * on the socket, a packet was created or a protocol timer expired.
+ */
+static volatile bool mqttRunnable = false;
 
 /**********************Local function definitions*(END)************************/
 
 /**********************Function implementations********************************/
-void checkConnackTimeoutStatecb(uintptr_t context)
-{
-    checkConnackTimeoutStateTmrExpired = true;
-}
-void checkPingreqTimeoutStatecb(uintptr_t context)
+static void mqttDeadlineTimercb(uintptr_t context)
 {
-    checkPingreqTimeoutStateTmrExpired = true;
-}
-void checkSubackTimeoutStatecb(uintptr_t context)
-{
-    checkSubackTimeoutStateTmrExpired = true;
-}
-void checkUnsubackTimeoutStatecb(uintptr_t context)
-{
-    checkUnsubackTimeoutStateTmrExpired = true;
-}
-void checkPingrespTimeoutStatecb(uintptr_t context)
-{
-    checkPingrespTimeoutStateTmrExpired = true;
+    mqttDeadlineTimerExpired = true;
 }
 
 
@@ -485,43 +766,99 @@ int32_t MQTT_getConnectionAge()
 void checkConnackTimeoutState(void)
 {
    connackTimeoutOccured = true; // Mark that timer has executed
+   MQTT_SetRunnable();
 }
 
 void checkPingreqTimeoutState(void)
 {
+   uint32_t interval = (uint32_t) mqttKeepAlive.interval * SECONDS;
+   uint32_t idle = mqttElapsedMS(mqttKeepAlive.lastTxTimestamp);
+
+   // Any packet sent in the meantime restarts the keep-alive period
+   if (idle < interval) {
+      mqttDeadlineSet(DEADLINE_PINGREQ, 0, interval - idle);
+      return;
+   }
    pingreqTimeoutOccured = true; // Mark that timer has executed
-   //return ((ntohs(txConnectPacket.connectVariableHeader.keepAliveTimer) - KEEP_ALIVE_CALCULATION_CONSTANT) * SECONDS);
-   //SYS_TIME_TimerReload(checkPingreqTimeoutStateHandle, 0, ((ntohs(txConnectPacket.connectVariableHeader.keepAliveTimer) - KEEP_ALIVE_CALCULATION_CONSTANT) * SECONDS), checkPingreqTimeoutStatecb, 0, SYS_TIME_PERIODIC);
-   checkPingreqTimeoutStateHandle = SYS_TIME_CallbackRegisterMS(checkPingreqTimeoutStatecb, 0, 
-           ((ntohs(txConnectPacket.connectVariableHeader.keepAliveTimer) - KEEP_ALIVE_CALCULATION_CONSTANT) * SECONDS),
-           SYS_TIME_SINGLE);
+   MQTT_SetRunnable();
+   mqttDeadlineSet(DEADLINE_PINGREQ, 0, interval);
 }
 
 void checkPingrespTimeoutState(void)
 {
    pingrespTimeoutOccured = true; // Mark that timer has executed
+   MQTT_SetRunnable();
 }
 
 void checkSubackTimeoutState(void) 
 {
 	subackTimeoutOccured = true; // Mark that timer has executed
+	MQTT_SetRunnable();
 }
 
 void checkUnsubackTimeoutState(void)
 {
 	unsubackTimeoutOccured = true; // Mark that timer has executed
+	MQTT_SetRunnable();
 }
 
 void MQTT_initialiseState(void){
 	mqttState = DISCONNECTED;
+	// Protocol timeouts only apply to the connection that is gone
+	memset(mqttDeadlines, 0, sizeof (mqttDeadlines));
+	pingrespTimeoutOccured = false;
+	subackTimeoutOccured = false;
+	unsubackTimeoutOccured = false;
+	// Nor is any answer still expected
+	mqttRxFlags.newRxPingrespPacket = 0;
+	mqttRxFlags.newRxSubackPacket = 0;
+	mqttRxFlags.newRxUnsubackPacket = 0;
+	// A PINGREQ left unanswered may have been dropped by the path
+	mqttKeepAliveProbeDone(false);
+	// The connection is gone: keep what the server may still expect
+	if ((mqttSession.persistent == true) && (mqttSession.dirty == true)) {
+		mqttSessionSave();
+	}
 }
 
 mqttCurrentState MQTT_GetConnectionState(void) {
    return mqttState;
 }
 
+bool MQTT_IsLargePublishPending(void) {
+   return largePublish.active;
+}
+
+bool MQTT_IsTxQueueEmpty(void) {
+   return ((MQTT_GetClientConnectionInfo()->mqttDataExchangeBuffers.txbuff.dataLength == 0)
+      && (largePublish.active == false) && (reservedPublish.active == false));
+}
+
+void MQTT_SetRunnable(void) {
+   mqttRunnable = true;
+}
+
+bool MQTT_GetSessionPresent(void) {
+   return mqttSession.present;
+}
+
+connectReturnCode MQTT_ConsumeConnackRefusal(void) {
+   connectReturnCode refusal = connackRefusal;
+
+   connackRefusal = CONN_ACCEPTED;
+   return refusal;
+}
+
+bool MQTT_ConsumeRunnable(void) {
+   bool runnable = mqttRunnable;
+
+   mqttRunnable = false;
+   return runnable;
+}
+
 bool MQTT_CreateConnectPacket(mqttConnectPacket *newConnectPacket) {
    uint16_t payloadLength = 0;
+   uint8_t connectFlags;
    memset(&txConnectPacket, 0, sizeof (txConnectPacket));
 
    // Fixed header
@@ -539,15 +876,44 @@ bool MQTT_CreateConnectPacket(mqttConnectPacket *newConnectPacket) {
    txConnectPacket.connectVariableHeader.protocolName[5] = 'T';
    txConnectPacket.connectVariableHeader.protocolLevel = 0x04;
    if ((newConnectPacket->passwordLength > 0) || (newConnectPacket->usernameLength > 0)) {
-      txConnectPacket.connectVariableHeader.connectFlagsByte.All = 0xC2;
+      connectFlags = 0xC0;
    } else {
-      txConnectPacket.connectVariableHeader.connectFlagsByte.All = 0x02;
+      connectFlags = 0x00;
    }
+   if (newConnectPacket->connectVariableHeader.connectFlagsByte.cleanSession == 1) {
+      connectFlags |= CONNECT_CLEAN_SESSION_MASK;
+   }
+   txConnectPacket.connectVariableHeader.connectFlagsByte.All = connectFlags;
    txConnectPacket.connectVariableHeader.keepAliveTimer = htons(newConnectPacket->connectVariableHeader.keepAliveTimer);
+   if (newConnectPacket->connectVariableHeader.keepAliveTimer > KEEP_ALIVE_CALCULATION_CONSTANT) {
+      mqttKeepAlive.baseInterval = newConnectPacket->connectVariableHeader.keepAliveTimer - KEEP_ALIVE_CALCULATION_CONSTANT;
+   } else {
+      mqttKeepAlive.baseInterval = newConnectPacket->connectVariableHeader.keepAliveTimer;
+   }
+#if (MQTT_KEEP_ALIVE_ADAPTIVE == 1)
+   // The broker is told the longest keep-alive, so that the client is free to
+   // stretch its PINGREQ interval up to it. What was learnt about the path is
+   // kept across reconnections.
+   if ((newConnectPacket->connectVariableHeader.keepAliveTimer != 0) && (newConnectPacket->connectVariableHeader.keepAliveTimer < MQTT_KEEP_ALIVE_MAX)) {
+      txConnectPacket.connectVariableHeader.keepAliveTimer = htons(MQTT_KEEP_ALIVE_MAX);
+   }
+   if ((mqttKeepAlive.interval < mqttKeepAlive.baseInterval) || (mqttKeepAlive.ceiling == 0)) {
+      mqttKeepAlive.interval = mqttKeepAlive.baseInterval;
+      mqttKeepAlive.ceiling = MQTT_KEEP_ALIVE_MAX;
+   }
+#else
+   mqttKeepAlive.interval = mqttKeepAlive.baseInterval;
+#endif
   
    // Payload
    txConnectPacket.clientID = newConnectPacket->clientID;
    txConnectPacket.clientIDLength = strlen((char*) txConnectPacket.clientID);
+
+   mqttSession.persistent = (txConnectPacket.connectVariableHeader.connectFlagsByte.cleanSession == 0);
+   mqttSession.present = false;
+   if (mqttSession.persistent == true) {
+      mqttSessionRestore();
+   }
    if (txConnectPacket.connectVariableHeader.connectFlagsByte.passwordFlag == 1) {
       txConnectPacket.password = newConnectPacket->password;
       txConnectPacket.passwordLength = newConnectPacket->passwordLength;
@@ -573,6 +939,7 @@ bool MQTT_CreateConnectPacket(mqttConnectPacket *newConnectPacket) {
    
    // Now mark the Connect for sending
    mqttTxFlags.newTxConnectPacket = 1;
+   MQTT_SetRunnable();
    mqttState = CONNECTING;
 
 #if CFG_DEBUG_MSG
@@ -609,13 +976,17 @@ bool MQTT_CreateConnectPacket(mqttConnectPacket *newConnectPacket) {
 }
 
 bool MQTT_CreatePublishPacket(mqttPublishPacket *newPublishPacket) {
+   exchangeBuffer *txBuffer = &MQTT_GetClientConnectionInfo()->mqttDataExchangeBuffers.txbuff;
+   uint16_t packetIdentifier = 0;
+   uint16_t packetOffset;
+   uint32_t packetLength;
    bool ret;
 
    ret = false;
 
    memset(&txPublishPacket, 0, sizeof (txPublishPacket));
 
-   if (mqttState == CONNECTED) {
+   if ((mqttState == CONNECTED) && (reservedPublish.active == false) && (largePublish.active == false)) {
       debug_printInfo("MQTT: PublishBuild");
       // Fixed header
       txPublishPacket.publishHeaderFlags.controlPacketType = PUBLISH;
@@ -630,8 +1001,6 @@ bool MQTT_CreatePublishPacket(mqttPublishPacket *newPublishPacket) {
       txPublishPacket.topic = newPublishPacket->topic;
       txPublishPacket.topicLength = strlen((char*) newPublishPacket->topic);
       if (newPublishPacket->publishHeaderFlags.qos > 0) {
-         txPublishPacket.packetIdentifierLSB = newPublishPacket->packetIdentifierLSB;
-         txPublishPacket.packetIdentifierMSB = newPublishPacket->packetIdentifierMSB;
          txPublishPacket.totalLength += sizeof (txPublishPacket.packetIdentifierLSB) + sizeof (txPublishPacket.packetIdentifierMSB);
       }
 
@@ -640,8 +1009,59 @@ bool MQTT_CreatePublishPacket(mqttPublishPacket *newPublishPacket) {
       txPublishPacket.payloadLength = newPublishPacket->payloadLength;
       txPublishPacket.totalLength += sizeof (txPublishPacket.topicLength) + txPublishPacket.topicLength + txPublishPacket.payloadLength;
       txPublishPacket.topicLength = htons(txPublishPacket.topicLength);
+      if (txPublishPacket.totalLength > MQTT_MAX_REMAINING_LENGTH) {
+         debug_printError("MQTT: PUBLISH too large (%lu)", (unsigned long) txPublishPacket.totalLength);
+         return false;
+      }
+
+      // Packets are queued back to back in the Tx buffer and flushed together
+      // by the next MQTT_TransmissionHandler() pass in a single send. Packets
+      // that cannot fit a single send follow with their payload sent in place.
+      packetLength = sizeof (txPublishPacket.publishHeaderFlags.All) + mqttEncodeLength(txPublishPacket.totalLength, txPublishPacket.remainingLength) + txPublishPacket.totalLength;
+      if ((packetLength <= MQTT_TX_COALESCE_LENGTH) && (txBuffer->dataLength + packetLength > MQTT_TX_COALESCE_LENGTH)) {
+         debug_printError("MQTT: PUBLISH queue full");
+         return false;
+      }
+      // A QoS 1 packet must fit its retransmission slot, so it never takes
+      // the large packet path below
+      if ((txPublishPacket.publishHeaderFlags.qos > 0) && (packetLength > INFLIGHT_PUBLISH_SIZE)) {
+         debug_printError("MQTT: QoS 1 PUBLISH too large (%lu)", (unsigned long) packetLength);
+         return false;
+      }
+
+      if (txPublishPacket.publishHeaderFlags.qos > 0) {
+         packetIdentifier = mqttAllocatePacketIdentifier();
+         if (packetIdentifier == 0) {
+            debug_printError("MQTT: %d PUBLISH awaiting PUBACK", MAX_NUM_INFLIGHT_PUBLISH);
+            return false;
+         }
+         txPublishPacket.packetIdentifierLSB = packetIdentifier & 0xFF;
+         txPublishPacket.packetIdentifierMSB = packetIdentifier >> 8;
+      }
+
+      if (packetLength > MQTT_TX_COALESCE_LENGTH) {
+         return mqttQueueLargePublish(txBuffer);
+      }
+
+      packetOffset = txBuffer->dataLength;
+      MQTT_ExchangeBufferWrite(txBuffer, &txPublishPacket.publishHeaderFlags.All, sizeof (txPublishPacket.publishHeaderFlags.All));
+      MQTT_ExchangeBufferWrite(txBuffer, txPublishPacket.remainingLength, mqttEncodeLength(txPublishPacket.totalLength, txPublishPacket.remainingLength));
+      MQTT_ExchangeBufferWrite(txBuffer, (uint8_t*) & txPublishPacket.topicLength, sizeof (txPublishPacket.topicLength));
+      MQTT_ExchangeBufferWrite(txBuffer, txPublishPacket.topic, ntohs(txPublishPacket.topicLength));
+      if (txPublishPacket.publishHeaderFlags.qos > 0) {
+         MQTT_ExchangeBufferWrite(txBuffer, &txPublishPacket.packetIdentifierMSB, sizeof (txPublishPacket.packetIdentifierMSB));
+         MQTT_ExchangeBufferWrite(txBuffer, &txPublishPacket.packetIdentifierLSB, sizeof (txPublishPacket.packetIdentifierLSB));
+      }
+      MQTT_ExchangeBufferWrite(txBuffer, txPublishPacket.payload, txPublishPacket.payloadLength);
+
+      if (packetIdentifier != 0) {
+         // The Tx buffer is emptied after every send, so queued data starts
+         // at the beginning of the buffer and never wraps.
+         mqttInflightAdd(packetIdentifier, txBuffer->currentLocation + packetOffset, packetLength);
+      }
 
       mqttTxFlags.newTxPublishPacket = 1;
+      MQTT_SetRunnable();
       ret = true;
    }
    return ret;
@@ -685,6 +1105,7 @@ bool MQTT_CreateSubscribePacket(mqttSubscribePacket *newSubscribePacket) {
       txSubscribePacket.totalLength += sizeof (txSubscribePacket.packetIdentifierLSB) + sizeof (txSubscribePacket.packetIdentifierMSB);
 
       mqttTxFlags.newTxSubscribePacket = 1;
+      MQTT_SetRunnable();
       ret = true;
    }
    return ret;
@@ -730,6 +1151,7 @@ bool MQTT_CreateUnsubscribePacket(mqttUnsubscribePacket *newUnsubscribePacket)
 		txUnsubscribePacket.totalLength += sizeof (txUnsubscribePacket.packetIdentifierLSB) + sizeof (txUnsubscribePacket.packetIdentifierMSB);
 
 		mqttTxFlags.newTxUnsubscribePacket = 1;
+		MQTT_SetRunnable();
 		ret = true;
 	}
 	return ret;
@@ -739,8 +1161,17 @@ bool MQTT_CreateUnsubscribePacket(mqttUnsubscribePacket *newUnsubscribePacket)
 static bool mqttSendConnect(mqttContext *mqttConnectionPtr) {
    bool ret = false;
 
+   // A new connection starts a new byte stream: drop anything left over
+   // from the previous one.
    MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff);
    MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff);
+   rxDiscardLength = 0;
+   reservedPublish.active = false;
+   largePublish.active = false;
+   if (rxPublishStream.handler != NULL) {
+      rxPublishStream.handler->mqttPublishEndCallBack(rxPublishStream.handler->mqttPublishContext, false);
+      rxPublishStream.handler = NULL;
+   }
 
    MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, (uint8_t*) & txConnectPacket.connectFixedHeaderFlags.All, sizeof (txConnectPacket.connectFixedHeaderFlags.All));
    MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, (uint8_t*) txConnectPacket.remainingLength, mqttEncodeLength(txConnectPacket.totalLength, txConnectPacket.remainingLength));
@@ -755,7 +1186,7 @@ static bool mqttSendConnect(mqttContext *mqttConnectionPtr) {
       MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, (uint8_t*) txConnectPacket.password, ntohs(txConnectPacket.passwordLength));
    }
 
-   ret = MQTT_Send(mqttConnectionPtr);
+   ret = mqttSend(mqttConnectionPtr);
    
    if (ret == true) {
       mqttTxFlags.newTxConnectPacket = 0;
@@ -766,37 +1197,330 @@ static bool mqttSendConnect(mqttContext *mqttConnectionPtr) {
 }
 
 static bool mqttSendPublish(mqttContext *mqttConnectionPtr) {
-   bool ret = false;
+   bool ret = true;
 
-   MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff);
-   MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff);
+   // Every PUBLISH queued since the last pass shares one send; the queue may
+   // already have been flushed together with a retransmission.
+   if (mqttConnectionPtr->mqttDataExchangeBuffers.txbuff.dataLength > 0) {
+      ret = mqttSend(mqttConnectionPtr);
+   }
+   if (ret == true) {
+      mqttTxFlags.newTxPublishPacket = 0;
+   }
+   return ret;
+}
+
+uint8_t* MQTT_ReservePublishPacket(mqttPublishPacket *newPublishPacket, uint16_t *payloadCapacity) {
+   exchangeBuffer *txBuffer = &MQTT_GetClientConnectionInfo()->mqttDataExchangeBuffers.txbuff;
+   uint16_t bufferSpace;
+   uint16_t capacity;
+   uint8_t lengthBytes[MQTT_MAX_REMAINING_LENGTH_BYTES];
+
+   if ((mqttState != CONNECTED) || (reservedPublish.active == true) || (largePublish.active == true)) {
+      return NULL;
+   }
+
+   memset(&txPublishPacket, 0, sizeof (txPublishPacket));
+   txPublishPacket.publishHeaderFlags.controlPacketType = PUBLISH;
+   txPublishPacket.publishHeaderFlags.qos = newPublishPacket->publishHeaderFlags.qos;
+   txPublishPacket.publishHeaderFlags.retain = newPublishPacket->publishHeaderFlags.retain;
+   txPublishPacket.topic = newPublishPacket->topic;
+   txPublishPacket.topicLength = strlen((char*) newPublishPacket->topic);
+   reservedPublish.variableHeaderLength = sizeof (txPublishPacket.topicLength) + txPublishPacket.topicLength;
+   if (txPublishPacket.publishHeaderFlags.qos > 0) {
+      reservedPublish.variableHeaderLength += sizeof (txPublishPacket.packetIdentifierLSB) + sizeof (txPublishPacket.packetIdentifierMSB);
+   }
 
-   // Copy the txPublishPacket data in TCP Tx buffer
-   MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, &txPublishPacket.publishHeaderFlags.All, sizeof (txPublishPacket.publishHeaderFlags.All));
-   MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, txPublishPacket.remainingLength, mqttEncodeLength(txPublishPacket.totalLength, txPublishPacket.remainingLength));
-   MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, (uint8_t*) & txPublishPacket.topicLength, sizeof (txPublishPacket.topicLength));
-   MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, txPublishPacket.topic, ntohs(txPublishPacket.topicLength));
-
-   if (txPublishPacket.publishHeaderFlags.qos == 1) {
-      MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, &txPublishPacket.packetIdentifierMSB, sizeof (txPublishPacket.packetIdentifierMSB));
-      MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, &txPublishPacket.packetIdentifierLSB, sizeof (txPublishPacket.packetIdentifierLSB));
-   }
-   MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, txPublishPacket.payload, txPublishPacket.payloadLength);
-
-   // Function call to TCP_Send() is abstracted
-   if (mqttTxFlags.newTxPublishPacket == 1 || txPublishPacket.publishHeaderFlags.duplicate == 1) {
-      ret = MQTT_Send(mqttConnectionPtr);
-      if (ret == true) {
-         mqttTxFlags.newTxPublishPacket = 0;
-         if (txPublishPacket.publishHeaderFlags.qos == 1) {
-            mqttRxFlags.newRxPubackPacket = 1;
+   // Room left in this flush, and in the buffer past the queued data since
+   // the payload must be contiguous
+   MQTT_ExchangeBufferGetWriteSpan(txBuffer, &bufferSpace);
+   if (bufferSpace > MQTT_TX_COALESCE_LENGTH - txBuffer->dataLength) {
+      bufferSpace = MQTT_TX_COALESCE_LENGTH - txBuffer->dataLength;
+   }
+   // A QoS 1 packet must also fit its retransmission slot
+   if ((txPublishPacket.publishHeaderFlags.qos > 0) && (bufferSpace > INFLIGHT_PUBLISH_SIZE)) {
+      bufferSpace = INFLIGHT_PUBLISH_SIZE;
+   }
+   // The remaining length is not known yet: reserve enough bytes for the
+   // largest payload that fits
+   reservedPublish.lengthBytes = mqttEncodeLength(bufferSpace, lengthBytes);
+   if (bufferSpace <= sizeof (txPublishPacket.publishHeaderFlags.All) + reservedPublish.lengthBytes + reservedPublish.variableHeaderLength) {
+      debug_printError("MQTT: PUBLISH queue full");
+      return NULL;
+   }
+   capacity = bufferSpace - sizeof (txPublishPacket.publishHeaderFlags.All) - reservedPublish.lengthBytes - reservedPublish.variableHeaderLength;
+
+   reservedPublish.packetIdentifier = 0;
+   if (txPublishPacket.publishHeaderFlags.qos > 0) {
+      reservedPublish.packetIdentifier = mqttAllocatePacketIdentifier();
+      if (reservedPublish.packetIdentifier == 0) {
+         debug_printError("MQTT: %d PUBLISH awaiting PUBACK", MAX_NUM_INFLIGHT_PUBLISH);
+         return NULL;
+      }
+      txPublishPacket.packetIdentifierLSB = reservedPublish.packetIdentifier & 0xFF;
+      txPublishPacket.packetIdentifierMSB = reservedPublish.packetIdentifier >> 8;
+   }
+
+   // The fixed header is written on commit
+   reservedPublish.packetOffset = txBuffer->dataLength;
+   MQTT_ExchangeBufferCommit(txBuffer, sizeof (txPublishPacket.publishHeaderFlags.All) + reservedPublish.lengthBytes);
+   txPublishPacket.topicLength = htons(txPublishPacket.topicLength);
+   MQTT_ExchangeBufferWrite(txBuffer, (uint8_t*) & txPublishPacket.topicLength, sizeof (txPublishPacket.topicLength));
+   MQTT_ExchangeBufferWrite(txBuffer, txPublishPacket.topic, ntohs(txPublishPacket.topicLength));
+   if (txPublishPacket.publishHeaderFlags.qos > 0) {
+      MQTT_ExchangeBufferWrite(txBuffer, &txPublishPacket.packetIdentifierMSB, sizeof (txPublishPacket.packetIdentifierMSB));
+      MQTT_ExchangeBufferWrite(txBuffer, &txPublishPacket.packetIdentifierLSB, sizeof (txPublishPacket.packetIdentifierLSB));
+   }
+
+   reservedPublish.active = true;
+   reservedPublish.payloadCapacity = capacity;
+   *payloadCapacity = capacity;
+   return MQTT_ExchangeBufferGetWriteSpan(txBuffer, &bufferSpace);
+}
+
+bool MQTT_CommitPublishPacket(uint16_t payloadLength) {
+   exchangeBuffer *txBuffer = &MQTT_GetClientConnectionInfo()->mqttDataExchangeBuffers.txbuff;
+   uint8_t *packet;
+   uint8_t lengthBytes;
+   uint8_t unusedBytes;
+
+   if (reservedPublish.active == false) {
+      return false;
+   }
+   if ((mqttState != CONNECTED) || (payloadLength > reservedPublish.payloadCapacity)) {
+      MQTT_CancelPublishPacket();
+      return false;
+   }
+   reservedPublish.active = false;
+
+   txPublishPacket.payloadLength = payloadLength;
+   txPublishPacket.totalLength = reservedPublish.variableHeaderLength + payloadLength;
+   lengthBytes = mqttEncodeLength(txPublishPacket.totalLength, txPublishPacket.remainingLength);
+
+   // Close the gap left by unused remaining length bytes by moving the
+   // packets queued ahead of this one, which keeps the payload in place
+   unusedBytes = reservedPublish.lengthBytes - lengthBytes;
+   if (unusedBytes > 0) {
+      memmove(txBuffer->currentLocation + unusedBytes, txBuffer->currentLocation, reservedPublish.packetOffset);
+      txBuffer->currentLocation += unusedBytes;
+      txBuffer->dataLength -= unusedBytes;
+   }
+
+   packet = txBuffer->currentLocation + reservedPublish.packetOffset;
+   packet[0] = txPublishPacket.publishHeaderFlags.All;
+   memcpy(&packet[1], txPublishPacket.remainingLength, lengthBytes);
+   MQTT_ExchangeBufferCommit(txBuffer, payloadLength);
+
+   if (reservedPublish.packetIdentifier != 0) {
+      mqttInflightAdd(reservedPublish.packetIdentifier, packet, sizeof (txPublishPacket.publishHeaderFlags.All) + lengthBytes + txPublishPacket.totalLength);
+   }
+   mqttTxFlags.newTxPublishPacket = 1;
+   MQTT_SetRunnable();
+   return true;
+}
+
+void MQTT_CancelPublishPacket(void) {
+   exchangeBuffer *txBuffer = &MQTT_GetClientConnectionInfo()->mqttDataExchangeBuffers.txbuff;
+
+   if (reservedPublish.active == true) {
+      if (txBuffer->dataLength > reservedPublish.packetOffset) {
+         txBuffer->dataLength = reservedPublish.packetOffset;
+      }
+      reservedPublish.active = false;
+   }
+}
+
+static bool mqttQueueLargePublish(exchangeBuffer *txBuffer) {
+   uint32_t headerLength;
+   uint16_t sliceLength;
+
+   headerLength = sizeof (txPublishPacket.publishHeaderFlags.All) + mqttEncodeLength(txPublishPacket.totalLength, txPublishPacket.remainingLength) + txPublishPacket.totalLength - txPublishPacket.payloadLength;
+   if (txBuffer->dataLength + headerLength > MQTT_TX_COALESCE_LENGTH) {
+      debug_printError("MQTT: PUBLISH queue full");
+      return false;
+   }
+
+   // Headers plus the start of the payload go out with the queued packets
+   MQTT_ExchangeBufferWrite(txBuffer, &txPublishPacket.publishHeaderFlags.All, sizeof (txPublishPacket.publishHeaderFlags.All));
+   MQTT_ExchangeBufferWrite(txBuffer, txPublishPacket.remainingLength, mqttEncodeLength(txPublishPacket.totalLength, txPublishPacket.remainingLength));
+   MQTT_ExchangeBufferWrite(txBuffer, (uint8_t*) & txPublishPacket.topicLength, sizeof (txPublishPacket.topicLength));
+   MQTT_ExchangeBufferWrite(txBuffer, txPublishPacket.topic, ntohs(txPublishPacket.topicLength));
+   if (txPublishPacket.publishHeaderFlags.qos > 0) {
+      MQTT_ExchangeBufferWrite(txBuffer, &txPublishPacket.packetIdentifierMSB, sizeof (txPublishPacket.packetIdentifierMSB));
+      MQTT_ExchangeBufferWrite(txBuffer, &txPublishPacket.packetIdentifierLSB, sizeof (txPublishPacket.packetIdentifierLSB));
+   }
+   sliceLength = MQTT_TX_COALESCE_LENGTH - txBuffer->dataLength;
+   if (sliceLength > txPublishPacket.payloadLength) {
+      sliceLength = txPublishPacket.payloadLength;
+   }
+
+   largePublish.payload = txPublishPacket.payload;
+   largePublish.payloadLength = txPublishPacket.payloadLength;
+   largePublish.payloadOffset = MQTT_ExchangeBufferWrite(txBuffer, txPublishPacket.payload, sliceLength);
+   largePublish.active = true;
+
+   mqttTxFlags.newTxPublishPacket = 1;
+   MQTT_SetRunnable();
+   return true;
+}
+
+static bool mqttSendLargePublish(mqttContext *mqttConnectionPtr) {
+   uint32_t sliceLength;
+
+   // Keep packets in order: whatever is queued, headers included, goes out first
+   if (mqttConnectionPtr->mqttDataExchangeBuffers.txbuff.dataLength > 0) {
+      if (mqttSendPublish(mqttConnectionPtr) == false) {
+         // Nothing of this packet reached the socket, try again on the next pass
+         return true;
+      }
+   }
+
+   while (largePublish.payloadOffset < largePublish.payloadLength) {
+      sliceLength = largePublish.payloadLength - largePublish.payloadOffset;
+      if (sliceLength > SOCKET_BUFFER_MAX_LENGTH) {
+         sliceLength = SOCKET_BUFFER_MAX_LENGTH;
+      }
+      if (MQTT_HasSendCredits(mqttConnectionPtr, sliceLength) == false) {
+         // Resumed from MQTT_GetSendCompleted() once WINC has sent enough
+         return true;
+      }
+      if (MQTT_SendData(mqttConnectionPtr, largePublish.payload + largePublish.payloadOffset, sliceLength) == false) {
+         // Part of the packet has been sent: the stream can no longer be resumed
+         debug_printError("MQTT: PUBLISH interrupted, closing connection");
+         largePublish.active = false;
+         mqttState = DISCONNECTED;
+         MQTT_Close(mqttConnectionPtr);
+         return false;
+      }
+      largePublish.payloadOffset += sliceLength;
+   }
+
+   // Packets held back meanwhile can go now
+   largePublish.active = false;
+   MQTT_SetRunnable();
+   return true;
+}
+
+static uint16_t mqttAllocatePacketIdentifier(void) {
+   uint8_t i;
+   uint8_t freeEntries = 0;
+   bool inUse;
+
+   for (i = 0; i < MAX_NUM_INFLIGHT_PUBLISH; i++) {
+      if (inflightPublish[i].packetIdentifier == 0) {
+         freeEntries++;
+      }
+   }
+   if (freeEntries == 0) {
+      return 0;
+   }
+
+   do {
+      lastPacketIdentifier++;
+      if (lastPacketIdentifier == 0) {
+         // Packet identifier 0 is not allowed (MQTT RFC, section 2.3.1)
+         lastPacketIdentifier = 1;
+      }
+      inUse = false;
+      for (i = 0; i < MAX_NUM_INFLIGHT_PUBLISH; i++) {
+         if (inflightPublish[i].packetIdentifier == lastPacketIdentifier) {
+            inUse = true;
+            break;
          }
       }
+   } while (inUse == true);
+
+   // Reserve the next block of identifiers before using this one
+   if ((mqttSession.persistent == true) && ((uint16_t) (lastPacketIdentifier - mqttSession.identifierLimit) < 0x8000U)) {
+      mqttSessionSave();
    }
-   return ret;
+
+   return lastPacketIdentifier;
 }
 
-static uint8_t mqttEncodeLength(uint16_t length, uint8_t *output) {
+static void mqttInflightAdd(uint16_t packetIdentifier, uint8_t *packet, uint32_t packetLength) {
+   mqttInflightPublish *entry;
+   uint8_t i;
+
+   for (i = 0; i < MAX_NUM_INFLIGHT_PUBLISH; i++) {
+      entry = &inflightPublish[i];
+      if (entry->packetIdentifier == 0) {
+         mqttSession.dirty = true;
+         entry->packetIdentifier = packetIdentifier;
+         entry->retransmitPending = false;
+         mqttDeadlineSet(DEADLINE_PUBACK, packetIdentifier, WAITFORPUBACK_TIMEOUT);
+         // Callers only queue QoS 1 packets that fit
+         memcpy(entry->packet, packet, packetLength);
+         entry->packetLength = packetLength;
+         return;
+      }
+   }
+}
+
+static void mqttInflightTimeout(uint16_t packetIdentifier) {
+   uint8_t i;
+
+   for (i = 0; i < MAX_NUM_INFLIGHT_PUBLISH; i++) {
+      if (inflightPublish[i].packetIdentifier == packetIdentifier) {
+         inflightPublish[i].retransmitPending = true;
+         MQTT_SetRunnable();
+         return;
+      }
+   }
+}
+
+static void mqttInflightRetransmit(mqttContext *mqttConnectionPtr) {
+   exchangeBuffer *txBuffer = &mqttConnectionPtr->mqttDataExchangeBuffers.txbuff;
+   bool resent[MAX_NUM_INFLIGHT_PUBLISH];
+   bool retransmit = false;
+   mqttInflightPublish *entry;
+   mqttHeaderFlags fixedHeader;
+   uint16_t queuedLength = txBuffer->dataLength;
+   uint8_t i;
+
+   for (i = 0; i < MAX_NUM_INFLIGHT_PUBLISH; i++) {
+      entry = &inflightPublish[i];
+      resent[i] = false;
+      if (entry->packetIdentifier == 0) {
+         continue;
+      }
+      if (entry->retransmitPending == false) {
+         continue;
+      }
+      if (txBuffer->dataLength + entry->packetLength > MQTT_TX_COALESCE_LENGTH) {
+         // Left for the next pass
+         continue;
+      }
+
+      // The packet copy is byte aligned: update the header through a local
+      fixedHeader.All = entry->packet[0];
+      fixedHeader.duplicate = 1;
+      entry->packet[0] = fixedHeader.All;
+      MQTT_ExchangeBufferWrite(txBuffer, entry->packet, entry->packetLength);
+      resent[i] = true;
+      retransmit = true;
+   }
+
+   if (retransmit == false) {
+      return;
+   }
+
+   // Queued PUBLISH packets, if any, go out in the same send
+   if (mqttSend(mqttConnectionPtr) == true) {
+      for (i = 0; i < MAX_NUM_INFLIGHT_PUBLISH; i++) {
+         if (resent[i] == true) {
+            debug_printInfo("MQTT: PUBLISH (%d) retransmitted", inflightPublish[i].packetIdentifier);
+            inflightPublish[i].retransmitPending = false;
+            mqttDeadlineSet(DEADLINE_PUBACK, inflightPublish[i].packetIdentifier, WAITFORPUBACK_TIMEOUT);
+         }
+      }
+   } else {
+      // Try again on the next pass
+      txBuffer->dataLength = queuedLength;
+   }
+}
+
+static uint8_t mqttEncodeLength(uint32_t length, uint8_t *output) {
    uint8_t encodedByte;
    uint8_t i = 0;
 
@@ -830,12 +1554,51 @@ static uint32_t mqttDecodeLength(uint8_t *encodedData) {
    return value;
 }
 
+static mqttFrameStatus mqttPeekPacketFrame(exchangeBuffer *rxBuffer, uint32_t *packetLength) {
+   uint8_t headerCopy[1 + MQTT_MAX_REMAINING_LENGTH_BYTES];
+   uint8_t *fixedHeader;
+   uint32_t remainingLength = 0;
+   uint32_t multiplier = 1;
+   uint16_t available;
+   uint8_t i;
+
+   *packetLength = 0;
+   // Decode in place unless the header straddles the end of the buffer
+   fixedHeader = MQTT_ExchangeBufferGetReadSpan(rxBuffer, &available);
+   if ((available < sizeof (headerCopy)) && (available < rxBuffer->dataLength)) {
+      fixedHeader = headerCopy;
+      available = MQTT_ExchangeBufferPeek(rxBuffer, headerCopy, sizeof (headerCopy));
+   } else if (available > sizeof (headerCopy)) {
+      available = sizeof (headerCopy);
+   }
+
+   for (i = 1; i < available; i++) {
+      remainingLength += (fixedHeader[i] & 0x7f) * multiplier;
+      if ((fixedHeader[i] & 0x80) == 0) {
+         // Control byte, i length bytes and the remaining length
+         *packetLength = 1 + i + remainingLength;
+         return (rxBuffer->dataLength >= *packetLength) ? FRAME_COMPLETE : FRAME_INCOMPLETE;
+      }
+      multiplier *= 0x80;
+   }
+
+   // Continuation bit still set on the last permitted length byte
+   if (available == sizeof (headerCopy)) {
+      return FRAME_MALFORMED;
+   }
+   return FRAME_INCOMPLETE;
+}
+
 
 mqttCurrentState MQTT_Disconnect(mqttContext* connectionInfo) {
    if ((mqttState == CONNECTED) || (mqttState == WAITFORCONNACK)) {
-      SYS_TIME_TimerStop(checkPingreqTimeoutStateHandle);
+      MQTT_CancelPublishPacket();
+      mqttDeadlineClear(DEADLINE_PINGREQ, 0);
       mqttSendDisconnect(connectionInfo);
       mqttState = DISCONNECTED;
+      if ((mqttSession.persistent == true) && (mqttSession.dirty == true)) {
+         mqttSessionSave();
+      }
    }
 
    return mqttState;
@@ -854,14 +1617,13 @@ static void mqttProcessPingresp(mqttContext *mqttConnectionPtr) {
    if (ntohs(txConnectPacket.connectVariableHeader.keepAliveTimer) != 0) {
       mqttTxFlags.newTxPingreqPacket = 1;
    }
-   // Re-initialise the RX exchange buffer to be able to process the
-   // next incoming MQTT packet
-   MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff);
+   mqttKeepAliveProbeDone(true);
 }
 
 static mqttCurrentState mqttProcessSuback(mqttContext *mqttConnectionPtr) {
    mqttCurrentState ret;
    mqttSubackPacket rxSubackPacket;
+   uint8_t returnCode;
    uint8_t topicNumbers = 0;
    uint8_t topicCount = 0;
 
@@ -882,7 +1644,9 @@ static mqttCurrentState mqttProcessSuback(mqttContext *mqttConnectionPtr) {
       ret = DISCONNECTED;
    } else {
       // ToDo remove hardcoding
-      MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, rxSubackPacket.returnCode, 1);
+      // A return code is one byte on the wire, not the size of the enum
+      MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &returnCode, sizeof (returnCode));
+      rxSubackPacket.returnCode[0] = returnCode;
       // ToDo This calculation needs to be modified after removing
       // hardcoding
       topicNumbers = (sizeof (rxSubackPacket.returnCode) / sizeof (rxSubackPacket.returnCode[0]));
@@ -905,9 +1669,6 @@ static mqttCurrentState mqttProcessSuback(mqttContext *mqttConnectionPtr) {
    }
 
    mqttRxFlags.newRxSubackPacket = 0;
-   // Re-initialize the RX exchange buffer to be able to process the
-   // next incoming MQTT packet
-   MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff);
 
    if (ret == CONNECTED)
    {
@@ -950,133 +1711,159 @@ static mqttCurrentState mqttProcessUnsuback(mqttContext *mqttConnectionPtr)
     }
     
 	mqttRxFlags.newRxUnsubackPacket = 0;
-	// Re-initialize the RX exchange buffer to be able to process the
-	// next incoming MQTT packet
-	MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff);
 	return ret;
 }
 
-bool matchTopicSubscribe(char* SubTopic, char* publishTopic)
-{
-    while (SubTopic != NULL && publishTopic != NULL)
-    {
-        int subTopicLen, publishTopicLen;
-        char* endSubTopic = strchr(SubTopic, '/');
-        char* endPublishTopic = strchr(publishTopic, '/');
-        if (endSubTopic == NULL && endPublishTopic == NULL)
-        {
-            return true;
-        }
+static mqttStreamStatus mqttStartPublishStream(exchangeBuffer *rxBuffer, uint32_t packetLength) {
+   uint8_t header[1 + MQTT_MAX_REMAINING_LENGTH_BYTES + 2];
+   const publishReceptionHandler_t *handler;
+   mqttHeaderFlags fixedHeader;
+   uint16_t headerLength;
+   uint16_t topicLength;
+   uint16_t copyLength;
+   uint32_t variableHeaderLength;
+
+   MQTT_ExchangeBufferPeek(rxBuffer, header, sizeof (header));
+   fixedHeader.All = header[0];
+   // The remaining length has already been validated by the framer
+   for (headerLength = 1; header[headerLength] & 0x80; headerLength++) {
+   }
+   headerLength++;
 
-        if (endSubTopic == NULL)
-        {
-            subTopicLen = strlen(SubTopic);
-        }
-        else
-        {
-            subTopicLen = endSubTopic - SubTopic;
-        }
+   if (rxBuffer->dataLength < headerLength + sizeof (topicLength)) {
+      return STREAM_WAIT;
+   }
+   topicLength = ((uint16_t) header[headerLength] << 8) | header[headerLength + 1];
+   variableHeaderLength = sizeof (topicLength) + topicLength + ((fixedHeader.qos > 0) ? 2 : 0);
+   if ((packetLength < headerLength + variableHeaderLength) || (headerLength + variableHeaderLength > rxBuffer->bufferLength)) {
+      // Malformed or unusable, left to the regular path
+      return STREAM_NOT_USED;
+   }
+   if (rxBuffer->dataLength < headerLength + variableHeaderLength) {
+      return STREAM_WAIT;
+   }
 
-        if (endPublishTopic == NULL)
-        {
-            publishTopicLen = strlen(publishTopic);
-        }
-        else
-        {
-            publishTopicLen = endPublishTopic - publishTopic;
-        }
+   copyLength = (topicLength < sizeof (rxPublishTopic)) ? topicLength : (sizeof (rxPublishTopic) - 1);
+   MQTT_ExchangeBufferPeekAt(rxBuffer, headerLength + sizeof (topicLength), rxPublishTopic, copyLength);
+   rxPublishTopic[copyLength] = 0;
 
-        if (memcmp(SubTopic, "+", 1) == 0 && subTopicLen == 1)
-        {
-            // wildcard
-        }
-        else if (memcmp(SubTopic, "#", 1) == 0 && subTopicLen == 1)
-        {
-            return true; // end wild card
-        }
-        else if (memcmp(SubTopic, publishTopic, publishTopicLen) != 0 || publishTopicLen != subTopicLen)
-        {
-            break;
-        }
+   handler = MQTT_FindPublishReceptionHandler(rxPublishTopic);
+   if ((handler == NULL) || (handler->mqttPublishBeginCallBack == NULL) || (handler->mqttPublishDataCallBack == NULL) || (handler->mqttPublishEndCallBack == NULL)) {
+      return STREAM_NOT_USED;
+   }
 
-        SubTopic = endSubTopic + 1;
-        publishTopic = endPublishTopic + 1;
-    }
+   MQTT_ExchangeBufferConsume(rxBuffer, headerLength + variableHeaderLength);
+   rxPublishStream.handler = handler;
+   rxPublishStream.remainingLength = packetLength - headerLength - variableHeaderLength;
+   handler->mqttPublishBeginCallBack(handler->mqttPublishContext, rxPublishTopic, rxPublishStream.remainingLength);
+   mqttContinuePublishStream(rxBuffer);
+   return STREAM_STARTED;
+}
+
+static void mqttContinuePublishStream(exchangeBuffer *rxBuffer) {
+   const publishReceptionHandler_t *handler = rxPublishStream.handler;
+   uint16_t chunkLength;
+   uint8_t *chunk;
+
+   // Deliver up to the end of the buffer; wrapped data follows in the next call
+   chunk = MQTT_ExchangeBufferGetReadSpan(rxBuffer, &chunkLength);
+   if (chunkLength > rxPublishStream.remainingLength) {
+      chunkLength = rxPublishStream.remainingLength;
+   }
+   if (chunkLength > 0) {
+      handler->mqttPublishDataCallBack(handler->mqttPublishContext, chunk, chunkLength);
+      MQTT_ExchangeBufferConsume(rxBuffer, chunkLength);
+      rxPublishStream.remainingLength -= chunkLength;
+   }
 
-    return false;
+   if (rxPublishStream.remainingLength == 0) {
+      rxPublishStream.handler = NULL;
+      handler->mqttPublishEndCallBack(handler->mqttPublishContext, true);
+   }
 }
 
 static mqttCurrentState mqttProcessPublish(mqttContext *mqttConnectionPtr) {
-   mqttCurrentState ret;
+   exchangeBuffer *rxBuffer = &mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff;
    uint32_t decodedLength;
+   uint16_t topicLength;
+   uint16_t copyLength;
    mqttPublishPacket rxPublishPacket;
    const publishReceptionHandler_t *publishRecvHandlerInfo;
+   uint8_t terminator;
    uint8_t i;
 
-   uint8_t mqttTopic[TOPIC_SIZE];
-   uint8_t mqttPayload[PAYLOAD_SIZE];
-
-   decodedLength = 0;
-
    memset(&rxPublishPacket, 0, sizeof (rxPublishPacket));
-   memset(mqttTopic, 0, sizeof (mqttTopic));
-   memset(mqttPayload, 0, sizeof (mqttPayload));
 
    // Fixed header
-   MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &rxPublishPacket.publishHeaderFlags.All, sizeof (rxPublishPacket.publishHeaderFlags.All));
-   MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &rxPublishPacket.remainingLength[0], sizeof (rxPublishPacket.remainingLength[0]));
+   MQTT_ExchangeBufferRead(rxBuffer, &rxPublishPacket.publishHeaderFlags.All, sizeof (rxPublishPacket.publishHeaderFlags.All));
+   MQTT_ExchangeBufferRead(rxBuffer, &rxPublishPacket.remainingLength[0], sizeof (rxPublishPacket.remainingLength[0]));
    for (i = 1; (rxPublishPacket.remainingLength[i - 1] & 0x80) && (i < sizeof(rxPublishPacket.remainingLength)); i++) {
-       MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &rxPublishPacket.remainingLength[i], 1);
+       MQTT_ExchangeBufferRead(rxBuffer, &rxPublishPacket.remainingLength[i], 1);
    }
    decodedLength = mqttDecodeLength(&rxPublishPacket.remainingLength[0]);
 
    // Variable header
-   MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, (uint8_t*) & rxPublishPacket.topicLength, sizeof (rxPublishPacket.topicLength));
-   decodedLength -= sizeof (rxPublishPacket.topicLength);
-   rxPublishPacket.topic = (uint8_t*) mqttTopic;
-   MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, rxPublishPacket.topic, ntohs(rxPublishPacket.topicLength));
-   decodedLength -= ntohs(rxPublishPacket.topicLength);
-
-   // Payload
-   rxPublishPacket.payload = (uint8_t*) mqttPayload;
-   MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, rxPublishPacket.payload, decodedLength);
-
-   mqttPayload[sizeof(mqttPayload) - 1] = 0;  // make sure buffer is null terminated
-   mqttTopic[sizeof(mqttTopic) - 1] = 0;    // make sure buffer is null terminated
+   MQTT_ExchangeBufferRead(rxBuffer, (uint8_t*) & rxPublishPacket.topicLength, sizeof (rxPublishPacket.topicLength));
+   topicLength = ntohs(rxPublishPacket.topicLength);
+   if (decodedLength < sizeof (rxPublishPacket.topicLength) + topicLength + ((rxPublishPacket.publishHeaderFlags.qos > 0) ? 2 : 0)) {
+      // The rest of the packet is dropped by the caller
+      debug_printError("MQTT: malformed PUBLISH (%lu)", (unsigned long) decodedLength);
+      return CONNECTED;
+   }
+   decodedLength -= sizeof (rxPublishPacket.topicLength) + topicLength;
+   rxPublishPacket.topic = rxPublishTopic;
+   copyLength = (topicLength < sizeof (rxPublishTopic)) ? topicLength : (sizeof (rxPublishTopic) - 1);
+   MQTT_ExchangeBufferRead(rxBuffer, rxPublishPacket.topic, copyLength);
+   MQTT_ExchangeBufferConsume(rxBuffer, topicLength - copyLength);
+   rxPublishTopic[copyLength] = 0;
+
+   if (rxPublishPacket.publishHeaderFlags.qos > 0) {
+      MQTT_ExchangeBufferRead(rxBuffer, &rxPublishPacket.packetIdentifierMSB, sizeof (rxPublishPacket.packetIdentifierMSB));
+      MQTT_ExchangeBufferRead(rxBuffer, &rxPublishPacket.packetIdentifierLSB, sizeof (rxPublishPacket.packetIdentifierLSB));
+      decodedLength -= sizeof (rxPublishPacket.packetIdentifierMSB) + sizeof (rxPublishPacket.packetIdentifierLSB);
+   }
+   rxPublishPacket.payloadLength = decodedLength;
 
    // Send payload information to the application
-   publishRecvHandlerInfo = MQTT_GetPublishReceptionHandlerTable();
-   for (i = 0; i < MAX_NUM_TOPICS_SUBSCRIBE; i++) {
-       if (publishRecvHandlerInfo) {
-         if (publishRecvHandlerInfo && matchTopicSubscribe((char*)publishRecvHandlerInfo->topic, (char*)rxPublishPacket.topic)) {
-            publishRecvHandlerInfo->mqttHandlePublishDataCallBack(rxPublishPacket.topic, rxPublishPacket.payload);
-            break;
-         }
-      }
-      publishRecvHandlerInfo++;
+   publishRecvHandlerInfo = MQTT_FindPublishReceptionHandler(rxPublishPacket.topic);
+   if ((publishRecvHandlerInfo != NULL) && (publishRecvHandlerInfo->mqttHandlePublishDataCallBack != NULL)) {
+      // The whole packet is buffered: hand the payload over in place, NUL
+      // terminated for the duration of the call
+      rxPublishPacket.payload = MQTT_ExchangeBufferLinearize(rxBuffer, rxPublishPacket.payloadLength);
+      terminator = rxPublishPacket.payload[rxPublishPacket.payloadLength];
+      rxPublishPacket.payload[rxPublishPacket.payloadLength] = 0;
+      publishRecvHandlerInfo->mqttHandlePublishDataCallBack(rxPublishPacket.topic, rxPublishPacket.payload);
+      rxPublishPacket.payload[rxPublishPacket.payloadLength] = terminator;
    }
 
-   // Re-initialize the RX exchange buffer to be able to process the
-   // next incoming MQTT packet
-   MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff);
-   ret = CONNECTED;
-   return ret;
+   return CONNECTED;
 }
 
 static void mqttProcessPuback(mqttContext *mqttConnectionPtr) {
    mqttPubackPacket rxPubackPacket;
+   uint16_t packetIdentifier;
+   uint8_t i;
+
    memset(&rxPubackPacket, 0, sizeof (rxPubackPacket));
-   MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, (uint8_t*) & rxPubackPacket.pubackFixedHeader, sizeof (rxPubackPacket.pubackFixedHeader));
+   MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &rxPubackPacket.pubackFixedHeader.All, sizeof (rxPubackPacket.pubackFixedHeader.All));
    MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &rxPubackPacket.remainingLength, sizeof (rxPubackPacket.remainingLength));
    MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &rxPubackPacket.packetIdentifierMSB, sizeof (rxPubackPacket.packetIdentifierMSB));
    MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &rxPubackPacket.packetIdentifierLSB, sizeof (rxPubackPacket.packetIdentifierLSB));
-   if (rxPubackPacket.packetIdentifierLSB == txPublishPacket.packetIdentifierLSB && rxPubackPacket.packetIdentifierMSB == txPublishPacket.packetIdentifierMSB) {
-      mqttRxFlags.newRxPubackPacket = 0;
+
+   // PUBACKs may arrive in any order when several PUBLISH packets are in flight
+   packetIdentifier = ((uint16_t) rxPubackPacket.packetIdentifierMSB << 8) | rxPubackPacket.packetIdentifierLSB;
+   for (i = 0; i < MAX_NUM_INFLIGHT_PUBLISH; i++) {
+      if (inflightPublish[i].packetIdentifier == packetIdentifier) {
+         inflightPublish[i].packetIdentifier = 0;
+         mqttSession.dirty = true;
+         mqttDeadlineClear(DEADLINE_PUBACK, packetIdentifier);
+         return;
+      }
    }
+   debug_printInfo("MQTT: PUBACK for unknown packet (%d)", packetIdentifier);
 }
 
 mqttCurrentState MQTT_TransmissionHandler(mqttContext *mqttConnectionPtr) {
-   uint16_t keepAliveTimeout = 0;
    bool packetSent = false;
    uint8_t getSetFlag = 0;
 
@@ -1089,13 +1876,29 @@ mqttCurrentState MQTT_TransmissionHandler(mqttContext *mqttConnectionPtr) {
          if (packetSent == true) {
             // The timeout API names are different in MCC foundation
             // services timeout driver and START timeout driver
-            checkConnackTimeoutStateHandle = SYS_TIME_CallbackRegisterMS(checkConnackTimeoutStatecb, 0, WAITFORCONNACK_TIMEOUT, SYS_TIME_SINGLE);
+            mqttDeadlineSet(DEADLINE_CONNACK, 0, WAITFORCONNACK_TIMEOUT);
             mqttState = WAITFORCONNACK;
             connackTimeoutOccured = false;
          }
          break;
 
       case CONNECTED:
+         if (reservedPublish.active == true) {
+            // A PUBLISH is being written in place in the Tx buffer
+            break;
+         }
+         if (MQTT_IsWritable(mqttConnectionPtr) == false) {
+            // WINC still holds earlier data: packets stay queued until a
+            // send completes, which runs this handler again
+            break;
+         }
+         if (largePublish.active == true) {
+            // Nothing may come between the headers and the end of the payload
+            mqttSendLargePublish(mqttConnectionPtr);
+            break;
+         }
+         mqttInflightRetransmit(mqttConnectionPtr);
+
          // ToDo Find out ways to improve this logic
          if (mqttTxFlags.All > 0) {
             while ((mqttTxFlags.All & (MQTT_TX_PACKET_DECISION_CONSTANT << getSetFlag)) == 0) {
@@ -1112,29 +1915,13 @@ mqttCurrentState MQTT_TransmissionHandler(mqttContext *mqttConnectionPtr) {
                   }
                   break;
                case SENDPUBLISH:
-                  SYS_TIME_TimerStop(checkPingreqTimeoutStateHandle);
-                  packetSent = mqttSendPublish(mqttConnectionPtr);
-
-                     keepAliveTimeout = ntohs(txConnectPacket.connectVariableHeader.keepAliveTimer);
-                     if (txConnectPacket.connectVariableHeader.keepAliveTimer > 0) {
-                        checkPingreqTimeoutStateHandle = SYS_TIME_CallbackRegisterMS(checkPingreqTimeoutStatecb, 0, ((keepAliveTimeout - KEEP_ALIVE_CALCULATION_CONSTANT) * SECONDS), SYS_TIME_SINGLE);
-                     }
+                  mqttSendPublish(mqttConnectionPtr);
                   break;
                case SENDSUBSCRIBE:
-                  SYS_TIME_TimerStop(checkPingreqTimeoutStateHandle);
                   mqttSendSubscribe(mqttConnectionPtr);
-                  keepAliveTimeout = ntohs(txConnectPacket.connectVariableHeader.keepAliveTimer);
-				  if (txConnectPacket.connectVariableHeader.keepAliveTimer > 0) {
-                    checkPingreqTimeoutStateHandle = SYS_TIME_CallbackRegisterMS(checkPingreqTimeoutStatecb, 0, ((keepAliveTimeout - KEEP_ALIVE_CALCULATION_CONSTANT) * SECONDS), SYS_TIME_SINGLE);
-				  }
                   break;
                case SENDUNSUBSCRIBE:
-                  SYS_TIME_TimerStop(checkPingreqTimeoutStateHandle);
                   mqttSendUnsubscribe(mqttConnectionPtr);
-                  keepAliveTimeout = ntohs(txConnectPacket.connectVariableHeader.keepAliveTimer);
-                  if (txConnectPacket.connectVariableHeader.keepAliveTimer > 0) {
-                    checkPingreqTimeoutStateHandle = SYS_TIME_CallbackRegisterMS(checkPingreqTimeoutStatecb, 0, ((keepAliveTimeout - KEEP_ALIVE_CALCULATION_CONSTANT) * SECONDS), SYS_TIME_SINGLE);
-				  }
                   break;
                default:
                   break;
@@ -1148,33 +1935,20 @@ mqttCurrentState MQTT_TransmissionHandler(mqttContext *mqttConnectionPtr) {
    return mqttState;
 }
 
-mqttCurrentState MQTT_ReceptionHandler(mqttContext *mqttConnectionPtr) {
+static void mqttProcessPacket(mqttContext *mqttConnectionPtr) {
    uint16_t keepAliveTimeout;
    mqttHeaderFlags receivedPacketHeader;
 
    keepAliveTimeout = 0;
    receivedPacketHeader.All = 0;
 
-   if(pingrespTimeoutOccured == true || subackTimeoutOccured == true || unsubackTimeoutOccured == true)
-   {
-	  // This implies that expected response has not been received from  
-	  // the server in a reasonable period of time (currently set to 30s).
-	  // This is treated as a protocol violation. The client therefore
-	  // will close the Network Connection (MQTT RFC, section 4.8).
-	  mqttState = DISCONNECTED;
-      MQTT_Close(mqttConnectionPtr);
-   }
-   // If nothing to process
-   if (mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff.dataLength == 0)
-      return mqttState;
-
    switch (mqttState) {
       case WAITFORCONNACK:
          keepAliveTimeout = ntohs(txConnectPacket.connectVariableHeader.keepAliveTimer);
          if (connackTimeoutOccured == false) {
             // The timeout API names are different in MCC foundation
             // services timeout driver and START timeout driver
-            SYS_TIME_TimerStop(checkConnackTimeoutStateHandle);
+            mqttDeadlineClear(DEADLINE_CONNACK, 0);
             // Check the type of packet
             uint16_t len = MQTT_ExchangeBufferPeek(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &receivedPacketHeader.All, sizeof (receivedPacketHeader.All));
 
@@ -1182,13 +1956,17 @@ mqttCurrentState MQTT_ReceptionHandler(mqttContext *mqttConnectionPtr) {
             {
                mqttState = mqttProcessConnack(mqttConnectionPtr);
                if (mqttState == CONNECTED) {
+                  // PUBLISH packets left unacknowledged on the previous
+                  // connection are resent (MQTT RFC, section 4.4)
+                  for (uint8_t i = 0; i < MAX_NUM_INFLIGHT_PUBLISH; i++) {
+                     inflightPublish[i].retransmitPending = true;
+                  }
                   if (keepAliveTimeout != 0) {
-                     // Send a PINGREQ packet after (keepAliveTimer - KEEP_ALIVE_CALCULATION_CONSTANT)s
-                     // if keepAliveTime is non-zero
+                     // Send a PINGREQ packet once nothing has been sent for
+                     // the keep-alive interval, if keepAliveTime is non-zero
                      mqttTxFlags.newTxPingreqPacket = 1;
-                     // The timeout API names are different in MCC foundation
-                     // services timeout driver and START timeout driver
-                     checkPingreqTimeoutStateHandle = SYS_TIME_CallbackRegisterMS(checkPingreqTimeoutStatecb, 0, ((keepAliveTimeout - KEEP_ALIVE_CALCULATION_CONSTANT) * SECONDS), SYS_TIME_SINGLE);
+                     mqttKeepAlive.probe = false;
+                     mqttDeadlineSet(DEADLINE_PINGREQ, 0, (uint32_t) mqttKeepAlive.interval * SECONDS);
                   }
                     struct tm sys_time;
                     RTC_RTCCTimeGet(&sys_time);
@@ -1220,14 +1998,14 @@ mqttCurrentState MQTT_ReceptionHandler(mqttContext *mqttConnectionPtr) {
             case PINGRESP:
                // PINGRESP received
                if ((mqttRxFlags.newRxPingrespPacket == 1) && (pingrespTimeoutOccured == false)) {
-                  SYS_TIME_TimerStop(checkPingrespTimeoutStateHandle);
+                  mqttDeadlineClear(DEADLINE_PINGRESP, 0);
                   mqttProcessPingresp(mqttConnectionPtr);
                }
                break;
             case SUBACK:
                // SUBACK received
                if ((mqttRxFlags.newRxSubackPacket == 1) && (subackTimeoutOccured == false)) {
-                  SYS_TIME_TimerStop(checkSubackTimeoutStateHandle);
+                  mqttDeadlineClear(DEADLINE_SUBACK, MQTT_PACKET_IDENTIFIER(txSubscribePacket));
                   mqttState = mqttProcessSuback(mqttConnectionPtr);
                }
                break;
@@ -1235,7 +2013,7 @@ mqttCurrentState MQTT_ReceptionHandler(mqttContext *mqttConnectionPtr) {
                // UNSUBACK received
                if ((mqttRxFlags.newRxUnsubackPacket == 1) && (unsubackTimeoutOccured == false)) 
 			   {
-                   SYS_TIME_TimerStop(checkUnsubackTimeoutStateHandle);
+                   mqttDeadlineClear(DEADLINE_UNSUBACK, MQTT_PACKET_IDENTIFIER(txUnsubscribePacket));
 	               mqttState = mqttProcessUnsuback(mqttConnectionPtr);
 	           } 
                break;
@@ -1258,6 +2036,102 @@ mqttCurrentState MQTT_ReceptionHandler(mqttContext *mqttConnectionPtr) {
          debug_printError("MQTT: mqttState=%d", mqttState);
          break;
    }
+}
+
+mqttCurrentState MQTT_ReceptionHandler(mqttContext *mqttConnectionPtr) {
+   exchangeBuffer *rxBuffer = &mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff;
+   mqttFrameStatus frameStatus;
+   mqttHeaderFlags packetHeader;
+   uint32_t packetLength;
+   uint16_t bufferedLength;
+   uint16_t consumedLength;
+
+   if(pingrespTimeoutOccured == true || subackTimeoutOccured == true || unsubackTimeoutOccured == true)
+   {
+	  // This implies that expected response has not been received from  
+	  // the server in a reasonable period of time (currently set to 30s).
+	  // This is treated as a protocol violation. The client therefore
+	  // will close the Network Connection (MQTT RFC, section 4.8).
+	  if (pingrespTimeoutOccured == true) {
+	     // Handled once, so that the next connection is not closed as well
+	     mqttDeadlineClear(DEADLINE_PINGRESP, 0);
+	     pingrespTimeoutOccured = false;
+	     mqttRxFlags.newRxPingrespPacket = 0;
+	     mqttKeepAliveProbeDone(false);
+	  }
+	  // Likewise: a resumed session sends no SUBSCRIBE or UNSUBSCRIBE that
+	  // would reset them
+	  if (subackTimeoutOccured == true) {
+	     mqttDeadlineClear(DEADLINE_SUBACK, MQTT_PACKET_IDENTIFIER(txSubscribePacket));
+	     subackTimeoutOccured = false;
+	     mqttRxFlags.newRxSubackPacket = 0;
+	  }
+	  if (unsubackTimeoutOccured == true) {
+	     mqttDeadlineClear(DEADLINE_UNSUBACK, MQTT_PACKET_IDENTIFIER(txUnsubscribePacket));
+	     unsubackTimeoutOccured = false;
+	     mqttRxFlags.newRxUnsubackPacket = 0;
+	  }
+	  mqttState = DISCONNECTED;
+      MQTT_Close(mqttConnectionPtr);
+   }
+
+   // Dispatch every complete packet in the Rx buffer. A trailing partial
+   // packet stays buffered until the rest of it has been received.
+   while ((rxBuffer->dataLength > 0) && ((mqttState == WAITFORCONNACK) || (mqttState == CONNECTED))) {
+      if (rxDiscardLength > 0) {
+         rxDiscardLength -= MQTT_ExchangeBufferConsume(rxBuffer, (rxDiscardLength < rxBuffer->dataLength) ? rxDiscardLength : rxBuffer->dataLength);
+         continue;
+      }
+      if (rxPublishStream.handler != NULL) {
+         mqttContinuePublishStream(rxBuffer);
+         continue;
+      }
+
+      frameStatus = mqttPeekPacketFrame(rxBuffer, &packetLength);
+      if (frameStatus == FRAME_MALFORMED) {
+         debug_printError("MQTT: malformed remaining length");
+         mqttState = DISCONNECTED;
+         MQTT_Close(mqttConnectionPtr);
+         break;
+      }
+
+      // PUBLISH packets for streaming handlers are delivered as they arrive
+      MQTT_ExchangeBufferPeek(rxBuffer, &packetHeader.All, sizeof (packetHeader.All));
+      if ((packetLength != 0) && (mqttState == CONNECTED) && (packetHeader.controlPacketType == PUBLISH)) {
+         mqttStreamStatus streamStatus = mqttStartPublishStream(rxBuffer, packetLength);
+         if (streamStatus == STREAM_STARTED) {
+            mqttKeepAlive.lastRxTimestamp = SYS_TIME_CounterGet();
+            continue;
+         } else if (streamStatus == STREAM_WAIT) {
+            break;
+         }
+      }
+      if (frameStatus == FRAME_INCOMPLETE) {
+         if (packetLength > rxBuffer->bufferLength) {
+            // Can never be reassembled: skip it as it streams in
+            debug_printError("MQTT: Rx packet too large (%lu), dropped", (unsigned long) packetLength);
+            rxDiscardLength = packetLength;
+            continue;
+         }
+         break;
+      }
+
+      mqttKeepAlive.lastRxTimestamp = SYS_TIME_CounterGet();
+      bufferedLength = rxBuffer->dataLength;
+      mqttProcessPacket(mqttConnectionPtr);
+      consumedLength = bufferedLength - rxBuffer->dataLength;
+
+      if (consumedLength > packetLength) {
+         // The handler read past the packet boundary: stream is out of sync
+         debug_printError("MQTT: Rx stream out of sync");
+         mqttState = DISCONNECTED;
+         MQTT_Close(mqttConnectionPtr);
+         break;
+      }
+      // Drop whatever the handler left unread, e.g. unexpected packets or
+      // fields that are not processed.
+      MQTT_ExchangeBufferConsume(rxBuffer, packetLength - consumedLength);
+   }
 
    return mqttState;
 }
@@ -1266,9 +2140,12 @@ mqttCurrentState MQTT_ReceptionHandler(mqttContext *mqttConnectionPtr) {
 static bool mqttSendSubscribe(mqttContext *mqttConnectionPtr) {
    bool ret = false;
    uint8_t topicCount = 0;
+   uint16_t queuedLength;
 
-   MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff);
-   MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff);
+   if (mqttMakeRoom(mqttConnectionPtr, sizeof (txSubscribePacket.subscribeHeaderFlags.All) + mqttEncodeLength(txSubscribePacket.totalLength, txSubscribePacket.remainingLength) + txSubscribePacket.totalLength) == false) {
+      return false;
+   }
+   queuedLength = mqttConnectionPtr->mqttDataExchangeBuffers.txbuff.dataLength;
 
    // Copy the txSubscribePacket data in TCP Tx buffer
    MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, &txSubscribePacket.subscribeHeaderFlags.All, sizeof (txSubscribePacket.subscribeHeaderFlags.All));
@@ -1282,15 +2159,16 @@ static bool mqttSendSubscribe(mqttContext *mqttConnectionPtr) {
       MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, &txSubscribePacket.subscribePayload[topicCount].requestedQoS, sizeof (txSubscribePacket.subscribePayload[topicCount].requestedQoS));
    }
    
-   ret = MQTT_Send(mqttConnectionPtr);
+   ret = mqttSend(mqttConnectionPtr);
    if (ret == true) {
        mqttTxFlags.newTxSubscribePacket = 0;
        mqttRxFlags.newRxSubackPacket = 1;
 	   
-	   //The timeout API names are different in MCC foundation
-	   //services timeout driver and START timeout driver
 	   subackTimeoutOccured = false;
-       checkSubackTimeoutStateHandle = SYS_TIME_CallbackRegisterMS(checkSubackTimeoutStatecb, 0, WAITFORSUBACK_TIMEOUT, SYS_TIME_SINGLE);
+       mqttDeadlineSet(DEADLINE_SUBACK, MQTT_PACKET_IDENTIFIER(txSubscribePacket), WAITFORSUBACK_TIMEOUT);
+   } else {
+       // Written again on the next pass, the queued PUBLISH packets stay
+       mqttConnectionPtr->mqttDataExchangeBuffers.txbuff.dataLength = queuedLength;
    }
    
    return ret;
@@ -1301,9 +2179,13 @@ static bool mqttSendUnsubscribe(mqttContext *mqttConnectionPtr)
 {
     bool ret = false;
 	uint8_t topicCount = 0;
+    uint16_t queuedLength;
     
-    MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff);
-    MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff);
+    if (mqttMakeRoom(mqttConnectionPtr, sizeof(txUnsubscribePacket.unsubscribeHeaderFlags.All) + mqttEncodeLength(txUnsubscribePacket.totalLength, txUnsubscribePacket.remainingLength) + txUnsubscribePacket.totalLength) == false)
+    {
+        return false;
+    }
+    queuedLength = mqttConnectionPtr->mqttDataExchangeBuffers.txbuff.dataLength;
     
     // Copy the txUnsubscribePacket data in TCP Tx buffer
     MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, &txUnsubscribePacket.unsubscribeHeaderFlags.All, sizeof(txUnsubscribePacket.unsubscribeHeaderFlags.All));
@@ -1317,30 +2199,144 @@ static bool mqttSendUnsubscribe(mqttContext *mqttConnectionPtr)
         MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, txUnsubscribePacket.unsubscribePayload[topicCount].topic, ntohs(txUnsubscribePacket.unsubscribePayload[topicCount].topicLength));
     }
     
-        ret = MQTT_Send(mqttConnectionPtr);
+        ret = mqttSend(mqttConnectionPtr);
         if (ret == true) 
         {
             mqttTxFlags.newTxUnsubscribePacket = 0;
             mqttRxFlags.newRxUnsubackPacket = 1;
 
-        //The timeout API names are different in MCC foundation
-        //services timeout driver and START timeout driver
         unsubackTimeoutOccured = false;
-        checkUnsubackTimeoutStateHandle = SYS_TIME_CallbackRegisterMS(checkUnsubackTimeoutStatecb, 0, WAITFORUNSUBACK_TIMEOUT, SYS_TIME_SINGLE);
+        mqttDeadlineSet(DEADLINE_UNSUBACK, MQTT_PACKET_IDENTIFIER(txUnsubscribePacket), WAITFORUNSUBACK_TIMEOUT);
+        }
+        else
+        {
+            // Written again on the next pass, the queued PUBLISH packets stay
+            mqttConnectionPtr->mqttDataExchangeBuffers.txbuff.dataLength = queuedLength;
         }
     
     return ret;
 }
 
 
+static bool mqttMakeRoom(mqttContext *mqttConnectionPtr, uint32_t packetLength) {
+   if (mqttConnectionPtr->mqttDataExchangeBuffers.txbuff.dataLength + packetLength <= MQTT_TX_COALESCE_LENGTH) {
+      return true;
+   }
+   return mqttSendPublish(mqttConnectionPtr);
+}
+
+static bool mqttSend(mqttContext *mqttConnectionPtr) {
+   if (MQTT_Send(mqttConnectionPtr) == false) {
+      return false;
+   }
+   mqttKeepAlive.lastTxTimestamp = SYS_TIME_CounterGet();
+   return true;
+}
+
+static uint32_t mqttElapsedMS(uint32_t timestamp) {
+   return SYS_TIME_CountToMS(SYS_TIME_CounterGet() - timestamp);
+}
+
+static void mqttDeadlineSet(mqttDeadlineType type, uint16_t packetIdentifier, uint32_t timeout) {
+   mqttDeadline *deadline = NULL;
+   uint8_t i;
+
+   for (i = 0; i < MQTT_NUM_DEADLINES; i++) {
+      if ((mqttDeadlines[i].active == true) && (mqttDeadlines[i].type == type) && (mqttDeadlines[i].packetIdentifier == packetIdentifier)) {
+         deadline = &mqttDeadlines[i];
+         break;
+      }
+      if ((deadline == NULL) && (mqttDeadlines[i].active == false)) {
+         deadline = &mqttDeadlines[i];
+      }
+   }
+   if (deadline == NULL) {
+      debug_printError("MQTT: no room for timeout (%d)", type);
+      return;
+   }
+   deadline->type = type;
+   deadline->packetIdentifier = packetIdentifier;
+   deadline->expiry = SYS_TIME_CounterGet() + SYS_TIME_MSToCount(timeout);
+   deadline->active = true;
+   mqttDeadlineArm();
+}
+
+static void mqttDeadlineClear(mqttDeadlineType type, uint16_t packetIdentifier) {
+   uint8_t i;
+
+   // The shared timer is left as it is: if it expires first, it is simply
+   // armed again for the next timeout
+   for (i = 0; i < MQTT_NUM_DEADLINES; i++) {
+      if ((mqttDeadlines[i].active == true) && (mqttDeadlines[i].type == type) && (mqttDeadlines[i].packetIdentifier == packetIdentifier)) {
+         mqttDeadlines[i].active = false;
+      }
+   }
+}
+
+static void mqttDeadlineArm(void) {
+   uint32_t now = SYS_TIME_CounterGet();
+   uint32_t first = 0;
+   uint32_t timeout;
+   bool found = false;
+   uint8_t i;
+
+   for (i = 0; i < MQTT_NUM_DEADLINES; i++) {
+      if ((mqttDeadlines[i].active == true) && ((found == false) || ((int32_t) (mqttDeadlines[i].expiry - first) < 0))) {
+         first = mqttDeadlines[i].expiry;
+         found = true;
+      }
+   }
+   if ((found == false) || ((mqttDeadlineTimerArmed == true) && ((int32_t) (mqttDeadlineTimerExpiry - first) <= 0))) {
+      return;
+   }
+
+   // The timeout API names are different in MCC foundation
+   // services timeout driver and START timeout driver
+   SYS_TIME_TimerStop(mqttDeadlineTimerHandle);
+   timeout = ((int32_t) (first - now) > 0) ? SYS_TIME_CountToMS(first - now) : 0;
+   // Rounded up, the timer must not expire before the timeout it is armed for
+   mqttDeadlineTimerHandle = SYS_TIME_CallbackRegisterMS(mqttDeadlineTimercb, 0, timeout + 1, SYS_TIME_SINGLE);
+   if (mqttDeadlineTimerHandle == SYS_TIME_HANDLE_INVALID) {
+      debug_printError("MQTT: timeout timer not available");
+      return;
+   }
+   mqttDeadlineTimerExpiry = first;
+   mqttDeadlineTimerArmed = true;
+}
+
+static void mqttKeepAliveProbeDone(bool answered) {
+   if (mqttKeepAlive.probe == false) {
+      return;
+   }
+   mqttKeepAlive.probe = false;
+#if (MQTT_KEEP_ALIVE_ADAPTIVE == 1)
+   if (answered == true) {
+      if ((mqttKeepAlive.interval + MQTT_KEEP_ALIVE_STEP < mqttKeepAlive.ceiling) && (mqttKeepAlive.interval + MQTT_KEEP_ALIVE_STEP <= MQTT_KEEP_ALIVE_MAX - KEEP_ALIVE_CALCULATION_CONSTANT)) {
+         mqttKeepAlive.interval += MQTT_KEEP_ALIVE_STEP;
+         debug_printInfo("MQTT: keep-alive interval %us", mqttKeepAlive.interval);
+      }
+   } else if (mqttKeepAlive.interval > mqttKeepAlive.baseInterval) {
+      mqttKeepAlive.ceiling = mqttKeepAlive.interval;
+      mqttKeepAlive.interval = (mqttKeepAlive.interval - MQTT_KEEP_ALIVE_STEP > mqttKeepAlive.baseInterval) ? mqttKeepAlive.interval - MQTT_KEEP_ALIVE_STEP : mqttKeepAlive.baseInterval;
+      debug_printInfo("MQTT: keep-alive interval back to %us", mqttKeepAlive.interval);
+   }
+#else
+   (void) answered;
+#endif
+}
+
 static bool mqttSendPingreq(mqttContext *mqttConnectionPtr) {
    bool ret;
+   bool probe;
    mqttPingPacket txPingreqPacket;
+   uint16_t queuedLength;
 
    ret = false;
    memset(&txPingreqPacket, 0, sizeof (txPingreqPacket));
-   MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff);
-   MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff);
+   if (mqttMakeRoom(mqttConnectionPtr, sizeof (txPingreqPacket.pingFixedHeader.All) + sizeof (txPingreqPacket.remainingLength)) == false) {
+      return false;
+   }
+   queuedLength = mqttConnectionPtr->mqttDataExchangeBuffers.txbuff.dataLength;
 
    // Send a PINGREQ packet here
    txPingreqPacket.pingFixedHeader.controlPacketType = PINGREQ;
@@ -1352,17 +2348,19 @@ static bool mqttSendPingreq(mqttContext *mqttConnectionPtr) {
    MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, &txPingreqPacket.pingFixedHeader.All, sizeof (txPingreqPacket.pingFixedHeader.All));
    MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, &txPingreqPacket.remainingLength, sizeof (txPingreqPacket.remainingLength));
 
-   ret = MQTT_Send(mqttConnectionPtr);
+   // Only a connection idle both ways tells how long it is kept open
+   probe = (mqttElapsedMS(mqttKeepAlive.lastRxTimestamp) >= (uint32_t) mqttKeepAlive.interval * SECONDS);
+   ret = mqttSend(mqttConnectionPtr);
    if (ret == true) {
+       mqttKeepAlive.probe = probe;
        mqttTxFlags.newTxPingreqPacket = 0;
        // Expect a PINGRESP packet
        mqttRxFlags.newRxPingrespPacket = 1;
        // The client expects the server to send a PINGRESP within
        // keepAliveTimer value.
-       
-       //The timeout API names are different in MCC foundation
-       //services timeout driver and START timeout driver
-       checkPingrespTimeoutStateHandle = SYS_TIME_CallbackRegisterMS(checkPingrespTimeoutStatecb, 0, WAITFORPINGRESP_TIMEOUT, SYS_TIME_PERIODIC);
+       mqttDeadlineSet(DEADLINE_PINGRESP, 0, WAITFORPINGRESP_TIMEOUT);
+   } else {
+       mqttConnectionPtr->mqttDataExchangeBuffers.txbuff.dataLength = queuedLength;
    }
    
    return ret;
@@ -1373,8 +2371,13 @@ static bool mqttSendDisconnect(mqttContext *mqttConnectionPtr) {
    mqttDisconnectPacket txDisconnectPacket;
 
    memset(&txDisconnectPacket, 0, sizeof (txDisconnectPacket));
-   MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff);
-   MQTT_ExchangeBufferInit(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff);
+   if (largePublish.active == true) {
+      // Would land in the middle of a PUBLISH payload: the connection is
+      // closed without it
+      largePublish.active = false;
+      return false;
+   }
+   // Appended to any PUBLISH packets still queued so that they go out first
 
    txDisconnectPacket.disconnectFixedHeader.controlPacketType = DISCONNECT;
    txDisconnectPacket.disconnectFixedHeader.retain = 0;
@@ -1384,7 +2387,7 @@ static bool mqttSendDisconnect(mqttContext *mqttConnectionPtr) {
    MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, &txDisconnectPacket.disconnectFixedHeader.All, sizeof (txDisconnectPacket.disconnectFixedHeader.All));
    MQTT_ExchangeBufferWrite(&mqttConnectionPtr->mqttDataExchangeBuffers.txbuff, &txDisconnectPacket.remainingLength, sizeof (txDisconnectPacket.remainingLength));
 
-   ret = MQTT_Send(mqttConnectionPtr);
+   ret = mqttSend(mqttConnectionPtr);
 
    if (ret == true) {
       mqttTxFlags.All = 0;
@@ -1394,6 +2397,7 @@ static bool mqttSendDisconnect(mqttContext *mqttConnectionPtr) {
 
 static mqttCurrentState mqttProcessConnack(mqttContext *mqttConnectionPtr) {
    mqttConnackPacket_t mqttConnackPacket;
+   uint8_t connackReturnCode;
 
    memset(&mqttConnackPacket, 0, sizeof (mqttConnackPacket));
 
@@ -1401,39 +2405,132 @@ static mqttCurrentState mqttProcessConnack(mqttContext *mqttConnectionPtr) {
    MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &mqttConnackPacket.connackFixedHeader.All, sizeof (mqttConnackPacket.connackFixedHeader.All));
    MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &mqttConnackPacket.remainingLength, sizeof (mqttConnackPacket.remainingLength));
    MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &mqttConnackPacket.connackVariableHeader.connackAcknowledgeFlags.All, sizeof (mqttConnackPacket.connackVariableHeader.connackAcknowledgeFlags.All));
-   MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &mqttConnackPacket.connackVariableHeader.connackReturnCode, sizeof (mqttConnackPacket.connackVariableHeader.connackReturnCode));
+   // The return code is a single byte on the wire, whatever the enum size
+   MQTT_ExchangeBufferRead(&mqttConnectionPtr->mqttDataExchangeBuffers.rxbuff, &connackReturnCode, sizeof (connackReturnCode));
+   mqttConnackPacket.connackVariableHeader.connackReturnCode = (connectReturnCode) connackReturnCode;
 
    if (mqttConnackPacket.connackVariableHeader.connackReturnCode == CONN_ACCEPTED) {
+      // Only meaningful when the session was asked to be kept (MQTT RFC, section 3.2.2.2)
+      mqttSession.present = (mqttSession.persistent == true) && (mqttConnackPacket.connackVariableHeader.connackAcknowledgeFlags.connackFlagBits.sessionPresent == 1);
       return CONNECTED;
       } else {
+      connackRefusal = mqttConnackPacket.connackVariableHeader.connackReturnCode;
       return DISCONNECTED;
    }
 }
 
+static void mqttSessionSave(void) {
+   mqttInflightPublish *entry;
+   uint16_t identifierLimit = lastPacketIdentifier + MQTT_SESSION_ID_BLOCK;
+   uint16_t entryLength;
+   bool ret;
+   uint8_t i;
+
+   ret = MQTT_SessionStorageBegin(txConnectPacket.clientID);
+   ret = ret && MQTT_SessionStorageWrite((uint8_t*) & identifierLimit, sizeof (identifierLimit));
+   for (i = 0; (ret == true) && (i < MAX_NUM_INFLIGHT_PUBLISH); i++) {
+      entry = &inflightPublish[i];
+      if (entry->packetIdentifier == 0) {
+         continue;
+      }
+      entryLength = entry->packetLength;
+      ret = MQTT_SessionStorageWrite((uint8_t*) & entry->packetIdentifier, sizeof (entry->packetIdentifier));
+      ret = ret && MQTT_SessionStorageWrite((uint8_t*) & entryLength, sizeof (entryLength));
+      ret = ret && MQTT_SessionStorageWrite(entry->packet, entryLength);
+   }
+   ret = ret && MQTT_SessionStorageEnd();
+
+   if (ret == true) {
+      mqttSession.identifierLimit = identifierLimit;
+      mqttSession.dirty = false;
+   } else {
+      debug_printError("MQTT: session state not saved");
+   }
+}
+
+static void mqttSessionRestore(void) {
+   mqttInflightPublish *entry;
+   uint16_t length;
+   uint16_t offset = 0;
+   uint16_t entryLength;
+   uint8_t i = 0;
+
+   if (mqttSession.restored == true) {
+      return;
+   }
+   mqttSession.restored = true;
+   length = MQTT_SessionStorageOpen(txConnectPacket.clientID);
+   if (length < sizeof (mqttSession.identifierLimit)) {
+      return;
+   }
+   offset += MQTT_SessionStorageRead(offset, (uint8_t*) & mqttSession.identifierLimit, sizeof (mqttSession.identifierLimit));
+   lastPacketIdentifier = mqttSession.identifierLimit;
+
+   while ((offset < length) && (i < MAX_NUM_INFLIGHT_PUBLISH)) {
+      entry = &inflightPublish[i];
+      if (entry->packetIdentifier != 0) {
+         // Already in use since power up
+         i++;
+         continue;
+      }
+      offset += MQTT_SessionStorageRead(offset, (uint8_t*) & entry->packetIdentifier, sizeof (entry->packetIdentifier));
+      offset += MQTT_SessionStorageRead(offset, (uint8_t*) & entryLength, sizeof (entryLength));
+      if ((entry->packetIdentifier == 0) || (entryLength == 0) || (entryLength > sizeof (entry->packet))
+         || (MQTT_SessionStorageRead(offset, entry->packet, entryLength) != entryLength)) {
+         debug_printError("MQTT: saved session state is corrupted");
+         entry->packetIdentifier = 0;
+         break;
+      }
+      offset += entryLength;
+      entry->packetLength = entryLength;
+      // Resent once the connection is accepted
+      entry->retransmitPending = true;
+      debug_printInfo("MQTT: PUBLISH (%d) restored", entry->packetIdentifier);
+      i++;
+   }
+}
+
 void MQTT_sched(void)
 {
-    if(checkConnackTimeoutStateTmrExpired == true) {
-        checkConnackTimeoutStateTmrExpired = false;
-        checkConnackTimeoutState();
-    }
-    
-    if(checkPingreqTimeoutStateTmrExpired == true) {
-        checkPingreqTimeoutStateTmrExpired = false;
-        checkPingreqTimeoutState();
-    }
+    uint32_t now;
+    uint8_t i;
 
-    if(checkSubackTimeoutStateTmrExpired == true) {
-        checkSubackTimeoutStateTmrExpired = false;
-        checkSubackTimeoutState();
+    if(mqttDeadlineTimerExpired == false) {
+        return;
     }
+    mqttDeadlineTimerExpired = false;
+    mqttDeadlineTimerArmed = false;
 
-    if(checkUnsubackTimeoutStateTmrExpired == true) {
-        checkUnsubackTimeoutStateTmrExpired = false;
-        checkUnsubackTimeoutState();
-    }
+    now = SYS_TIME_CounterGet();
+    for (i = 0; i < MQTT_NUM_DEADLINES; i++) {
+        mqttDeadline *deadline = &mqttDeadlines[i];
 
-    if(checkPingrespTimeoutStateTmrExpired == true) {
-        checkPingrespTimeoutStateTmrExpired = false;
-        checkPingrespTimeoutState();	
+        if ((deadline->active == false) || ((int32_t) (now - deadline->expiry) < 0)) {
+            continue;
+        }
+        deadline->active = false;
+        switch (deadline->type) {
+            case DEADLINE_CONNACK:
+                checkConnackTimeoutState();
+                break;
+            case DEADLINE_PINGREQ:
+                checkPingreqTimeoutState();
+                break;
+            case DEADLINE_PINGRESP:
+                checkPingrespTimeoutState();
+                break;
+            case DEADLINE_SUBACK:
+                checkSubackTimeoutState();
+                break;
+            case DEADLINE_UNSUBACK:
+                checkUnsubackTimeoutState();
+                break;
+            case DEADLINE_PUBACK:
+                mqttInflightTimeout(deadline->packetIdentifier);
+                break;
+            default:
+                break;
+        }
     }
+    mqttDeadlineArm();
 }    
\ No newline at end of file
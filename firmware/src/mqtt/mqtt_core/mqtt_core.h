@@ -48,6 +48,13 @@
 #define WAITFORPINGRESP_TIMEOUT             (30 * SECONDS)
 #define WAITFORSUBACK_TIMEOUT				(30 * SECONDS)
 #define WAITFORUNSUBACK_TIMEOUT				(30 * SECONDS)
+#define WAITFORPUBACK_TIMEOUT				(30 * SECONDS)
+
+// Largest amount of queued packets flushed to the socket in one send
+#define MQTT_TX_COALESCE_LENGTH             SOCKET_BUFFER_MAX_LENGTH
+
+// Largest value of the 4-byte remaining length field (MQTT RFC, section 2.2.3)
+#define MQTT_MAX_REMAINING_LENGTH           268435455UL
 
 
 /*******************Timeout Driver for MQTT definitions*(END)******************/
@@ -223,10 +230,10 @@ typedef struct
     uint8_t packetIdentifierMSB;
     
     // Payload
-    uint8_t payloadLength;
+    uint32_t payloadLength;
     uint8_t *payload; 
     
-    uint16_t totalLength;
+    uint32_t totalLength;
 } mqttPublishPacket;
 
 /** \brief MQTT PUBACK packet
@@ -377,7 +384,16 @@ typedef struct
 
 int32_t MQTT_getConnectionAge(void);
 bool MQTT_CreateConnectPacket(mqttConnectPacket *newConnectPacket);
+// The payload of a packet larger than MQTT_TX_COALESCE_LENGTH is sent from
+// where it is as the socket gets room: it must stay unchanged until
+// MQTT_IsLargePublishPending() returns false
 bool MQTT_CreatePublishPacket(mqttPublishPacket *newPublishPacket);
+bool MQTT_IsLargePublishPending(void);
+// Nothing queued in the Tx buffer: MQTT_ClientInitialise() would drop it
+bool MQTT_IsTxQueueEmpty(void);
+uint8_t* MQTT_ReservePublishPacket(mqttPublishPacket *newPublishPacket, uint16_t *payloadCapacity);
+bool MQTT_CommitPublishPacket(uint16_t payloadLength);
+void MQTT_CancelPublishPacket(void);
 bool MQTT_CreateSubscribePacket(mqttSubscribePacket *newSubscribePacket);
 bool MQTT_CreateUnsubscribePacket(mqttUnsubscribePacket *newUnsubscribePacket);
 void MQTT_initialiseState(void);
@@ -388,6 +404,44 @@ mqttCurrentState MQTT_ReceptionHandler(mqttContext *mqttContextPtr);
 
 mqttCurrentState MQTT_GetConnectionState(void);
 
+/** \brief Check whether the server resumed the session of the client.
+ *
+ * Valid once CONNECTED. When true, the subscriptions of the previous 
+ * connection are still in place and need not be sent again.
+ *
+ * @return CONNACK sessionPresent flag of a connection made with cleanSession = 0
+ */
+bool MQTT_GetSessionPresent(void);
+
+/** \brief Check and clear the return code of a refused connection.
+ *
+ * A refusal is kept until it is read, the server closing the socket after
+ * its CONNACK does not hide it.
+ *
+ * @return CONNACK return code of the last refused CONNECT, CONN_ACCEPTED if none
+ */
+connectReturnCode MQTT_ConsumeConnackRefusal(void);
+
+/** \brief Mark the MQTT engine as having work to do.
+ *
+ * Called on socket events and whenever a packet is created, so that the
+ * reception and transmission handlers run on the next pass of the main loop
+ * instead of waiting for the periodic cloud task.
+ */
+void MQTT_SetRunnable(void);
+
+/** \brief Check and clear the runnable mark set by MQTT_SetRunnable().
+ *
+ * @return true if the reception and transmission handlers need to run
+ */
+bool MQTT_ConsumeRunnable(void);
+
+/** \brief Handle the protocol timeouts that expired.
+ *
+ * The CONNACK, PINGREQ, PINGRESP, SUBACK, UNSUBACK and PUBACK timeouts share a
+ * single SYS_TIME timer; this function, called from the main loop, processes 
+ * them once it has expired.
+ */
 void MQTT_sched(void);
 
 
@@ -25,6 +25,7 @@
     SOFTWARE.
 */
 
+#include <string.h>
 #include "mqtt_exchange_buffer.h"
 
 void MQTT_ExchangeBufferInit(exchangeBuffer *buffer)
@@ -33,63 +34,181 @@ void MQTT_ExchangeBufferInit(exchangeBuffer *buffer)
 	buffer->dataLength = 0;
 }
 
-uint16_t MQTT_ExchangeBufferWrite(exchangeBuffer *buffer, uint8_t *data, uint16_t length)
+uint8_t *MQTT_ExchangeBufferGetReadSpan(exchangeBuffer *buffer, uint16_t *length)
+{
+	uint16_t toEnd = buffer->bufferLength - (buffer->currentLocation - buffer->start);
+
+	*length = (buffer->dataLength < toEnd) ? buffer->dataLength : toEnd;
+	return buffer->currentLocation;
+}
+
+uint16_t MQTT_ExchangeBufferConsume(exchangeBuffer *buffer, uint16_t length)
 {
-	uint8_t *bend = buffer->start + buffer->bufferLength - 1;
-	uint8_t *dend = (buffer->currentLocation - buffer->start + buffer->dataLength) % buffer->bufferLength + buffer->start;
-    uint16_t i = 0;
+	uint16_t offset = buffer->currentLocation - buffer->start;
 
-	for (i = length; i > 0; i--) 
+	if (length > buffer->dataLength)
+	{
+		length = buffer->dataLength;
+	}
+	buffer->dataLength -= length;
+	if (buffer->dataLength == 0)
+	{
+		// Start over at the beginning so that the next data is contiguous
+		buffer->currentLocation = buffer->start;
+	}
+	else
 	{
-		if (dend > bend)
+		offset += length;
+		if (offset >= buffer->bufferLength)
 		{
-			dend = buffer->start;
+			offset -= buffer->bufferLength;
 		}
-		if (buffer->dataLength != 0 && dend == buffer->currentLocation)
+		buffer->currentLocation = buffer->start + offset;
+	}
+	return length;
+}
+
+uint8_t *MQTT_ExchangeBufferGetWriteSpan(exchangeBuffer *buffer, uint16_t *length)
+{
+	uint16_t readOffset = buffer->currentLocation - buffer->start;
+	uint16_t writeOffset = readOffset + buffer->dataLength;
+
+	if (writeOffset >= buffer->bufferLength)
+	{
+		// The data wraps: the free space lies between its two parts
+		writeOffset -= buffer->bufferLength;
+		*length = readOffset - writeOffset;
+	}
+	else
+	{
+		*length = buffer->bufferLength - writeOffset;
+	}
+	return buffer->start + writeOffset;
+}
+
+uint16_t MQTT_ExchangeBufferCommit(exchangeBuffer *buffer, uint16_t length)
+{
+	uint16_t freeLength = buffer->bufferLength - buffer->dataLength;
+
+	if (length > freeLength)
+	{
+		length = freeLength;
+	}
+	buffer->dataLength += length;
+	return length;
+}
+
+uint16_t MQTT_ExchangeBufferWrite(exchangeBuffer *buffer, uint8_t *data, uint16_t length)
+{
+	uint16_t written = 0;
+	uint16_t spanLength;
+	uint8_t *span;
+
+	// The free space is at most two spans: up to the end of the buffer and
+	// from its start
+	while (written < length)
+	{
+		span = MQTT_ExchangeBufferGetWriteSpan(buffer, &spanLength);
+		if (spanLength == 0)
 		{
 			break;
 		}
-		*dend = *data;
-		dend++;
-		data++;
-		buffer->dataLength++;
+		if (spanLength > length - written)
+		{
+			spanLength = length - written;
+		}
+		memcpy(span, data + written, spanLength);
+		written += MQTT_ExchangeBufferCommit(buffer, spanLength);
 	}
-    
-	return length; 
+
+	// Report the number of bytes actually stored so that callers can detect
+	// a full buffer instead of silently losing the tail of the data.
+	return written;
 }
 
 uint16_t MQTT_ExchangeBufferPeek(exchangeBuffer *buffer, uint8_t *data, uint16_t length)
 {
-	uint8_t *ptr = buffer->currentLocation;
-	uint8_t *bend = buffer->start + buffer->bufferLength - 1;
-	uint16_t i = 0;
+	return MQTT_ExchangeBufferPeekAt(buffer, 0, data, length);
+}
+
+uint16_t MQTT_ExchangeBufferPeekAt(exchangeBuffer *buffer, uint16_t offset, uint8_t *data, uint16_t length)
+{
+	uint16_t position;
+	uint16_t firstLength;
 
-	for (i = 0; i < length && i < buffer->dataLength; i++) 
-    {
-		data[i] = ptr[i];
-		if (ptr > bend)
-        {
-			ptr = buffer->start;
-        }
+	if (offset >= buffer->dataLength)
+	{
+		return 0;
+	}
+	if (length > buffer->dataLength - offset)
+	{
+		length = buffer->dataLength - offset;
 	}
 
-	return i;
+	position = (buffer->currentLocation - buffer->start + offset) % buffer->bufferLength;
+	firstLength = buffer->bufferLength - position;
+	if (firstLength >= length)
+	{
+		memcpy(data, buffer->start + position, length);
+	}
+	else
+	{
+		memcpy(data, buffer->start + position, firstLength);
+		memcpy(data + firstLength, buffer->start, length - firstLength);
+	}
+	return length;
 }
 
 uint16_t MQTT_ExchangeBufferRead(exchangeBuffer *buffer, uint8_t *data, uint16_t length)
 {
-	uint8_t *bend = buffer->start + buffer->bufferLength - 1;
-	uint16_t i = 0;
-
-	for (i = 0; i < length && buffer->dataLength > 0; i++) 
-    {
-		data[i] = *buffer->currentLocation;
-		buffer->currentLocation++;
-		buffer->dataLength--;
-		if (buffer->currentLocation > bend)
-        {
-			buffer->currentLocation = buffer->start;
-        }
-	}
-	return i; 
+	return MQTT_ExchangeBufferConsume(buffer, MQTT_ExchangeBufferPeekAt(buffer, 0, data, length));
+}
+
+static void MQTT_ExchangeBufferReverse(uint8_t *first, uint8_t *last)
+{
+	uint8_t tmp;
+
+	while (first < last)
+	{
+		tmp = *first;
+		*first = *last;
+		*last = tmp;
+		first++;
+		last--;
+	}
+}
+
+uint8_t *MQTT_ExchangeBufferLinearize(exchangeBuffer *buffer, uint16_t length)
+{
+	uint16_t offset = buffer->currentLocation - buffer->start;
+	uint16_t firstLength = buffer->bufferLength - offset;
+
+	// The block must also be followed by one byte inside the buffer
+	if (offset + length < buffer->bufferLength)
+	{
+		return buffer->currentLocation;
+	}
+
+	if (buffer->dataLength <= firstLength)
+	{
+		// Not wrapped yet, only too close to the end
+		memmove(buffer->start, buffer->currentLocation, buffer->dataLength);
+	}
+	else if (buffer->bufferLength - buffer->dataLength >= firstLength)
+	{
+		// The free space can take the part at the end of the buffer: shift
+		// the wrapped part up behind it, then move that part to the front
+		memmove(buffer->start + firstLength, buffer->start, buffer->dataLength - firstLength);
+		memcpy(buffer->start, buffer->currentLocation, firstLength);
+	}
+	else
+	{
+		// Rotate the whole buffer in place so that the data starts at the
+		// beginning of it
+		MQTT_ExchangeBufferReverse(buffer->start, buffer->currentLocation - 1);
+		MQTT_ExchangeBufferReverse(buffer->currentLocation, buffer->start + buffer->bufferLength - 1);
+		MQTT_ExchangeBufferReverse(buffer->start, buffer->start + buffer->bufferLength - 1);
+	}
+	buffer->currentLocation = buffer->start;
+	return buffer->currentLocation;
 }
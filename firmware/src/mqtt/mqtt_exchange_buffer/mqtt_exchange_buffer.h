@@ -46,5 +46,19 @@ typedef struct
 
 void MQTT_ExchangeBufferInit(exchangeBuffer *buffer);
 uint16_t MQTT_ExchangeBufferPeek(exchangeBuffer *buffer, uint8_t *data, uint16_t length);
+uint16_t MQTT_ExchangeBufferPeekAt(exchangeBuffer *buffer, uint16_t offset, uint8_t *data, uint16_t length);
 uint16_t MQTT_ExchangeBufferWrite(exchangeBuffer *buffer, uint8_t *data, uint16_t length);
 uint16_t MQTT_ExchangeBufferRead(exchangeBuffer *buffer, uint8_t *data, uint16_t length);
+// Returns the first length bytes of data as one contiguous block, followed by
+// at least one byte of buffer space; length must be below bufferLength
+uint8_t *MQTT_ExchangeBufferLinearize(exchangeBuffer *buffer, uint16_t length);
+
+// Zero copy access. A span is the contiguous part of the data (read span) or
+// of the free space (write span) that starts at the current read or write 
+// position; the rest, if any, follows at the start of the buffer once the span
+// has been consumed or committed. Spans stay valid until the buffer is next
+// modified.
+uint8_t *MQTT_ExchangeBufferGetReadSpan(exchangeBuffer *buffer, uint16_t *length);
+uint16_t MQTT_ExchangeBufferConsume(exchangeBuffer *buffer, uint16_t length);
+uint8_t *MQTT_ExchangeBufferGetWriteSpan(exchangeBuffer *buffer, uint16_t *length);
+uint16_t MQTT_ExchangeBufferCommit(exchangeBuffer *buffer, uint16_t length);
@@ -35,8 +35,29 @@
 #include <stdint.h>
 #include <string.h>
 #include "mqtt_packetTransfer_interface.h"
+#include "../iot_config/mqtt_config.h"
 #include "../debug_print.h"
 
+#define TOPIC_TRIE_NONE     0xFFU
+#define TOPIC_TRIE_ROOT     0U
+
+/** \brief Node of the subscription index.
+ *
+ * Each node stands for one level of a subscribed topic filter. The level text
+ * points into the topic string of the handler table, so the table needs to 
+ * stay valid for as long as it is in use. Children of a node are kept in a 
+ * sibling list; the hash is compared before the text of a level.
+ */
+typedef struct
+{
+    const char *level;
+    uint16_t levelHash;
+    uint8_t levelLength;
+    uint8_t firstChild;
+    uint8_t nextSibling;
+    uint8_t handler;        // Index in the handler table, TOPIC_TRIE_NONE if no filter ends here
+} topicTrieNode;
+
 
 
 /**********************MQTT Interface layer variables**************************/
@@ -48,13 +69,228 @@
  * the application for further processing.
  */
 publishReceptionHandler_t *publishRecvInfo;
+
+/** \brief Subscription index built from the publish handler table.
+ *
+ * The topic filters of the table are compiled into a trie of topic levels, so
+ * that dispatching a PUBLISH packet costs one lookup per level of its topic 
+ * instead of a wildcard match against every entry of the table.
+ */
+static topicTrieNode topicTrie[MAX_NUM_TOPIC_TRIE_NODES];
+static uint8_t topicTrieNodeCount;
 /*******************MQTT Interface layer variables*(END)***********************/
 
 /**********************Function implementations********************************/
 
-void MQTT_SetPublishReceptionHandlerTable(publishReceptionHandler_t *appPublishReceptionInfo) 
+static uint16_t topicTrieHash(const char *level, uint8_t levelLength)
+{
+    uint16_t hash = 0;
+    uint8_t i;
+
+    for (i = 0; i < levelLength; i++)
+    {
+        hash = (hash << 5) + hash + (uint8_t) level[i];
+    }
+    return hash;
+}
+
+static uint8_t topicTrieLevelLength(const char *level)
+{
+    const char *end = strchr(level, '/');
+    size_t length = (end == NULL) ? strlen(level) : (size_t) (end - level);
+
+    // Topic levels longer than this are never matched
+    return (length > 0xFE) ? 0xFF : (uint8_t) length;
+}
+
+static uint8_t topicTrieFindChild(uint8_t parent, const char *level, uint8_t levelLength, uint16_t levelHash)
+{
+    uint8_t child;
+
+    if (levelLength == 0xFF)
+    {
+        return TOPIC_TRIE_NONE;
+    }
+    for (child = topicTrie[parent].firstChild; child != TOPIC_TRIE_NONE; child = topicTrie[child].nextSibling)
+    {
+        if ((topicTrie[child].levelHash == levelHash) && (topicTrie[child].levelLength == levelLength) 
+            && (memcmp(topicTrie[child].level, level, levelLength) == 0))
+        {
+            break;
+        }
+    }
+    return child;
+}
+
+static uint8_t topicTrieNewNode(void)
+{
+    uint8_t node;
+
+    if (topicTrieNodeCount >= MAX_NUM_TOPIC_TRIE_NODES)
+    {
+        return TOPIC_TRIE_NONE;
+    }
+    node = topicTrieNodeCount++;
+    topicTrie[node].level = NULL;
+    topicTrie[node].levelHash = 0;
+    topicTrie[node].levelLength = 0;
+    topicTrie[node].firstChild = TOPIC_TRIE_NONE;
+    topicTrie[node].nextSibling = TOPIC_TRIE_NONE;
+    topicTrie[node].handler = TOPIC_TRIE_NONE;
+    return node;
+}
+
+static bool topicTrieInsert(const char *topic, uint8_t handler)
 {
+    uint8_t node = TOPIC_TRIE_ROOT;
+    uint8_t child;
+    uint8_t levelLength;
+    uint16_t levelHash;
+    // Only the parent of the first new level is an existing node: restoring
+    // it and the node count takes a filter that does not fit back out
+    uint8_t nodeCount = topicTrieNodeCount;
+    uint8_t linkedParent = TOPIC_TRIE_NONE;
+    uint8_t linkedFirstChild = TOPIC_TRIE_NONE;
+
+    while (true)
+    {
+        levelLength = topicTrieLevelLength(topic);
+        levelHash = topicTrieHash(topic, levelLength);
+        child = topicTrieFindChild(node, topic, levelLength, levelHash);
+        if (child == TOPIC_TRIE_NONE)
+        {
+            child = (levelLength == 0xFF) ? TOPIC_TRIE_NONE : topicTrieNewNode();
+            if (child == TOPIC_TRIE_NONE)
+            {
+                if (linkedParent != TOPIC_TRIE_NONE)
+                {
+                    topicTrie[linkedParent].firstChild = linkedFirstChild;
+                }
+                topicTrieNodeCount = nodeCount;
+                return false;
+            }
+            if (linkedParent == TOPIC_TRIE_NONE)
+            {
+                linkedParent = node;
+                linkedFirstChild = topicTrie[node].firstChild;
+            }
+            topicTrie[child].level = topic;
+            topicTrie[child].levelHash = levelHash;
+            topicTrie[child].levelLength = levelLength;
+            topicTrie[child].nextSibling = topicTrie[node].firstChild;
+            topicTrie[node].firstChild = child;
+        }
+        node = child;
+
+        if (topic[levelLength] != '/')
+        {
+            break;
+        }
+        topic += levelLength + 1;
+    }
+
+    // The first entry of the table wins for a duplicated filter
+    if (topicTrie[node].handler == TOPIC_TRIE_NONE)
+    {
+        topicTrie[node].handler = handler;
+    }
+    return true;
+}
+
+static uint8_t topicTrieMatch(uint8_t node, const char *topic)
+{
+    uint8_t child;
+    uint8_t handler;
+    uint8_t levelLength;
+    const char *nextLevel;
+
+    if (topic == NULL)
+    {
+        // All levels consumed: "a/#" also matches "a" (MQTT RFC, section 4.7.1.2)
+        handler = topicTrie[node].handler;
+        if (handler == TOPIC_TRIE_NONE)
+        {
+            child = topicTrieFindChild(node, "#", 1, topicTrieHash("#", 1));
+            if (child != TOPIC_TRIE_NONE)
+            {
+                handler = topicTrie[child].handler;
+            }
+        }
+        return handler;
+    }
+
+    levelLength = topicTrieLevelLength(topic);
+    nextLevel = (topic[levelLength] == '/') ? (topic + levelLength + 1) : NULL;
+
+    // The most specific filter wins: exact level, then '+', then '#'
+    child = topicTrieFindChild(node, topic, levelLength, topicTrieHash(topic, levelLength));
+    if (child != TOPIC_TRIE_NONE)
+    {
+        handler = topicTrieMatch(child, nextLevel);
+        if (handler != TOPIC_TRIE_NONE)
+        {
+            return handler;
+        }
+    }
+    if ((node == TOPIC_TRIE_ROOT) && (topic[0] == '$'))
+    {
+        // Topics starting with '$' are not matched by a filter starting with
+        // a wildcard (MQTT RFC, section 4.7.2)
+        return TOPIC_TRIE_NONE;
+    }
+    child = topicTrieFindChild(node, "+", 1, topicTrieHash("+", 1));
+    if (child != TOPIC_TRIE_NONE)
+    {
+        handler = topicTrieMatch(child, nextLevel);
+        if (handler != TOPIC_TRIE_NONE)
+        {
+            return handler;
+        }
+    }
+    child = topicTrieFindChild(node, "#", 1, topicTrieHash("#", 1));
+    if (child != TOPIC_TRIE_NONE)
+    {
+        return topicTrie[child].handler;
+    }
+    return TOPIC_TRIE_NONE;
+}
+
+void MQTT_SetPublishReceptionHandlerTable(publishReceptionHandler_t *appPublishReceptionInfo, uint8_t numEntries) 
+{
+    uint8_t i;
+
     publishRecvInfo = appPublishReceptionInfo;
+
+    topicTrieNodeCount = 0;
+    topicTrieNewNode();
+    if (numEntries >= TOPIC_TRIE_NONE)
+    {
+        debug_printError("MQTT: %d publish handlers, only %d used", numEntries, TOPIC_TRIE_NONE - 1);
+        numEntries = TOPIC_TRIE_NONE - 1;
+    }
+    for (i = 0; (appPublishReceptionInfo != NULL) && (i < numEntries); i++)
+    {
+        if (appPublishReceptionInfo[i].topic == NULL)
+        {
+            continue;
+        }
+        if (topicTrieInsert(appPublishReceptionInfo[i].topic, i) == false)
+        {
+            debug_printError("MQTT: topic index full, %s not handled", appPublishReceptionInfo[i].topic);
+        }
+    }
+}
+
+publishReceptionHandler_t *MQTT_FindPublishReceptionHandler(uint8_t *topic)
+{
+    uint8_t handler;
+
+    if ((publishRecvInfo == NULL) || (topicTrieNodeCount == 0))
+    {
+        return NULL;
+    }
+    handler = topicTrieMatch(TOPIC_TRIE_ROOT, (const char*) topic);
+    return (handler == TOPIC_TRIE_NONE) ? NULL : &publishRecvInfo[handler];
 }
 
 publishReceptionHandler_t *MQTT_GetPublishReceptionHandlerTable()
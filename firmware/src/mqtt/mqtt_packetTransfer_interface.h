@@ -29,6 +29,7 @@
 #define	MQTT_PACKET_TRANSFER_INTERFACE_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 
 /*********************MQTT Interface layer definitions*************************/
@@ -38,16 +39,33 @@
  **/
 typedef void (*imqttHandlePublishDataFuncPtr)(uint8_t *topic, uint8_t *payload); 
 
+/** \brief Function pointers for streaming delivery of a received PUBLISH
+ * packet. begin is called once the topic is known, data for each contiguous 
+ * chunk of payload as it is received and end once the packet is complete, or 
+ * with complete set to false when the connection was lost before that. The
+ * topic stays valid until end is called; a data chunk only for the call.
+ * context is the one set in the publish reception handler table.
+ **/
+typedef void (*imqttPublishBeginFuncPtr)(void *context, uint8_t *topic, uint32_t payloadLength);
+typedef void (*imqttPublishDataFuncPtr)(void *context, uint8_t *data, uint16_t length);
+typedef void (*imqttPublishEndFuncPtr)(void *context, bool complete);
+
 // The call back table prototype for sending the payload received as part of  
 // PUBLISH packet to the correct publish reception handler function defined in     
 // the user application. An instance of this table needs to be initialised by  
 // the user application to specify the total number of topics to subscribe to,  
 // the path of each topic and the call back function for handling the payload 
 // received as part of the PUBLISH packet.
+// Setting the three streaming call backs selects streaming delivery for the
+// topic; the payload is then not limited by the size of the receive buffer.
 typedef struct
 {
     char *topic;
     imqttHandlePublishDataFuncPtr mqttHandlePublishDataCallBack;
+    imqttPublishBeginFuncPtr mqttPublishBeginCallBack;
+    imqttPublishDataFuncPtr mqttPublishDataCallBack;
+    imqttPublishEndFuncPtr mqttPublishEndCallBack;
+    void *mqttPublishContext;
 } publishReceptionHandler_t;
 
 /*******************MQTT Interface layer definitions*(END)*********************/
@@ -55,13 +73,19 @@ typedef struct
 /** \brief Set the publish reception handler table information.
  *
  * This function is called by the user application to inform the MQTT core of 
- * the call back table defined to handler the received PUBLISH messages. 
+ * the call back table defined to handler the received PUBLISH messages. The
+ * topic filters of the table are compiled into the subscription index here;
+ * entries without a topic are skipped. A PUBLISH packet is dispatched to the
+ * most specific matching filter: at each topic level an exact match is 
+ * preferred over '+', and '+' over '#'. Topics starting with '$' are only
+ * matched by filters that start with the same level.
  *
  * @param appPublishReceptionInfo Instance of publishReceptionHandler_t with
  *                                callback functions to handle PUBLISH messages 
  *                                received for each topic
+ * @param numEntries              Number of entries in the table
  */
-void MQTT_SetPublishReceptionHandlerTable(publishReceptionHandler_t *appPublishReceptionInfo);
+void MQTT_SetPublishReceptionHandlerTable(publishReceptionHandler_t *appPublishReceptionInfo, uint8_t numEntries);
 
 /** \brief Obtain the publishReceptionHandler_t table information defined in the 
  * user application that the application. 
@@ -74,5 +98,14 @@ void MQTT_SetPublishReceptionHandlerTable(publishReceptionHandler_t *appPublishR
  */
 publishReceptionHandler_t *MQTT_GetPublishReceptionHandlerTable();
 
+/** \brief Find the publish handler for the topic of a received PUBLISH packet.
+ *
+ * @param topic NUL terminated topic name of the PUBLISH packet
+ *
+ * @return entry of the publish reception handler table, NULL if no topic 
+ *         filter matches
+ */
+publishReceptionHandler_t *MQTT_FindPublishReceptionHandler(uint8_t *topic);
+
 #endif	/* MQTT_PACKET_TRANSFER_INTERFACE_H */
 
@@ -0,0 +1,234 @@
+/*
+    \file   mqtt_session_storage.c
+
+    \brief  MQTT session state storage source file.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+#include <string.h>
+#include "mqtt_session_storage.h"
+#include "../../iot_config/mqtt_config.h"
+#include "../../debug_print.h"
+#include "../../flash_storage.h"
+#include "definitions.h"
+
+#define SESSION_RECORD_MAGIC        0x4D515353UL    // "MQSS"
+#define SESSION_SLOT_COUNT          2U
+// The header takes the first page of a slot, the record data follows it
+#define SESSION_DATA_OFFSET         NVMCTRL_FLASH_PAGESIZE
+#define SESSION_SLOT_SIZE           ((SESSION_DATA_OFFSET + MQTT_SESSION_STORAGE_SIZE + NVMCTRL_FLASH_ROWSIZE - 1U) / NVMCTRL_FLASH_ROWSIZE * NVMCTRL_FLASH_ROWSIZE)
+
+typedef struct
+{
+	uint32_t magic;
+	uint32_t sequence;
+	uint32_t clientHash;
+	uint16_t length;
+	uint16_t checksum;
+} sessionRecordHeader;
+
+// Rows reserved in the application flash; reprogramming the device clears them
+static const volatile uint8_t sessionFlash[SESSION_SLOT_COUNT][SESSION_SLOT_SIZE] __attribute__((aligned(NVMCTRL_FLASH_ROWSIZE))) = { { 0 } };
+
+static uint32_t sessionPage[NVMCTRL_FLASH_PAGESIZE / sizeof(uint32_t)];
+static uint8_t sessionWriteSlot;
+static uint16_t sessionWriteLength;
+static uint16_t sessionWriteChecksum;
+static uint32_t sessionWriteHash;
+static uint32_t sessionWriteSequence;
+static bool sessionWriteFailed;
+static uint8_t sessionReadSlot;
+static uint16_t sessionReadLength;
+
+static uint32_t sessionSlotAddress(uint8_t slot)
+{
+	return (uint32_t) &sessionFlash[slot][0];
+}
+
+// Fletcher-16 style running checksum
+static uint16_t sessionChecksum(uint16_t checksum, const uint8_t *data, uint16_t length)
+{
+	uint8_t sum1 = checksum & 0xFF;
+	uint8_t sum2 = checksum >> 8;
+
+	while (length-- > 0)
+	{
+		sum1 = (sum1 + *data++) % 255;
+		sum2 = (sum2 + sum1) % 255;
+	}
+	return ((uint16_t) sum2 << 8) | sum1;
+}
+
+static bool sessionReadHeader(uint8_t slot, sessionRecordHeader *header)
+{
+	uint32_t address = sessionSlotAddress(slot);
+
+	NVMCTRL_Read((uint32_t *) header, sizeof(*header), address);
+	if ((header->magic != SESSION_RECORD_MAGIC) || (header->length > MQTT_SESSION_STORAGE_SIZE))
+	{
+		return false;
+	}
+	return (sessionChecksum(0, (const uint8_t *) (address + SESSION_DATA_OFFSET), header->length) == header->checksum);
+}
+
+bool MQTT_SessionStorageBegin(const uint8_t *clientID)
+{
+	sessionRecordHeader header;
+	uint32_t newestSequence = 0;
+	uint8_t slot;
+
+	// Write over the older of the two records
+	sessionWriteSlot = 0;
+	for (slot = 0; slot < SESSION_SLOT_COUNT; slot++)
+	{
+		if ((sessionReadHeader(slot, &header) == true) && (header.sequence >= newestSequence))
+		{
+			newestSequence = header.sequence;
+			sessionWriteSlot = (slot + 1) % SESSION_SLOT_COUNT;
+		}
+	}
+
+	sessionWriteSequence = newestSequence + 1;
+	sessionWriteHash = FLASH_STORAGE_hash(clientID, strlen((const char *) clientID));
+	sessionWriteLength = 0;
+	sessionWriteChecksum = 0;
+	sessionWriteFailed = false;
+	memset(sessionPage, 0xFF, sizeof(sessionPage));
+
+	if (FLASH_STORAGE_erase(sessionSlotAddress(sessionWriteSlot), SESSION_SLOT_SIZE) == false)
+	{
+		debug_printError("MQTT: session storage erase failed");
+		sessionWriteFailed = true;
+		return false;
+	}
+	return true;
+}
+
+bool MQTT_SessionStorageWrite(const uint8_t *data, uint16_t length)
+{
+	uint16_t pageOffset;
+	uint16_t copyLength;
+
+	if ((sessionWriteFailed == true) || (sessionWriteLength + length > MQTT_SESSION_STORAGE_SIZE))
+	{
+		sessionWriteFailed = true;
+		return false;
+	}
+
+	sessionWriteChecksum = sessionChecksum(sessionWriteChecksum, data, length);
+	while (length > 0)
+	{
+		pageOffset = sessionWriteLength % NVMCTRL_FLASH_PAGESIZE;
+		copyLength = NVMCTRL_FLASH_PAGESIZE - pageOffset;
+		if (copyLength > length)
+		{
+			copyLength = length;
+		}
+		memcpy((uint8_t *) sessionPage + pageOffset, data, copyLength);
+		data += copyLength;
+		length -= copyLength;
+		sessionWriteLength += copyLength;
+
+		if ((sessionWriteLength % NVMCTRL_FLASH_PAGESIZE) == 0)
+		{
+			if (FLASH_STORAGE_writePage(sessionPage, sessionSlotAddress(sessionWriteSlot) + SESSION_DATA_OFFSET + sessionWriteLength - NVMCTRL_FLASH_PAGESIZE) == false)
+			{
+				sessionWriteFailed = true;
+				return false;
+			}
+			memset(sessionPage, 0xFF, sizeof(sessionPage));
+		}
+	}
+	return true;
+}
+
+bool MQTT_SessionStorageEnd(void)
+{
+	sessionRecordHeader header;
+	uint32_t address = sessionSlotAddress(sessionWriteSlot);
+
+	if (sessionWriteFailed == true)
+	{
+		return false;
+	}
+	// Flush the last, partial page of data
+	if ((sessionWriteLength % NVMCTRL_FLASH_PAGESIZE) != 0)
+	{
+		if (FLASH_STORAGE_writePage(sessionPage, address + SESSION_DATA_OFFSET + sessionWriteLength - sessionWriteLength % NVMCTRL_FLASH_PAGESIZE) == false)
+		{
+			debug_printError("MQTT: session storage write failed");
+			return false;
+		}
+	}
+
+	// The header validates the record, so it goes last
+	header.magic = SESSION_RECORD_MAGIC;
+	header.sequence = sessionWriteSequence;
+	header.clientHash = sessionWriteHash;
+	header.length = sessionWriteLength;
+	header.checksum = sessionWriteChecksum;
+	memset(sessionPage, 0xFF, sizeof(sessionPage));
+	memcpy(sessionPage, &header, sizeof(header));
+	if (FLASH_STORAGE_writePage(sessionPage, address) == false)
+	{
+		debug_printError("MQTT: session storage write failed");
+		return false;
+	}
+	NVMCTRL_CacheInvalidate();
+	return true;
+}
+
+uint16_t MQTT_SessionStorageOpen(const uint8_t *clientID)
+{
+	sessionRecordHeader header;
+	uint32_t clientHash = FLASH_STORAGE_hash(clientID, strlen((const char *) clientID));
+	uint32_t newestSequence = 0;
+	uint16_t length = 0;
+	uint8_t slot;
+
+	for (slot = 0; slot < SESSION_SLOT_COUNT; slot++)
+	{
+		if ((sessionReadHeader(slot, &header) == true) && (header.clientHash == clientHash) && (header.sequence > newestSequence))
+		{
+			newestSequence = header.sequence;
+			length = header.length;
+			sessionReadSlot = slot;
+		}
+	}
+	sessionReadLength = length;
+	return length;
+}
+
+uint16_t MQTT_SessionStorageRead(uint16_t offset, uint8_t *data, uint16_t length)
+{
+	if (offset >= sessionReadLength)
+	{
+		return 0;
+	}
+	if (length > sessionReadLength - offset)
+	{
+		length = sessionReadLength - offset;
+	}
+	NVMCTRL_Read((uint32_t *) data, length, sessionSlotAddress(sessionReadSlot) + SESSION_DATA_OFFSET + offset);
+	return length;
+}
@@ -0,0 +1,59 @@
+/*
+    \file   mqtt_session_storage.h
+
+    \brief  MQTT session state storage header file.
+
+    (c) 2018 Microchip Technology Inc. and its subsidiaries.
+
+    Subject to your compliance with these terms, you may use Microchip software and any
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party
+    license terms applicable to your use of third party software (including open source software) that
+    may accompany Microchip software.
+
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS
+    FOR A PARTICULAR PURPOSE.
+
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS
+    SOFTWARE.
+*/
+
+#ifndef MQTT_SESSION_STORAGE_H
+#define MQTT_SESSION_STORAGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** \brief Flash backed store for the client side of a persistent MQTT session.
+ *
+ * A session record is written as a stream of bytes between 
+ * MQTT_SessionStorageBegin() and MQTT_SessionStorageEnd(). Two record slots 
+ * are used in turn and the header of a record is programmed last, so the 
+ * previous record stays valid until the new one is complete. Records are 
+ * tagged with a hash of the MQTT client ID and are ignored for any other 
+ * client.
+ *
+ * Writing a record erases and programs flash rows, which stalls the CPU for
+ * several milliseconds per row: records are meant to be written only when the
+ * session state needs to survive a reset, not on every change.
+ */
+
+bool MQTT_SessionStorageBegin(const uint8_t *clientID);
+bool MQTT_SessionStorageWrite(const uint8_t *data, uint16_t length);
+bool MQTT_SessionStorageEnd(void);
+
+/** \brief Select the newest valid record of the client.
+ *
+ * @return length of the record, 0 if there is none
+ */
+uint16_t MQTT_SessionStorageOpen(const uint8_t *clientID);
+uint16_t MQTT_SessionStorageRead(uint16_t offset, uint8_t *data, uint16_t length);
+
+#endif /* MQTT_SESSION_STORAGE_H */
@@ -34,9 +34,9 @@
 #include "bsdWINC.h"
 #include "../../../../iot_config/IoT_Sensor_Node_config.h"
 #include "socket.h"
+#include "m2m_wifi.h"
 #include "../../../../debug_print.h"
 
-#define MAX_SUPPORTED_SOCKETS		2
 /**********************BSD (WINC) Enumerator Translators ********************************/
 typedef enum
 {
@@ -94,10 +94,18 @@ typedef struct {
 /**********************BSD (Private) Global Variables ********************************/
 static bsdErrno_t bsdErrorNumber;
 
-static packetReceptionHandler_t *packetRecvInfo;
+// Handler entries indexed by WINC socket number
+static packetReceptionHandler_t *bsdSocketTable[MAX_SOCKET];
 
 /**********************BSD (Private) Function Prototypes *****************************/
 static void bsd_setErrNo (bsdErrno_t errorNumber);
+static uint8_t *bsd_recvFreeSpan(packetReceptionHandler_t *bsdSocketInfo, uint16_t *spanLength);
+static void bsd_recvPost(packetReceptionHandler_t *bsdSocketInfo);
+static void bsd_recvStore(packetReceptionHandler_t *bsdSocketInfo, tstrSocketRecvMsg *pstrRecv);
+static short bsd_pollSocket(int fd, short events);
+static void bsd_sendReset(packetReceptionHandler_t *bsdSocketInfo);
+static uint16_t bsd_sendCredits(packetReceptionHandler_t *bsdSocketInfo);
+static void bsd_sendComplete(packetReceptionHandler_t *bsdSocketInfo);
 
 /**********************BSD (Private) Function Implementations ************************/
 static void bsd_setErrNo (bsdErrno_t errorNumber)
@@ -105,31 +113,146 @@ static void bsd_setErrNo (bsdErrno_t errorNumber)
 	bsdErrorNumber = errorNumber;
 }
 
+// The receive buffer is a ring: the free space right after the buffered data,
+// up to the end of the buffer or up to the start of the data once wrapped
+static uint8_t *bsd_recvFreeSpan(packetReceptionHandler_t *bsdSocketInfo, uint16_t *spanLength)
+{
+	uint16_t tail;
+
+	if (bsdSocketInfo->recvLength == 0)
+	{
+		bsdSocketInfo->recvHead = 0;
+	}
+	tail = bsdSocketInfo->recvHead + bsdSocketInfo->recvLength;
+	if (tail >= bsdSocketInfo->recvBufferSize)
+	{
+		tail -= bsdSocketInfo->recvBufferSize;
+		*spanLength = bsdSocketInfo->recvHead - tail;
+	}
+	else
+	{
+		*spanLength = bsdSocketInfo->recvBufferSize - tail;
+	}
+	return bsdSocketInfo->recvBuffer + tail;
+}
+
+// Ask WINC for the next received message, to be written after the data 
+// already buffered. It is only asked for with room for a whole message in the
+// ring; a message split by the end of the buffer is joined by bsd_recvStore().
+// The WINC driver writes wherever the last recv() call pointed it, and only
+// the first call until a reply issues a command: a receive already posted is
+// moved along with the end of the data.
+static void bsd_recvPost(packetReceptionHandler_t *bsdSocketInfo)
+{
+	uint16_t wanted;
+	uint16_t spanLength;
+	uint8_t *span;
+
+	if (bsdSocketInfo->socketState != SOCKET_CONNECTED)
+	{
+		return;
+	}
+	wanted = (bsdSocketInfo->recvBufferSize < SOCKET_BUFFER_MAX_LENGTH) ? bsdSocketInfo->recvBufferSize : SOCKET_BUFFER_MAX_LENGTH;
+	if ((bsdSocketInfo->recvPosted == false) && (bsdSocketInfo->recvBufferSize - bsdSocketInfo->recvLength < wanted))
+	{
+		return;
+	}
+	span = bsd_recvFreeSpan(bsdSocketInfo, &spanLength);
+	if (spanLength == 0)
+	{
+		return;
+	}
+	if (recv((SOCKET)*bsdSocketInfo->socket, span, spanLength, 0) == WINC_SOCK_ERR_NO_ERROR)
+	{
+		bsdSocketInfo->recvPosted = true;
+	}
+	// Otherwise the WINC command queue is full: retried on the next BSD_recv()
+}
+
+static void bsd_recvStore(packetReceptionHandler_t *bsdSocketInfo, tstrSocketRecvMsg *pstrRecv)
+{
+	uint16_t spanLength;
+	uint8_t *span;
+
+	// WINC wrote the data in place
+	bsdSocketInfo->recvLength += pstrRecv->s16BufferSize;
+
+	if (pstrRecv->u16RemainingSize > 0)
+	{
+		// WINC filled the space it was given and the driver writes the rest
+		// of the message as soon as this returns: point it past this part,
+		// wrapping to the start of the buffer. The ring is never filled up, so
+		// that the receive this posts always has room to move to.
+		if (pstrRecv->u16RemainingSize >= bsdSocketInfo->recvBufferSize - bsdSocketInfo->recvLength)
+		{
+			debug_printError("BSD: socket (%d) message too large for its receive buffer", *bsdSocketInfo->socket);
+			BSD_close(*bsdSocketInfo->socket);
+			return;
+		}
+		span = bsd_recvFreeSpan(bsdSocketInfo, &spanLength);
+		// Answered by this message, the receive is posted again: this call
+		// also asks for the next message
+		bsdSocketInfo->recvPosted = (recv((SOCKET)*bsdSocketInfo->socket, span, spanLength, 0) == WINC_SOCK_ERR_NO_ERROR);
+		bsdSocketInfo->recvSplit = true;
+		return;
+	}
+
+	// Each RECV reply answers one recv() call, unless the call that took the
+	// end of a split message has already asked for the next one
+	if (bsdSocketInfo->recvSplit == true)
+	{
+		bsdSocketInfo->recvSplit = false;
+	}
+	else
+	{
+		bsdSocketInfo->recvPosted = false;
+	}
+	bsd_recvPost(bsdSocketInfo);
+}
+
+static void bsd_sendReset(packetReceptionHandler_t *bsdSocketInfo)
+{
+	bsdSocketInfo->sendHead = 0;
+	bsdSocketInfo->sendCount = 0;
+	bsdSocketInfo->sendOutstanding = 0;
+}
+
+static uint16_t bsd_sendCredits(packetReceptionHandler_t *bsdSocketInfo)
+{
+	if (bsdSocketInfo->sendCount >= BSD_SEND_QUEUE_DEPTH)
+	{
+		return 0;
+	}
+	return BSD_SEND_WINDOW - bsdSocketInfo->sendOutstanding;
+}
+
+// WINC answers every send() with one SOCKET_MSG_SEND, in order. The length 
+// it reports is not relied upon (it is an error code on failure), the oldest
+// send is released instead.
+static void bsd_sendComplete(packetReceptionHandler_t *bsdSocketInfo)
+{
+	if (bsdSocketInfo->sendCount == 0)
+	{
+		return;		// Sent before the last connect
+	}
+	bsdSocketInfo->sendOutstanding -= bsdSocketInfo->sendLength[bsdSocketInfo->sendHead];
+	bsdSocketInfo->sendHead = (bsdSocketInfo->sendHead + 1) % BSD_SEND_QUEUE_DEPTH;
+	bsdSocketInfo->sendCount--;
+}
+
 /**********************BSD (Public) Function Implementations **************************/
 bsdErrno_t BSD_GetErrNo(void)
 {
 	return bsdErrorNumber;
 }
 
-packetReceptionHandler_t* getSocketInfo(uint8_t sock)
+static packetReceptionHandler_t* getSocketInfo(int sock)
 {   
-   uint8_t i = 0;
-   if (sock >= 0)
+   if ((sock < 0) || (sock >= MAX_SOCKET))
    {
-      packetReceptionHandler_t *bsdSocketInfo = BSD_GetRecvHandlerTable();
-      for(i = 0; i < MAX_SUPPORTED_SOCKETS; i++)
-      {
-         if(bsdSocketInfo)
-         {
-            if(*(bsdSocketInfo->socket) == sock)
-            {
-               return bsdSocketInfo;
-            }
-         }
-         bsdSocketInfo++;
-      }
+      return NULL;
    }
-   return NULL;
+   return bsdSocketTable[sock];
 }
 
 int BSD_socket(int domain, int type, int protocol)
@@ -181,9 +304,34 @@ int BSD_socket(int domain, int type, int protocol)
 		return BSD_ERROR;
 	}       
    
+   // A new socket has no handler until BSD_SetSocketHandler()
+   bsdSocketTable[wincSocketReturn] = NULL;
    return wincSocketReturn;		// >= 0 represents SUCCESS
 }
 
+int BSD_SetSocketHandler(int socket, packetReceptionHandler_t *handler)
+{
+   if ((socket < 0) || (socket >= MAX_SOCKET))
+   {
+      bsd_setErrNo(EBADF);
+      return BSD_ERROR;
+   }
+   if ((handler == NULL) || (handler->socket == NULL) || (*handler->socket != socket))
+   {
+      bsd_setErrNo(EINVAL);
+      return BSD_ERROR;
+   }
+   handler->socketState = SOCKET_CLOSED;
+   handler->recvHead = 0;
+   handler->recvLength = 0;
+   handler->recvPosted = false;
+   handler->recvSplit = false;
+   handler->pollEvents = 0;
+   bsd_sendReset(handler);
+   bsdSocketTable[socket] = handler;
+   return BSD_SUCCESS;
+}
+
 int BSD_connect(int socket, const struct bsd_sockaddr *name, socklen_t namelen)
 { 
    int returnValue = BSD_ERROR;
@@ -237,6 +385,14 @@ int BSD_connect(int socket, const struct bsd_sockaddr *name, socklen_t namelen)
             {
                debug_printGOOD("BSD: socket (%d) in progress",*bsdSocket->socket);
                bsdSocket->socketState = SOCKET_IN_PROGRESS;
+               bsdSocket->recvHead = 0;
+               bsdSocket->recvLength = 0;
+               bsdSocket->recvPosted = false;
+               bsdSocket->recvSplit = false;
+               bsdSocket->pollEvents = 0;
+               bsd_sendReset(bsdSocket);
+               bsdSocket->connectStart = SYS_TIME_CounterGet();
+               bsdSocket->connectTime = 0;
                returnValue = BSD_SUCCESS;
             }
 		}
@@ -248,19 +404,12 @@ int BSD_connect(int socket, const struct bsd_sockaddr *name, socklen_t namelen)
     return returnValue; 
 }
 
-void BSD_SetRecvHandlerTable(packetReceptionHandler_t *appRecvInfo)
-{
-	packetRecvInfo = appRecvInfo;
-}
-
-packetReceptionHandler_t *BSD_GetRecvHandlerTable()
-{
-	return packetRecvInfo;
-}
-
 int BSD_recv(int socket, const void *buf, size_t len, int flags)
 {
     wincSocketResponses_t wincRecvReturn;
+	packetReceptionHandler_t *bsdSocketInfo;
+	uint16_t readLength;
+	uint16_t firstLength;
 	
 	if (flags != 0)
 	{	// Flag Not Support by WINC implementation
@@ -268,6 +417,44 @@ int BSD_recv(int socket, const void *buf, size_t len, int flags)
 		return BSD_ERROR;		
 	} 
 	
+	bsdSocketInfo = getSocketInfo(socket);
+	if ((bsdSocketInfo != NULL) && (bsdSocketInfo->recvBuffer != NULL))
+	{
+		if (buf == NULL)
+		{
+			bsd_setErrNo(EFAULT);
+			return BSD_ERROR;
+		}
+		if (bsdSocketInfo->recvLength == 0)
+		{
+			if ((bsdSocketInfo->socketState == SOCKET_CONNECTED) || (bsdSocketInfo->socketState == SOCKET_IN_PROGRESS))
+			{
+				bsd_recvPost(bsdSocketInfo);
+				bsd_setErrNo(EWOULDBLOCK);
+				return BSD_ERROR;
+			}
+			return 0;	// Connection closed and all of its data read
+		}
+
+		// In two parts when the data wraps around the end of the buffer
+		readLength = (len < bsdSocketInfo->recvLength) ? len : bsdSocketInfo->recvLength;
+		firstLength = bsdSocketInfo->recvBufferSize - bsdSocketInfo->recvHead;
+		if (firstLength > readLength)
+		{
+			firstLength = readLength;
+		}
+		memcpy((void *)buf, bsdSocketInfo->recvBuffer + bsdSocketInfo->recvHead, firstLength);
+		memcpy((uint8_t *)buf + firstLength, bsdSocketInfo->recvBuffer, readLength - firstLength);
+		bsdSocketInfo->recvHead += readLength;
+		if (bsdSocketInfo->recvHead >= bsdSocketInfo->recvBufferSize)
+		{
+			bsdSocketInfo->recvHead -= bsdSocketInfo->recvBufferSize;
+		}
+		bsdSocketInfo->recvLength -= readLength;
+		bsd_recvPost(bsdSocketInfo);
+		return readLength;
+	}
+
    wincRecvReturn = recv((SOCKET)socket, (void*)buf, (uint16_t)len, (uint32_t)flags);
 	if(wincRecvReturn != WINC_SOCK_ERR_NO_ERROR)
 	{
@@ -637,10 +824,71 @@ int BSD_read(int fd, void *buf, size_t nbytes)
 	return BSD_ERROR;
 }
 
+static short bsd_pollSocket(int fd, short events)
+{
+	packetReceptionHandler_t *bsdSocketInfo;
+	short revents;
+
+	if (fd < 0)
+	{
+		return 0;	// Entry to be ignored
+	}
+	bsdSocketInfo = getSocketInfo(fd);
+	if (bsdSocketInfo == NULL)
+	{
+		return POLLNVAL;
+	}
+	revents = bsdSocketInfo->pollEvents;
+	if ((bsdSocketInfo->socketState == NOT_A_SOCKET) && (revents == 0))
+	{
+		return POLLNVAL;	// Closed by the application
+	}
+	// Data received before a hangup can still be read
+	if (bsdSocketInfo->recvLength > 0)
+	{
+		revents |= POLLIN;
+	}
+	if ((bsdSocketInfo->socketState == SOCKET_CONNECTED) && (bsd_sendCredits(bsdSocketInfo) >= SOCKET_BUFFER_MAX_LENGTH))
+	{
+		revents |= POLLOUT;
+	}
+	return revents & (events | POLLERR | POLLHUP | POLLNVAL);
+}
+
 int BSD_poll(struct pollfd *ufds, unsigned int nfds, int timeout)
 {
-	bsd_setErrNo(ENOSYS);
-	return BSD_ERROR;
+	uint32_t startCount = SYS_TIME_CounterGet();
+	unsigned int i;
+	int ready;
+
+	if ((ufds == NULL) && (nfds > 0))
+	{
+		bsd_setErrNo(EFAULT);
+		return BSD_ERROR;
+	}
+
+	while (true)
+	{
+		ready = 0;
+		for (i = 0; i < nfds; i++)
+		{
+			ufds[i].revents = bsd_pollSocket(ufds[i].fd, ufds[i].events);
+			if (ufds[i].revents != 0)
+			{
+				ready++;
+			}
+		}
+		if ((ready > 0) || (timeout == 0))
+		{
+			return ready;
+		}
+		if ((timeout > 0) && (SYS_TIME_CountToMS(SYS_TIME_CounterGet() - startCount) >= (uint32_t)timeout))
+		{
+			return 0;
+		}
+		// Socket events are only delivered from here
+		m2m_wifi_handle_events();
+	}
 }
 
 socketState_t BSD_GetSocketState(int sock)
@@ -659,15 +907,41 @@ socketState_t BSD_GetSocketState(int sock)
 	return sockState;
 }
 
+int BSD_GetSendCredits(int socket)
+{
+   packetReceptionHandler_t *bsdSocketInfo = getSocketInfo(socket);
+
+   if (bsdSocketInfo == NULL)
+   {
+      bsd_setErrNo(EBADF);
+      return BSD_ERROR;
+   }
+   if (bsdSocketInfo->socketState != SOCKET_CONNECTED)
+   {
+      bsd_setErrNo(ENOTCONN);
+      return BSD_ERROR;
+   }
+   return bsd_sendCredits(bsdSocketInfo);
+}
+
 int BSD_send(int socket, const void *msg, size_t len, int flags)
 {
    wincSocketResponses_t wincSendReturn;
+   packetReceptionHandler_t *bsdSocketInfo;
 
    if (flags != 0)
    {	// Flag Not Support by WINC implementation
       bsd_setErrNo(EINVAL);
       return BSD_ERROR;
    }
+
+   // Oversized messages are left to WINC to reject
+   bsdSocketInfo = getSocketInfo(socket);
+   if ((bsdSocketInfo != NULL) && (len <= SOCKET_BUFFER_MAX_LENGTH) && (len > bsd_sendCredits(bsdSocketInfo)))
+   {
+      bsd_setErrNo(ENOBUFS);
+      return BSD_ERROR;
+   }
    
    wincSendReturn = send((SOCKET)socket, (void*)msg, (uint16_t)len, (uint16_t)flags);
    if(wincSendReturn != WINC_SOCK_ERR_NO_ERROR)
@@ -709,6 +983,12 @@ int BSD_send(int socket, const void *msg, size_t len, int flags)
       // successfully send the packet, 'len' number of bytes will
       // be transmitted. In this case, it is safe to return the
       // value of 'len' as the number of bytes sent.
+      if (bsdSocketInfo != NULL)
+      {
+         bsdSocketInfo->sendLength[(bsdSocketInfo->sendHead + bsdSocketInfo->sendCount) % BSD_SEND_QUEUE_DEPTH] = len;
+         bsdSocketInfo->sendCount++;
+         bsdSocketInfo->sendOutstanding += len;
+      }
       return len;
    }
 }
@@ -801,10 +1081,16 @@ void BSD_SocketHandler(int8_t sock, uint8_t msgType, void *pMsg)
             {
                debug_printGOOD("BSD: MSG_CONNECT successful");
                bsdSocketInfo->socketState = SOCKET_CONNECTED;
+               bsdSocketInfo->connectTime = SYS_TIME_CountToMS(SYS_TIME_CounterGet() - bsdSocketInfo->connectStart);
+               if (bsdSocketInfo->recvBuffer != NULL)
+               {
+                  bsd_recvPost(bsdSocketInfo);
+               }
             }
             else
             {
                debug_printError("BSD: Closing Socket in MSG_CONNECT error (%d)",pstrConnect->s8Error);
+               bsdSocketInfo->pollEvents = POLLERR;
                BSD_close(sock);
             }
          }
@@ -812,6 +1098,11 @@ void BSD_SocketHandler(int8_t sock, uint8_t msgType, void *pMsg)
 
 		case SOCKET_MSG_SEND:
 		   bsdSocketInfo->socketState = SOCKET_CONNECTED;
+		   bsd_sendComplete(bsdSocketInfo);
+		   if ((bsdSocketInfo->sendCallBack != NULL) && (pMsg != NULL))
+		   {
+		      bsdSocketInfo->sendCallBack(*(int16_t *)pMsg);
+		   }
 		break;
 
       case SOCKET_MSG_RECV:
@@ -823,11 +1114,17 @@ void BSD_SocketHandler(int8_t sock, uint8_t msgType, void *pMsg)
             
             if (pstrRecv->s16BufferSize > 0) 
             {
-	            bsdSocketInfo->recvCallBack(pstrRecv->pu8Buffer, pstrRecv->s16BufferSize);
+	            // Update the state first: the callback may close the socket
 	            bsdSocketInfo->socketState = SOCKET_CONNECTED;
+	            if (bsdSocketInfo->recvBuffer != NULL)
+	            {
+	               bsd_recvStore(bsdSocketInfo, pstrRecv);
+	            }
+	            bsdSocketInfo->recvCallBack(pstrRecv->pu8Buffer, pstrRecv->s16BufferSize);
 							   
             } else {
                debug_printError("BSD: SOCKET (%d) CLOSED", sock);
+               bsdSocketInfo->pollEvents = (pstrRecv->s16BufferSize < 0) ? (POLLERR | POLLHUP) : POLLHUP;
                BSD_close(sock);  
             }                                
          }
@@ -38,6 +38,13 @@
 #define		BSD_SUCCESS		0
 #define		BSD_ERROR		-1
 
+// struct pollfd events
+#define		POLLIN			0x0001	// Data can be read with BSD_recv()
+#define		POLLOUT			0x0004	// A full size message can be sent
+#define		POLLERR			0x0008	// Connection failed or aborted
+#define		POLLHUP			0x0010	// Connection closed by the peer
+#define		POLLNVAL		0x0020	// Not an open socket
+
 /************* (END) BSD Generic Defines (END) *****************/
 
 /***************** BSD Type Defined Enumerators **********************/
@@ -179,6 +186,8 @@ typedef enum
 	EOWNERDEAD,
 }bsdErrno_t;
 
+#define		EWOULDBLOCK		EAGAIN
+
 /***************** (END) BSD Type Defined Enumerators (END) **********************/
 
 /***************** BSD Typedefs and Structures **********************/
@@ -222,24 +231,57 @@ struct pollfd {
  **/
 typedef void (*bsdRecvFuncPtr)(uint8_t *data, uint16_t length); 
 
-// The call back table prototype for sending the packet received over a socket
-// to the correct reception handler function defined in the user application.
-// An instance of this table needs to be initialized by the user application to 
-// to specify the recv callback function for each socket. 
+/** \brief Function pointer to notify the user application that data passed to
+ * BSD_send() has been sent. sentLength is negative on error.
+ **/
+typedef void (*bsdSendFuncPtr)(int16_t sentLength);
+
+// Data handed to WINC by BSD_send() and not yet confirmed by a send 
+// completion, per socket with a handler. Beyond that BSD_send() fails with
+// ENOBUFS instead of filling the WINC buffers.
+#define BSD_SEND_QUEUE_DEPTH    4U      // Sends
+#define BSD_SEND_WINDOW         2800U   // Bytes, two full size messages
+
+// The call back entry for sending the packet received over a socket to the 
+// correct reception handler function defined in the user application. The 
+// application fills in one entry per socket and attaches it with 
+// BSD_SetSocketHandler() once BSD_socket() has returned the socket.
+//
+// A socket given a receive buffer (recvBuffer, at least SOCKET_BUFFER_MAX_LENGTH
+// bytes) keeps what WINC delivers there, as a ring, until the application 
+// reads it with BSD_recv(). recvCallBack is then only a notification that data is waiting.
+// Without a buffer, data is passed to recvCallBack in the buffer given to the
+// last BSD_recv() call.
 typedef struct
 {
    int8_t *socket;
    bsdRecvFuncPtr recvCallBack;
 	socketState_t socketState;
+   bsdSendFuncPtr sendCallBack;    // Optional, may be NULL
+   uint8_t *recvBuffer;            // Optional, may be NULL
+   uint16_t recvBufferSize;
+   // Managed by the adapter
+   uint16_t recvHead;
+   uint16_t recvLength;
+   bool recvPosted;
+   bool recvSplit;                 // The rest of a message is still to come
+   short pollEvents;               // POLLERR and POLLHUP, until the next connect
+   uint16_t sendLength[BSD_SEND_QUEUE_DEPTH];  // Unconfirmed sends, oldest at sendHead
+   uint8_t sendHead;
+   uint8_t sendCount;
+   uint16_t sendOutstanding;       // Bytes
+   uint32_t connectStart;          // SYS_TIME counter at BSD_connect()
+   uint32_t connectTime;           // ms until connected, TLS handshake included
 } packetReceptionHandler_t;
 
 
 /*********************** (END) BSD Adapter definitions (END) **************************/
 
 /***************** BSD Public Functions **************************************/
-void BSD_SetRecvHandlerTable(packetReceptionHandler_t *appRecvInfo);
-
-packetReceptionHandler_t *BSD_GetRecvHandlerTable();
+// Attach a handler entry to a socket returned by BSD_socket(); *handler->socket
+// must hold the socket. The entry receives the events of the socket, and its 
+// state is set to SOCKET_CLOSED, until the socket number is handed out again.
+int BSD_SetSocketHandler(int socket, packetReceptionHandler_t *handler);
 
 bsdErrno_t BSD_GetErrNo(void);
 
@@ -247,8 +289,19 @@ int BSD_socket(int domain, int type, int protocol);
 
 int BSD_connect(int socket, const struct bsd_sockaddr *name, socklen_t namelen);
 
+// Fails with ENOBUFS, sending nothing, when the socket has fewer send 
+// credits than len; the data can be sent again once a send has completed.
 int BSD_send(int socket, const void *msg, size_t len, int flags);
 
+// Number of bytes BSD_send() accepts now on a connected socket with a
+// handler, BSD_ERROR otherwise. Credits come back with the sendCallBack.
+int BSD_GetSendCredits(int socket);
+
+// With a receive buffer: returns the number of bytes read, 0 once the 
+// connection is closed and the buffer empty, or BSD_ERROR with EWOULDBLOCK
+// when no data is waiting yet.
+// Without: hands buf to WINC and returns BSD_SUCCESS; the data is passed to 
+// the recvCallBack.
 int BSD_recv(int socket, const void *msg, size_t len, int flags);
 
 int BSD_close(int socket);
@@ -277,14 +330,19 @@ int BSD_write(int fd, const void *buf, size_t nbytes);
 
 int BSD_read(int fd, void *buf, size_t nbytes);
 
+// Waits until one of the sockets is ready or timeout milliseconds have passed
+// (0: return at once, negative: no limit), handling WINC events meanwhile; 
+// not to be called from a socket callback. POLLIN is only reported for 
+// sockets with a receive buffer. Returns the number of entries with revents
+// set, 0 on timeout.
 int BSD_poll(struct pollfd *ufds, unsigned int nfds, int timeout);
 
 int BSD_sendto(int socket, const void *msg, size_t len,	int flags, const struct bsd_sockaddr *to, socklen_t tolen);
 
 void BSD_SocketHandler(int8_t sock, uint8_t msgType, void *pMsg);
 
-// ToDo This is not a true BSD_poll(). The actual BSD_poll() requires a 
-// structures and returns values which are not currently supported by WINC1500.
+// Connection state as tracked by the adapter; see BSD_poll() to wait for a 
+// socket to become ready
 socketState_t BSD_GetSocketState(int sock);
 
 /************ (END) BSD Public Functions (END) *********************************/
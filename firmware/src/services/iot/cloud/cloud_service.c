@@ -26,6 +26,7 @@
 */ 
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
@@ -47,6 +48,7 @@
 #include "cryptoauthlib/lib/basic/atca_basic.h"
 #include "iot_config/mqtt_config.h"
 #include "led.h"
+#include "flash_storage.h"
 
 #include "../../../config/SAMD21_WG_IOT/driver/winc/include/drv/driver/m2m_ssl.h"
 
@@ -70,7 +72,12 @@ char mqttSubscribeTopic[TOPIC_SIZE];
 
 static int8_t connectMQTTSocket(void);
 static void connectMQTT();
+static void pumpMQTT(void);
 static uint8_t reInit(void);
+static void cloudRenewConnection(void);
+static void cloudRenewCancel(void);
+static void cloudTlsPrepare(int8_t socket);
+static void cloudTlsReport(void);
 
 bool isResetting = false;
 bool cloudResetTimerFlag = false;
@@ -78,7 +85,14 @@ bool sendSubscribe = true;
 #define CLOUD_TASK_INTERVAL            500L
 #define CLOUD_MQTT_TIMEOUT_COUNT	   10000L  // 10 seconds max allowed to establish a connection
 #define MQTT_CONN_AGE_TIMEOUT          3600L   // 3600 seconds = 60minutes
+#define MQTT_CONN_RENEW_AHEAD          60L     // Seconds before MQTT_CONN_AGE_TIMEOUT the renewal starts
 #define CLOUD_RESET_TIMEOUT            2000L   // 2 seconds
+#define CLOUD_RECOVERY_MAX_DELAY       60000L  // 60 seconds
+#define CLOUD_RECOVERY_TIER_ATTEMPTS   2       // Recoveries at a tier before the next one is used
+#define CLOUD_CONNACK_REFUSALS_MAX     3       // Refusals in a row before the client gives the host up
+#define CLOUD_DNS_CACHE_SIZE           4
+#define CLOUD_DNS_CACHE_TTL_TICKS      ((uint32_t)CFG_DNS_CACHE_TTL * 1000L / CLOUD_TASK_INTERVAL)
+#define CLOUD_DNS_RECORD_MAGIC         0x534E4443UL    // "CDNS"
 
 SYS_TIME_HANDLE cloudResetTaskHandle    = SYS_TIME_HANDLE_INVALID;
 SYS_TIME_HANDLE mqttTimeoutTaskHandle   = SYS_TIME_HANDLE_INVALID;
@@ -89,6 +103,18 @@ volatile bool cloudResetTaskTmrExpired = false;
 void mqttTimeoutTask(void);
 void cloudResetTask(void);
 
+// First delay before a recovery at each tier, doubled by every further 
+// recovery at that tier until a connection is established
+static const uint32_t cloudRecoveryBaseDelay[] =
+{
+   [CLOUD_RECOVER_MQTT] = 1000L,
+   [CLOUD_RECOVER_SOCKET] = 2000L,
+   [CLOUD_RECOVER_WIFI] = CLOUD_RESET_TIMEOUT,
+};
+static cloudRecoveryTier_t cloudRecoveryTier = CLOUD_RECOVER_WIFI;  // Of the pending recovery; the first one connects to the AP
+static uint8_t cloudRecoveryAttempts[CLOUD_RECOVER_WIFI + 1];
+static uint8_t cloudConnackRefusals;   // CONNACK refusals since the last connection
+
 /** \brief MQTT publish handler call back table.
  *
  * This callback table lists the callback function for to be called on reception 
@@ -100,10 +126,160 @@ void cloudResetTask(void);
  *       Sample publish handler function  = void handlePublishMessage(uint8_t *topic, uint8_t *payload)
  * 
  */
-packetReceptionHandler_t cloud_packetReceiveCallBackTable[CLOUD_PACKET_RECV_TABLE_SIZE];
+static packetReceptionHandler_t cloudMqttSocketHandlers[2];
+
+// Index of the handler of the MQTT socket; the other one is for the socket
+// opened ahead of a renewal
+static uint8_t cloudActiveHandler = 0;
+static int8_t cloudStandbySocket = -1;
+static bool cloudRenewFailed = false;
+
+// Holds what the MQTT socket receives until MQTT_Receive() reads it
+static uint8_t cloudMqttRecvBuffer[SOCKET_BUFFER_MAX_LENGTH];
+
+static bool cloudSslInitialized = false;
+// ECC operations WINC asked for since the last connect
+static uint8_t cloudTlsEccRequests;
+static bool cloudTlsReported;
+static uint32_t cloudTlsHandshakeTime;
+static uint8_t cloudTlsHandshakeEcc;
 
 static char *ateccsn = NULL;
 
+// DNS cache, hosts are known by the hash of their name. The addresses are 
+// saved in flash so that a reboot connects without a DNS round trip.
+typedef struct
+{
+    uint32_t hostHash;
+    uint32_t address;   // 0: free entry
+} cloudDnsEntry;
+
+typedef struct
+{
+    uint32_t magic;
+    cloudDnsEntry entries[CLOUD_DNS_CACHE_SIZE];
+    uint32_t checksum;
+} cloudDnsRecord;
+
+static cloudDnsEntry cloudDnsCache[CLOUD_DNS_CACHE_SIZE];
+static uint32_t cloudDnsExpiry[CLOUD_DNS_CACHE_SIZE];   // In CLOUD_task() ticks
+static uint32_t cloudTicks;
+static bool cloudDnsLoaded = false;
+static bool cloudDnsDirty = false;
+
+// Row reserved in the application flash; reprogramming the device clears it
+static const volatile uint8_t cloudDnsFlash[NVMCTRL_FLASH_ROWSIZE] __attribute__((aligned(NVMCTRL_FLASH_ROWSIZE))) = { 0 };
+
+static void cloudDnsLoad(void)
+{
+    cloudDnsRecord record;
+    uint8_t i;
+
+    cloudDnsLoaded = true;
+    NVMCTRL_Read((uint32_t *)&record, sizeof(record), (uint32_t)cloudDnsFlash);
+    if ((record.magic != CLOUD_DNS_RECORD_MAGIC) || (record.checksum != FLASH_STORAGE_hash((const uint8_t *)record.entries, sizeof(record.entries))))
+    {
+        return;
+    }
+    memcpy(cloudDnsCache, record.entries, sizeof(cloudDnsCache));
+    // The age of a saved address is unknown: it is trusted for a full TTL,
+    // unless the connection to it fails
+    for (i = 0; i < CLOUD_DNS_CACHE_SIZE; i++)
+    {
+        cloudDnsExpiry[i] = cloudTicks + CLOUD_DNS_CACHE_TTL_TICKS;
+    }
+}
+
+static void cloudDnsSave(void)
+{
+    cloudDnsRecord record;
+
+    cloudDnsDirty = false;
+    record.magic = CLOUD_DNS_RECORD_MAGIC;
+    memcpy(record.entries, cloudDnsCache, sizeof(record.entries));
+    record.checksum = FLASH_STORAGE_hash((const uint8_t *)record.entries, sizeof(record.entries));
+
+    // Losing power in between only loses the saved addresses
+    if (FLASH_STORAGE_write((uint32_t)cloudDnsFlash, sizeof(cloudDnsFlash), &record, sizeof(record)) == false)
+    {
+        debug_printError("CLOUD: DNS cache save failed");
+    }
+}
+
+static cloudDnsEntry* cloudDnsFind(const char *host, uint8_t *index)
+{
+    uint32_t hash = FLASH_STORAGE_hash((const uint8_t *)host, strlen(host));
+    uint8_t i;
+
+    for (i = 0; i < CLOUD_DNS_CACHE_SIZE; i++)
+    {
+        if ((cloudDnsCache[i].address != 0) && (cloudDnsCache[i].hostHash == hash))
+        {
+            *index = i;
+            return &cloudDnsCache[i];
+        }
+    }
+    return NULL;
+}
+
+// Returns 0 unless host has an address that has not expired
+static uint32_t cloudDnsLookup(const char *host)
+{
+    cloudDnsEntry *entry;
+    uint8_t i;
+
+    entry = cloudDnsFind(host, &i);
+    if ((entry == NULL) || ((int32_t)(cloudDnsExpiry[i] - cloudTicks) <= 0))
+    {
+        return 0;
+    }
+    return entry->address;
+}
+
+static void cloudDnsStore(const char *host, uint32_t address)
+{
+    uint32_t hash = FLASH_STORAGE_hash((const uint8_t *)host, strlen(host));
+    uint8_t i;
+    uint8_t slot;
+
+    if (cloudDnsFind(host, &slot) == NULL)
+    {
+        // A free entry, or else the one expiring first
+        slot = 0;
+        for (i = 0; i < CLOUD_DNS_CACHE_SIZE; i++)
+        {
+            if (cloudDnsCache[i].address == 0)
+            {
+                slot = i;
+                break;
+            }
+            if ((int32_t)(cloudDnsExpiry[i] - cloudDnsExpiry[slot]) < 0)
+            {
+                slot = i;
+            }
+        }
+    }
+    // Flash is only written when an address changes, not on every refresh
+    if ((cloudDnsCache[slot].hostHash != hash) || (cloudDnsCache[slot].address != address))
+    {
+        cloudDnsDirty = true;
+    }
+    cloudDnsCache[slot].hostHash = hash;
+    cloudDnsCache[slot].address = address;
+    cloudDnsExpiry[slot] = cloudTicks + CLOUD_DNS_CACHE_TTL_TICKS;
+}
+
+// The address may be stale: have the host looked up again
+static void cloudDnsExpire(const char *host)
+{
+    uint8_t i;
+
+    if (cloudDnsFind(host, &i) != NULL)
+    {
+        cloudDnsExpiry[i] = cloudTicks;
+    }
+}
+
 void NETWORK_wifiSslCallback(uint8_t u8MsgType, void *pvMsg)
 {
     switch (u8MsgType)
@@ -111,6 +287,7 @@ void NETWORK_wifiSslCallback(uint8_t u8MsgType, void *pvMsg)
         case M2M_SSL_REQ_ECC:
         {
             tstrEccReqInfo *ecc_request = (tstrEccReqInfo*)pvMsg;
+            cloudTlsEccRequests++;
             CRYPTO_CLIENT_processEccRequest(ecc_request);
 
             break;
@@ -148,21 +325,89 @@ void cloudResetTaskcb(uintptr_t context)
 void CLOUD_reset(void)
 {
    debug_printError("CLOUD: Cloud Reset");
-	cloudInitialized = false;
+   CLOUD_recover(CLOUD_RECOVER_WIFI);
+}
+
+void CLOUD_recover(cloudRecoveryTier_t tier)
+{
+   // Recoveries that did not help move on to the next tier
+   while ((tier < CLOUD_RECOVER_WIFI) && (cloudRecoveryAttempts[tier] >= CLOUD_RECOVERY_TIER_ATTEMPTS))
+   {
+      tier++;
+   }
+   // A recovery already pending at a higher tier covers this one
+   if ((cloudInitialized == true) || (tier > cloudRecoveryTier))
+   {
+      cloudRecoveryTier = tier;
+   }
+   cloudInitialized = false;
+}
+
+// Exponential backoff, half of it random so that devices which lost their 
+// connection together do not come back in lockstep
+static uint32_t cloudRecoveryDelay(void)
+{
+   uint32_t delay = cloudRecoveryBaseDelay[cloudRecoveryTier];
+   uint8_t attempts = cloudRecoveryAttempts[cloudRecoveryTier];
+
+   while ((attempts-- > 0) && (delay < CLOUD_RECOVERY_MAX_DELAY))
+   {
+      delay <<= 1;
+   }
+   if (delay > CLOUD_RECOVERY_MAX_DELAY)
+   {
+      delay = CLOUD_RECOVERY_MAX_DELAY;
+   }
+   return (delay / 2) + ((uint32_t)rand() % (delay / 2 + 1));
 }
 
 void mqttTimeoutTask(void)
 {
+   mqttContext *context = MQTT_GetClientConnectionInfo();
+
    debug_printError("CLOUD: MQTT Connection Timeout");
-   CLOUD_reset();
    waitingForMQTT = false;
+   if (BSD_GetSocketState(*context->tcpClientSocket) == SOCKET_CONNECTED)
+   {
+      CLOUD_recover(CLOUD_RECOVER_MQTT);
+   }
+   else
+   {
+      CLOUD_recover(CLOUD_RECOVER_SOCKET);
+   }
 }
 
 
 void cloudResetTask(void)
 {
-	debug_printError("CLOUD: Reset task");
-   cloudInitialized = reInit();  
+   mqttContext *context = MQTT_GetClientConnectionInfo();
+
+   debug_printError("CLOUD: Reset task, tier %d attempt %d", cloudRecoveryTier, cloudRecoveryAttempts[cloudRecoveryTier] + 1);
+   cloudRecoveryAttempts[cloudRecoveryTier]++;
+   switch (cloudRecoveryTier)
+   {
+      case CLOUD_RECOVER_SOCKET:
+         // New DNS lookup, TCP connection and TLS handshake
+         cloudDnsExpire(mqtt_host);
+         if (BSD_GetSocketState(*context->tcpClientSocket) != NOT_A_SOCKET)
+         {
+            BSD_close(*context->tcpClientSocket);
+         }
+         cloudRenewCancel();
+         // no break
+      case CLOUD_RECOVER_MQTT:
+         // CLOUD_task() connects again, over the socket if it is still open
+         MQTT_initialiseState();
+         isResetting = false;
+         cloudResetTimerFlag = false;
+         cloudInitialized = true;
+         break;
+
+      case CLOUD_RECOVER_WIFI:
+      default:
+         cloudInitialized = reInit();
+         break;
+   }
 }
 
 void CLOUD_init_host(char* host, char* attDeviceID, pf_MQTT_CLIENT* pf_table)
@@ -171,6 +416,59 @@ void CLOUD_init_host(char* host, char* attDeviceID, pf_MQTT_CLIENT* pf_table)
     mqttHostIP = 0;
     pf_mqtt_client = pf_table;
     CLOUD_setdeviceId(attDeviceID);
+    // Devices differ by their ID even when they start together
+    if (attDeviceID != NULL)
+    {
+        srand(FLASH_STORAGE_hash((const uint8_t *)attDeviceID, strlen(attDeviceID)) ^ SYS_TIME_CounterGet());
+    }
+    if (cloudDnsLoaded == false)
+    {
+        cloudDnsLoad();
+    }
+}
+
+// Resolve a host that is about to be connected to, such as the IoT Hub 
+// assigned by DPS while the provisioning connection is still up
+void CLOUD_prefetchHost(char* host)
+{
+    if (cloudDnsLookup(host) == 0)
+    {
+        wifi_getIpAddressByHostName((uint8_t*)host);
+    }
+}
+
+// Set up a socket of the MQTT connection before it connects
+static void cloudTlsPrepare(int8_t socket)
+{
+#if CFG_TLS_SESSION_CACHING
+   int32_t enable = 1;
+
+   // WINC then resumes the session: no ECDHE and no signature by the ECC608
+   if (BSD_setsockopt(socket, SOL_SSL_SOCKET, SO_SSL_ENABLE_SESSION_CACHING, &enable, sizeof(enable)) != BSD_SUCCESS)
+   {
+      debug_printError("CLOUD: TLS session caching not enabled (%d)", BSD_GetErrNo());
+   }
+#endif
+   cloudTlsEccRequests = 0;
+   cloudTlsReported = false;
+}
+
+static void cloudTlsReport(void)
+{
+   if (cloudTlsReported == true)
+   {
+      return;
+   }
+   cloudTlsReported = true;
+   cloudTlsHandshakeTime = cloudMqttSocketHandlers[cloudActiveHandler].connectTime;
+   cloudTlsHandshakeEcc = cloudTlsEccRequests;
+   debug_printInfo("CLOUD: TLS handshake %lu ms, %u ECC operations%s", cloudTlsHandshakeTime, cloudTlsHandshakeEcc, (cloudTlsHandshakeEcc == 0) ? " (resumed)" : "");
+}
+
+void CLOUD_getTlsHandshake(uint32_t *durationMs, uint8_t *eccOperations)
+{
+   *durationMs = cloudTlsHandshakeTime;
+   *eccOperations = cloudTlsHandshakeEcc;
 }
 
 static void connectMQTT()
@@ -178,6 +476,8 @@ static void connectMQTT()
     time_t currentTime;// = time(NULL);
     struct tm sys_time;
 
+    cloudTlsReport();
+
     RTC_RTCCTimeGet(&sys_time);
     currentTime = mktime(&sys_time);
     
@@ -191,6 +491,153 @@ static void connectMQTT()
    
    // MQTT SUBSCRIBE packet will be sent after the MQTT connection is established.
    sendSubscribe = true;
+   cloudRenewFailed = false;
+}
+
+// Make before break: the TCP connection and the TLS handshake of the next 
+// session are done on a standby socket while the current session still 
+// publishes. IoT Hub closes the older of two connections of a device, so 
+// the switch happens before the new CONNECT.
+static void cloudRenewConnection(void)
+{
+   mqttContext *context = MQTT_GetClientConnectionInfo();
+   packetReceptionHandler_t *active = &cloudMqttSocketHandlers[cloudActiveHandler];
+   packetReceptionHandler_t *standby = &cloudMqttSocketHandlers[cloudActiveHandler ^ 1];
+   struct bsd_sockaddr_in addr;
+   uint32_t hostIP;
+
+   if (cloudStandbySocket < 0)
+   {
+      if (cloudRenewFailed == true)
+      {
+         return;     // Renewed the hard way at MQTT_CONN_AGE_TIMEOUT
+      }
+      hostIP = cloudDnsLookup(mqtt_host);
+      if (hostIP == 0)
+      {
+         // Paced like the lookups of a closed socket; dnsHandler() ends the wait
+         if (dnsRetryDelay > 0)
+         {
+            dnsRetryDelay--;
+         }
+         else
+         {
+            dnsRetryDelay = 30;
+            wifi_getIpAddressByHostName((uint8_t*)mqtt_host);
+         }
+         return;
+      }
+      cloudStandbySocket = BSD_socket(PF_INET, BSD_SOCK_STREAM, 1);
+      if ((cloudStandbySocket < 0) || (BSD_SetSocketHandler(cloudStandbySocket, standby) != BSD_SUCCESS))
+      {
+         cloudRenewCancel();
+         cloudRenewFailed = true;
+         return;
+      }
+      addr.sin_family = PF_INET;
+      addr.sin_port = BSD_htons(CFG_MQTT_PORT);
+      addr.sin_addr.s_addr = hostIP;
+      debug_printInfo("CLOUD: Renewing the connection");
+      cloudTlsPrepare(cloudStandbySocket);
+      if (BSD_connect(cloudStandbySocket, (struct bsd_sockaddr *)&addr, sizeof(struct bsd_sockaddr_in)) != BSD_SUCCESS)
+      {
+         cloudRenewCancel();
+         cloudRenewFailed = true;
+      }
+      return;
+   }
+
+   switch (BSD_GetSocketState(cloudStandbySocket))
+   {
+      case SOCKET_CONNECTED:
+         break;
+      case SOCKET_IN_PROGRESS:
+         return;
+      default:
+         // Connection or TLS handshake failed
+         debug_printError("CLOUD: Renewal failed");
+         cloudRenewCancel();
+         cloudRenewFailed = true;
+         return;
+   }
+
+   // The queued packets, QoS 0 telemetry included, go out on the current
+   // connection first: MQTT_ClientInitialise() drops what is left
+   if ((MQTT_IsTxQueueEmpty() == false) || (BSD_GetSendCredits(*context->tcpClientSocket) < (int)BSD_SEND_WINDOW))
+   {
+      MQTT_SetRunnable();
+      return;
+   }
+
+   debug_printInfo("CLOUD: Switching to the renewed connection");
+   MQTT_Disconnect(context);
+   BSD_close(*context->tcpClientSocket);
+
+   // The standby handler takes over the MQTT socket and its receive buffer
+   *context->tcpClientSocket = cloudStandbySocket;
+   standby->socket = context->tcpClientSocket;
+   standby->recvBuffer = cloudMqttRecvBuffer;
+   standby->recvBufferSize = sizeof(cloudMqttRecvBuffer);
+   active->socket = &cloudStandbySocket;
+   active->recvBuffer = NULL;
+   active->recvBufferSize = 0;
+   cloudActiveHandler ^= 1;
+   cloudStandbySocket = -1;
+
+   MQTT_ClientInitialise();
+   connectMQTT();
+}
+
+static void cloudRenewCancel(void)
+{
+   if (cloudStandbySocket >= 0)
+   {
+      BSD_close(cloudStandbySocket);
+      cloudStandbySocket = -1;
+   }
+}
+
+// Runs the MQTT engine whenever it has been marked runnable: by received
+// data, a completed send, a new packet or the periodic cloud task.
+static void pumpMQTT(void)
+{
+   mqttContext* mqttConnnectionInfo = MQTT_GetClientConnectionInfo();
+
+   if ((shared_networking_params.haveAPConnection == 0) 
+      || (BSD_GetSocketState(*mqttConnnectionInfo->tcpClientSocket) != SOCKET_CONNECTED)
+      || (MQTT_GetConnectionState() == DISCONNECTED))
+   {
+      return;
+   }
+
+   MQTT_Receive(mqttConnnectionInfo);
+   MQTT_ReceptionHandler(mqttConnnectionInfo);
+   MQTT_TransmissionHandler(mqttConnnectionInfo);
+
+   // Data left in the socket while the Rx buffer was full is dispatched on 
+   // the next pass
+   if (MQTT_Receive(mqttConnnectionInfo) == true)
+   {
+      MQTT_SetRunnable();
+   }
+
+   if (MQTT_GetConnectionState() == CONNECTED)
+   {
+      shared_networking_params.haveERROR = 0;  
+      LED_holdGreenOn(LED_ON);
+      SYS_TIME_TimerStop(mqttTimeoutTaskHandle);
+      SYS_TIME_TimerStop(cloudResetTaskHandle);
+      isResetting = false;
+      memset(cloudRecoveryAttempts, 0, sizeof(cloudRecoveryAttempts));
+      cloudConnackRefusals = 0;
+
+      waitingForMQTT = false;      
+
+      if(sendSubscribe == true)
+      { 
+         CLOUD_subscribe();
+      }
+   }
 }
 
 void CLOUD_subscribe(void)
@@ -210,8 +657,6 @@ void CLOUD_disconnect(void){
     }
 }
 
-// Todo: This declaration supports the hack below
-packetReceptionHandler_t* getSocketInfo(uint8_t sock);
 static int8_t connectMQTTSocket(void)
 {
    int8_t ret = false;
@@ -219,10 +664,18 @@ static int8_t connectMQTTSocket(void)
     // Abstract the SSL section into a separate function
     int8_t sslInit;
 
-    sslInit = m2m_ssl_init(NETWORK_wifiSslCallback);
-    if(sslInit != M2M_SUCCESS)
+    // Once: it also forgets an ECC request being processed
+    if (cloudSslInitialized == false)
     {
-        debug_printInfo("WiFi SSL Initialization failed");
+        sslInit = m2m_ssl_init(NETWORK_wifiSslCallback);
+        if(sslInit != M2M_SUCCESS)
+        {
+            debug_printInfo("WiFi SSL Initialization failed");
+        }
+        else
+        {
+            cloudSslInitialized = true;
+        }
     }
   
    if (mqttHostIP > 0)
@@ -243,17 +696,14 @@ static int8_t connectMQTTSocket(void)
          
          if (*context->tcpClientSocket >=0)
          {
-            packetReceptionHandler_t*  sockInfo = getSocketInfo(*context->tcpClientSocket);
-            if (sockInfo != NULL)
-            {
-               sockInfo->socketState = SOCKET_CLOSED;
-            }
+            BSD_SetSocketHandler(*context->tcpClientSocket, &cloudMqttSocketHandlers[cloudActiveHandler]);
          }
       }
    
       socketState = BSD_GetSocketState(*context->tcpClientSocket);
       if (socketState == SOCKET_CLOSED) {
          debug_print("CLOUD: Connect socket");
+         cloudTlsPrepare(*context->tcpClientSocket);
          ret = BSD_connect(*context->tcpClientSocket, (struct bsd_sockaddr *)&addr, sizeof(struct bsd_sockaddr_in));
 
          if (ret != BSD_SUCCESS) {
@@ -272,6 +722,12 @@ void CLOUD_task(void)
 	mqttContext* mqttConnnectionInfo = MQTT_GetClientConnectionInfo();
 	socketState_t socketState;
     
+	cloudTicks++;
+	if (cloudDnsDirty == true)
+	{
+		cloudDnsSave();
+	}
+
 	if (!cloudInitialized)
 	{
       if (!isResetting)
@@ -279,7 +735,7 @@ void CLOUD_task(void)
         isResetting = true;
         debug_printError("CLOUD: Cloud reset timer is set");
         SYS_TIME_TimerStop(mqttTimeoutTaskHandle);
-        cloudResetTaskHandle = SYS_TIME_CallbackRegisterMS(cloudResetTaskcb, 0, CLOUD_RESET_TIMEOUT, SYS_TIME_SINGLE);
+        cloudResetTaskHandle = SYS_TIME_CallbackRegisterMS(cloudResetTaskcb, 0, cloudRecoveryDelay(), SYS_TIME_SINGLE);
         cloudResetTimerFlag = true;		 
       }      
 	} else {
@@ -335,26 +791,55 @@ void CLOUD_task(void)
          }
       }
       
+      connectReturnCode refusal = MQTT_ConsumeConnackRefusal();
+      if (refusal != CONN_ACCEPTED)
+      {
+         cloudConnackRefusals++;
+         debug_printError("CLOUD: Connection refused (%d), %d in a row", refusal, cloudConnackRefusals);
+         // Bad credentials or a device the host does not know are not going 
+         // away; anything else, such as a busy server, gets the usual backoff
+         if (((refusal == CONN_REFUSED_USERNAME_OR_PASSWORD) || (refusal == CONN_REFUSED_NOT_AUTHORIZED) || (cloudConnackRefusals >= CLOUD_CONNACK_REFUSALS_MAX)) 
+            && (pf_mqtt_client->MQTT_CLIENT_connect_refused != NULL))
+         {
+            cloudConnackRefusals = 0;
+            pf_mqtt_client->MQTT_CLIENT_connect_refused();
+         }
+         else
+         {
+            // The server closes the connection after a refusal
+            CLOUD_recover(CLOUD_RECOVER_SOCKET);
+         }
+         return;
+      }
+
+      if (!cloudInitialized)
+      {
+         // The pending recovery reconnects
+         return;
+      }
+
       switch(socketState)
 	   {
            case NOT_A_SOCKET:
 		   case SOCKET_CLOSED:
-            if (dnsRetryDelay)
+            cloudRenewCancel();
+            mqttHostIP = cloudDnsLookup(mqtt_host);
+            if (mqttHostIP != 0)
+            {
+                // Reinitialize MQTT
+                MQTT_ClientInitialise();
+                connectMQTTSocket();
+            }
+            else if (dnsRetryDelay)
             {
                 dnsRetryDelay--;
                 // still waiting for DNS look up
             }
-            else if (mqttHostIP == 0)
+            else
             {
                 dnsRetryDelay = 30;
                 wifi_getIpAddressByHostName((uint8_t*)mqtt_host);
             }
-            else
-            {
-                // Reinitialize MQTT
-                MQTT_ClientInitialise();
-                connectMQTTSocket();
-            }
             break;
       
 		   case SOCKET_CONNECTED:
@@ -365,33 +850,22 @@ void CLOUD_task(void)
             } 
 			else 
 			{
-               MQTT_ReceptionHandler(mqttConnnectionInfo);
-               MQTT_TransmissionHandler(mqttConnnectionInfo);
-
-               // Todo: We already processed the data in place using PEEK, this just flushes the buffer
-               BSD_recv(*MQTT_GetClientConnectionInfo()->tcpClientSocket, MQTT_GetClientConnectionInfo()->mqttDataExchangeBuffers.rxbuff.start, MQTT_GetClientConnectionInfo()->mqttDataExchangeBuffers.rxbuff.bufferLength, 0);
+               // Packets are exchanged by pumpMQTT() as socket events arrive;
+               // the periodic pass keeps the protocol timers serviced.
+               MQTT_SetRunnable();
               
                if (MQTT_GetConnectionState() == CONNECTED)
                {
-                  shared_networking_params.haveERROR = 0;  
-                  LED_holdGreenOn(LED_ON);
-                  SYS_TIME_TimerStop(mqttTimeoutTaskHandle);
-                  SYS_TIME_TimerStop(cloudResetTaskHandle);
-                  isResetting = false;
-
-                  waitingForMQTT = false;      
-				  
-				  if(sendSubscribe == true)
-				  { 
-				      CLOUD_subscribe();
-				  }				 
-				               
                   // The Authorization timeout is set to 3600, so we need to re-connect that often
                   if (MQTT_getConnectionAge() > MQTT_CONN_AGE_TIMEOUT) {
 					  debug_printError("MQTT: Connection aged, Uptime %lus SocketState (%d) MQTT (%d)", thisAge , socketState, MQTT_GetConnectionState());
+                     cloudRenewCancel();
                      MQTT_Disconnect(mqttConnnectionInfo);
                      BSD_close(*mqttConnnectionInfo->tcpClientSocket);
                   }
+                  else if (MQTT_getConnectionAge() > MQTT_CONN_AGE_TIMEOUT - MQTT_CONN_RENEW_AHEAD) {
+                     cloudRenewConnection();
+                  }
                } 
             }
 		   break;
@@ -427,9 +901,14 @@ void dnsHandler(uint8_t* domainName, uint32_t serverIP)
 {
     if(serverIP != 0)
     {
-        dnsRetryDelay = 0;
-        mqttHostIP = serverIP;
-        debug_printInfo("CLOUD: mqttHostIP = (%lu.%lu.%lu.%lu)\n", (0x0FF & (serverIP)), (0x0FF & (serverIP >> 8)), (0x0FF & (serverIP >> 16)), (0x0FF & (serverIP >> 24)));
+        // Prefetched hosts are answered here too
+        cloudDnsStore((char*)domainName, serverIP);
+        if ((mqtt_host != NULL) && (strcmp((char*)domainName, mqtt_host) == 0))
+        {
+            dnsRetryDelay = 0;
+            mqttHostIP = serverIP;
+        }
+        debug_printInfo("CLOUD: %s = (%lu.%lu.%lu.%lu)\n", domainName, (0x0FF & (serverIP)), (0x0FF & (serverIP >> 8)), (0x0FF & (serverIP >> 16)), (0x0FF & (serverIP >> 24)));
     }
 }
 
@@ -444,12 +923,19 @@ static uint8_t reInit(void)
 		   	
     registerSocketCallback(BSD_SocketHandler, dnsHandler);
 
+    cloudRenewCancel();
     MQTT_ClientInitialise();
-    memset(&cloud_packetReceiveCallBackTable, 0, sizeof(cloud_packetReceiveCallBackTable));
-    BSD_SetRecvHandlerTable(cloud_packetReceiveCallBackTable);
-    
-    cloud_packetReceiveCallBackTable[0].socket = MQTT_GetClientConnectionInfo()->tcpClientSocket;
-    cloud_packetReceiveCallBackTable[0].recvCallBack = pf_mqtt_client->MQTT_CLIENT_receive;
+    memset(cloudMqttSocketHandlers, 0, sizeof(cloudMqttSocketHandlers));
+    cloudActiveHandler = 0;
+    cloudMqttSocketHandlers[0].socket = MQTT_GetClientConnectionInfo()->tcpClientSocket;
+    cloudMqttSocketHandlers[0].recvCallBack = pf_mqtt_client->MQTT_CLIENT_receive;
+    cloudMqttSocketHandlers[0].sendCallBack = MQTT_GetSendCompleted;
+    cloudMqttSocketHandlers[0].recvBuffer = cloudMqttRecvBuffer;
+    cloudMqttSocketHandlers[0].recvBufferSize = sizeof(cloudMqttRecvBuffer);
+    // Given the receive buffer once it takes over
+    cloudMqttSocketHandlers[1].socket = &cloudStandbySocket;
+    cloudMqttSocketHandlers[1].recvCallBack = pf_mqtt_client->MQTT_CLIENT_receive;
+    cloudMqttSocketHandlers[1].sendCallBack = MQTT_GetSendCompleted;
 
     //When the input comes through cli/.cfg
     if((strcmp(ssid,"") != 0) &&  (strcmp(authType,"") != 0))
@@ -490,5 +976,9 @@ void CLOUD_sched(void)
         cloudResetTaskTmrExpired = false;
         cloudResetTask();
     }
+
+    if (MQTT_ConsumeRunnable() == true) {
+        pumpMQTT();
+    }
 }
 
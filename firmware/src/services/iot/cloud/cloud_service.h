@@ -11,12 +11,23 @@
 #include <stdbool.h>
 #include "mqtt_packetPopulation/mqtt_packetPopulate.h"
 
-#define CLOUD_PACKET_RECV_TABLE_SIZE	2
 #define CLOUD_MAX_DEVICEID_LENGTH 30
 #define PASSWORD_SPACE 456
 
+// What is set up again to recover the connection, from the least to the 
+// most expensive
+typedef enum
+{
+    CLOUD_RECOVER_MQTT = 0,     // MQTT connection only
+    CLOUD_RECOVER_SOCKET,       // DNS lookup, TCP connection and TLS session too
+    CLOUD_RECOVER_WIFI          // Access point association too
+} cloudRecoveryTier_t;
+
 void CLOUD_init_host(char* host, char* deviceId, pf_MQTT_CLIENT* pf_table);
 void CLOUD_reset(void);
+// Recover at tier, or at the next one once it has been tried without 
+// success; each try waits longer than the previous one
+void CLOUD_recover(cloudRecoveryTier_t tier);
 void CLOUD_subscribe(void);
 void CLOUD_disconnect(void);
 bool CLOUD_isConnected(void);
@@ -24,6 +35,10 @@ void CLOUD_publishData(uint8_t *data, unsigned int len);
 void CLOUD_task(void);
 void CLOUD_sched(void);
 void dnsHandler(uint8_t * domainName, uint32_t serverIP);
+void CLOUD_prefetchHost(char* host);
+// Duration of the last TLS handshake of the MQTT socket, and the number of
+// ECC operations it took: none when the session was resumed
+void CLOUD_getTlsHandshake(uint32_t *durationMs, uint8_t *eccOperations);
 void CLOUD_setdeviceId(char *id);
 
 #endif /* CLOUD_SERVICE_H_ */
\ No newline at end of file
@@ -28,6 +28,7 @@
 #include "../../../../cryptoauthlib/config/cryptoauthlib_config.h"
 #include "../../../../cryptoauthlib/lib/jwt/atca_jwt.h"
 #include "../../../../cryptoauthlib/lib/tls/atcatls.h"
+#include "../../../../cryptoauthlib/lib/atca_execution.h"
 #include "crypto_client.h"
 #include "../cloud_service.h"
 
@@ -51,9 +52,50 @@
 #endif
 
 #define DEVICE_KEY_SLOT            (0)
+// Server certificate signatures checked without blocking, more are checked by
+// ecdsa_process_sign_verify_request()
+#define ECC_VERIFY_MAX             (3)
 static uint32_t g_ecdh_key_slot_index = 0;
 static uint16_t g_ecdh_key_slot[] = {2};
 
+typedef enum
+{
+    ECC_CMD_NONE,
+    ECC_CMD_GENKEY,
+    ECC_CMD_ECDH,
+    ECC_CMD_RANDOM,
+    ECC_CMD_NONCE,
+    ECC_CMD_SIGN,
+    ECC_CMD_VERIFY
+} eccCommand_t;
+
+typedef struct
+{
+    tstrECPoint key;
+    uint8_t hash[80];
+    uint8_t signature[80];
+} eccVerifyInput_t;
+
+// ECC request of WINC being answered. WINC waits for the answer before it
+// sends the next request, whose input is read from it in the meantime.
+static struct
+{
+    bool busy;
+    tstrEccReqInfo request;
+    tstrEccReqInfo response;
+    uint8_t signature[80];
+    uint16_t signatureSize;
+    uint8_t hash[32];
+    eccVerifyInput_t verify[ECC_VERIFY_MAX];
+    uint8_t verifyCount;
+    uint16_t keyId;
+    uint8_t ecdhMode;
+    uint8_t step;
+    ATCAPacket packet;
+} eccJob;
+
+static void eccJobNext(void);
+
 const uint8_t public_key_x509_header[] = { 0x30, 0x59, 0x30, 0x13, 0x06, 0x07, 0x2A, 0x86,
     0x48, 0xCE, 0x3D, 0x02, 0x01, 0x06, 0x08, 0x2A,
     0x86, 0x48, 0xCE, 0x3D, 0x03, 0x01, 0x07, 0x03,
@@ -77,6 +119,8 @@ uint8_t cryptoDeviceInitialized = false;
 uint8_t CRYPTO_CLIENT_createJWT(char* buf, size_t buflen, uint32_t ts, const char* projectId)
 {
     atca_jwt_t jwt;
+    ATCA_STATUS status;
+    bool session;
 
    if (!cryptoDeviceInitialized)
    {
@@ -106,7 +150,14 @@ uint8_t CRYPTO_CLIENT_createJWT(char* buf, size_t buflen, uint32_t ts, const cha
             return ERROR;
         }
 
-        if (ATCA_SUCCESS != atca_jwt_finalize(&jwt, 0))
+        // atcab_sign() runs Random, Nonce and Sign with one wake
+        session = (atca_session_begin() == ATCA_SUCCESS);
+        status = atca_jwt_finalize(&jwt, 0);
+        if (session == true)
+        {
+            atca_session_end(_gDevice);
+        }
+        if (ATCA_SUCCESS != status)
         {
             return ERROR;
         }
@@ -337,52 +388,298 @@ int8_t ecdh_derive_server_shared_secret(uint16_t private_key_id, tstrECPoint *cl
     return status;
 }
 
+// Command of the current request at the given step, ECC_CMD_NONE past the last one
+static eccCommand_t eccJobCommand(uint8_t step)
+{
+    static const eccCommand_t clientEcdh[] = { ECC_CMD_GENKEY, ECC_CMD_ECDH, ECC_CMD_NONE };
+    static const eccCommand_t genKey[] = { ECC_CMD_GENKEY, ECC_CMD_NONE };
+    static const eccCommand_t serverEcdh[] = { ECC_CMD_ECDH, ECC_CMD_NONE };
+    // Make sure RNG has updated its seed, as atcab_sign() does
+    static const eccCommand_t signGen[] = { ECC_CMD_RANDOM, ECC_CMD_NONCE, ECC_CMD_SIGN, ECC_CMD_NONE };
+    static const eccCommand_t none[] = { ECC_CMD_NONE };
+    const eccCommand_t *sequence;
+
+    switch (eccJob.request.u16REQ)
+    {
+        case ECC_REQ_CLIENT_ECDH:
+        sequence = clientEcdh;
+        break;
+
+        case ECC_REQ_GEN_KEY:
+        sequence = genKey;
+        break;
+
+        case ECC_REQ_SERVER_ECDH:
+        sequence = serverEcdh;
+        break;
+
+        case ECC_REQ_SIGN_GEN:
+        // Other curves get no signature
+        sequence = (eccJob.signatureSize != 0) ? signGen : none;
+        break;
+
+        case ECC_REQ_SIGN_VERIFY:
+        // Load the hash, then verify, for each signature
+        if (step >= eccJob.verifyCount * 2)
+        {
+            return ECC_CMD_NONE;
+        }
+        return ((step % 2) == 0) ? ECC_CMD_NONCE : ECC_CMD_VERIFY;
+
+        default:
+        return ECC_CMD_NONE;
+    }
+    return sequence[step];
+}
+
+static void eccJobFinish(uint16_t status)
+{
+    eccJob.response.u16Status   = status;
+    eccJob.response.u16REQ      = eccJob.request.u16REQ;
+    eccJob.response.u32UserData = eccJob.request.u32UserData;
+    eccJob.response.u32SeqNo    = eccJob.request.u32SeqNo;
+    eccJob.busy = false;
+    atca_session_end(_gDevice);
+
+    m2m_ssl_handshake_rsp(&eccJob.response, (eccJob.signatureSize != 0) ? eccJob.signature : NULL, eccJob.signatureSize);
+}
+
+static void eccJobCommandDone(ATCA_STATUS status, ATCAPacket *packet, void *context)
+{
+    eccCommand_t command = eccJobCommand(eccJob.step);
+
+    if ((command == ECC_CMD_VERIFY) && (status == ATCA_CHECKMAC_VERIFY_FAILED))
+    {
+        debug_printInfo("ECDSA SigVerif FAILED");
+    }
+    if (status != ATCA_SUCCESS)
+    {
+        eccJobFinish(M2M_ERR_FAIL);
+        return;
+    }
+
+    switch (command)
+    {
+        case ECC_CMD_GENKEY:
+        memcpy(eccJob.response.strEcdhREQ.strPubKey.X, &packet->data[ATCA_RSP_DATA_IDX], ATCA_PUB_KEY_SIZE);
+        eccJob.response.strEcdhREQ.strPubKey.u16Size = 32;
+        if (eccJob.request.u16REQ == ECC_REQ_GEN_KEY)
+        {
+            eccJob.response.strEcdhREQ.strPubKey.u16PrivKeyID = eccJob.keyId;
+            g_ecdh_key_slot_index++;
+        }
+        break;
+
+        case ECC_CMD_ECDH:
+        memcpy(eccJob.response.strEcdhREQ.au8Key, &packet->data[ATCA_RSP_DATA_IDX], ATCA_KEY_SIZE);
+        break;
+
+        case ECC_CMD_SIGN:
+        memcpy(eccJob.signature, &packet->data[ATCA_RSP_DATA_IDX], ATCA_SIG_SIZE);
+        break;
+
+        default:
+        break;
+    }
+    eccJob.step++;
+    eccJobNext();
+}
+
+// Build the packet of the next command of the request and start it, or answer
+// WINC once there is none left
+static void eccJobNext(void)
+{
+    ATCACommand ca_cmd = _gDevice->mCommands;
+    ATCAPacket *packet = &eccJob.packet;
+    eccVerifyInput_t *verify;
+    // Use the Message Digest Buffer for the ATECC608A
+    bool msgDigBuf = (_gDevice->mCommands->dt == ATECC608A);
+    ATCA_STATUS status;
+
+    switch (eccJobCommand(eccJob.step))
+    {
+        case ECC_CMD_GENKEY:
+        packet->param1 = GENKEY_MODE_PRIVATE;
+        packet->param2 = eccJob.keyId;
+        status = atGenKey(ca_cmd, packet);
+        break;
+
+        case ECC_CMD_ECDH:
+        packet->param1 = eccJob.ecdhMode;
+        packet->param2 = eccJob.keyId;
+        memcpy(packet->data, eccJob.request.strEcdhREQ.strPubKey.X, ATCA_PUB_KEY_SIZE);
+        status = atECDH(ca_cmd, packet);
+        break;
+
+        case ECC_CMD_RANDOM:
+        packet->param1 = RANDOM_SEED_UPDATE;
+        packet->param2 = 0x0000;
+        status = atRandom(ca_cmd, packet);
+        break;
+
+        case ECC_CMD_NONCE:
+        packet->param1 = NONCE_MODE_PASSTHROUGH | NONCE_MODE_INPUT_LEN_32 | (msgDigBuf ? NONCE_MODE_TARGET_MSGDIGBUF : NONCE_MODE_TARGET_TEMPKEY);
+        packet->param2 = 0;
+        memcpy(packet->data, (eccJob.request.u16REQ == ECC_REQ_SIGN_VERIFY) ? eccJob.verify[eccJob.step / 2].hash : eccJob.hash, 32);
+        status = atNonce(ca_cmd, packet);
+        break;
+
+        case ECC_CMD_SIGN:
+        packet->param1 = SIGN_MODE_EXTERNAL | (msgDigBuf ? SIGN_MODE_SOURCE_MSGDIGBUF : SIGN_MODE_SOURCE_TEMPKEY);
+        packet->param2 = DEVICE_KEY_SLOT;
+        status = atSign(ca_cmd, packet);
+        break;
+
+        case ECC_CMD_VERIFY:
+        packet->param1 = VERIFY_MODE_EXTERNAL | (msgDigBuf ? VERIFY_MODE_SOURCE_MSGDIGBUF : VERIFY_MODE_SOURCE_TEMPKEY);
+        packet->param2 = VERIFY_KEY_P256;
+        verify = &eccJob.verify[eccJob.step / 2];
+        memcpy(&packet->data[0], verify->signature, ATCA_SIG_SIZE);
+        memcpy(&packet->data[ATCA_SIG_SIZE], verify->key.X, ATCA_PUB_KEY_SIZE);
+        status = atVerify(ca_cmd, packet);
+        break;
+
+        default:
+        eccJobFinish(M2M_SUCCESS);
+        return;
+    }
+
+    if (status == ATCA_SUCCESS)
+    {
+        status = atca_start_command(packet, _gDevice, eccJobCommandDone, NULL);
+    }
+    if (status != ATCA_SUCCESS)
+    {
+        debug_printError("CRYPTO: command not started (%X)", status);
+        eccJobFinish(M2M_ERR_FAIL);
+    }
+}
+
+// Called from the WINC SSL callback: everything the request comes with is read
+// now, the ECC608 commands then run from CRYPTO_CLIENT_sched() and the answer
+// is sent when they are over
 void CRYPTO_CLIENT_processEccRequest(tstrEccReqInfo *ecc_request)
 {
-    tstrEccReqInfo ecc_response;
-    uint8_t signature[80];
-    uint16_t response_data_size = 0;
-    uint8_t *response_data_buffer = NULL;
+    eccVerifyInput_t *verify;
+    uint16_t curve_type;
+    uint32_t index;
+    int8_t status = M2M_SUCCESS;
 
-    ecc_response.u16Status = 1;
+    if (eccJob.busy == true)
+    {
+        tstrEccReqInfo ecc_response;
+
+        debug_printError("CRYPTO: ECC request while busy");
+        memset(&ecc_response, 0, sizeof(ecc_response));
+        ecc_response.u16Status   = M2M_ERR_FAIL;
+        ecc_response.u16REQ      = ecc_request->u16REQ;
+        ecc_response.u32UserData = ecc_request->u32UserData;
+        ecc_response.u32SeqNo    = ecc_request->u32SeqNo;
+        m2m_ssl_ecc_process_done();
+        m2m_ssl_handshake_rsp(&ecc_response, NULL, 0);
+        return;
+    }
+
+    memset(&eccJob.response, 0, sizeof(eccJob.response));
+    eccJob.request = *ecc_request;
+    eccJob.signatureSize = 0;
+    eccJob.verifyCount = 0;
+    eccJob.step = 0;
 
     switch (ecc_request->u16REQ)
     {
         case ECC_REQ_CLIENT_ECDH:
-        ecc_response.u16Status = ecdh_derive_client_shared_secret(&(ecc_request->strEcdhREQ.strPubKey),
-        ecc_response.strEcdhREQ.au8Key,
-        &ecc_response.strEcdhREQ.strPubKey);
+        if ((g_ecdh_key_slot_index < 0) ||
+        (g_ecdh_key_slot_index >= (sizeof(g_ecdh_key_slot) / sizeof(g_ecdh_key_slot[0]))))
+        {
+            g_ecdh_key_slot_index = 0;
+        }
+        if(_gDevice->mIface->mIfaceCFG->devtype == ATECC608A)
+        {
+            //do special ecdh functions for the 608, keep ephemeral keys in SRAM
+            eccJob.ecdhMode = ECDH_MODE_SOURCE_TEMPKEY | ECDH_MODE_COPY_OUTPUT_BUFFER;
+            eccJob.keyId = GENKEY_PRIVATE_TO_TEMPKEY;
+        }
+        else
+        {
+            //specializations for the 508, use an EEPROM key slot
+            eccJob.ecdhMode = ECDH_PREFIX_MODE;
+            eccJob.keyId = g_ecdh_key_slot[g_ecdh_key_slot_index];
+            g_ecdh_key_slot_index++;
+        }
         break;
 
         case ECC_REQ_GEN_KEY:
-        ecc_response.u16Status = ecdh_derive_key_pair(&ecc_response.strEcdhREQ.strPubKey);
+        if ((g_ecdh_key_slot_index < 0) ||
+        (g_ecdh_key_slot_index >= (sizeof(g_ecdh_key_slot) / sizeof(g_ecdh_key_slot[0]))))
+        {
+            g_ecdh_key_slot_index = 0;
+        }
+        eccJob.keyId = g_ecdh_key_slot[g_ecdh_key_slot_index];
         break;
 
         case ECC_REQ_SERVER_ECDH:
-        ecc_response.u16Status = ecdh_derive_server_shared_secret(ecc_request->strEcdhREQ.strPubKey.u16PrivKeyID,
-        &(ecc_request->strEcdhREQ.strPubKey),
-        ecc_response.strEcdhREQ.au8Key);
+        eccJob.ecdhMode = ECDH_PREFIX_MODE;
+        eccJob.keyId = ecc_request->strEcdhREQ.strPubKey.u16PrivKeyID;
         break;
 
         case ECC_REQ_SIGN_VERIFY:
-        ecc_response.u16Status = ecdsa_process_sign_verify_request(ecc_request->strEcdsaVerifyREQ.u32nSig);
+        if (ecc_request->strEcdsaVerifyREQ.u32nSig > ECC_VERIFY_MAX)
+        {
+            atca_session_begin();
+            eccJob.response.u16Status = ecdsa_process_sign_verify_request(ecc_request->strEcdsaVerifyREQ.u32nSig);
+            m2m_ssl_ecc_process_done();
+            eccJobFinish(eccJob.response.u16Status);
+            return;
+        }
+        for (index = 0; index < ecc_request->strEcdsaVerifyREQ.u32nSig; index++)
+        {
+            verify = &eccJob.verify[eccJob.verifyCount];
+            status = m2m_ssl_retrieve_cert(&curve_type, verify->hash, verify->signature, &verify->key);
+            if (status != M2M_SUCCESS)
+            {
+                debug_printInfo("m2m_ssl_retrieve_cert() failed with ret=%d", status);
+                break;
+            }
+            // Other curves are not checked
+            if (curve_type == EC_SECP256R1)
+            {
+                eccJob.verifyCount++;
+            }
+        }
         break;
 
         case ECC_REQ_SIGN_GEN:
-        ecc_response.u16Status = ecdsa_process_sign_gen_request(&(ecc_request->strEcdsaSignREQ), signature,
-        &response_data_size);
-        response_data_buffer = signature;
+        status = m2m_ssl_retrieve_hash(eccJob.hash, ecc_request->strEcdsaSignREQ.u16HashSz);
+        if (status != M2M_SUCCESS)
+        {
+            debug_printInfo("m2m_ssl_retrieve_hash() failed with ret=%d", status);
+        }
+        else if (ecc_request->strEcdsaSignREQ.u16CurveType == EC_SECP256R1)
+        {
+            eccJob.signatureSize = 64;
+        }
         break;
 
         default:
-        // Do nothing
+        status = 1;
         break;
     }
 
-    ecc_response.u16REQ      = ecc_request->u16REQ;
-    ecc_response.u32UserData = ecc_request->u32UserData;
-    ecc_response.u32SeqNo    = ecc_request->u32SeqNo;
-
+    // All WINC sent has been read
     m2m_ssl_ecc_process_done();
-    m2m_ssl_handshake_rsp(&ecc_response, response_data_buffer, response_data_size);
+    if (status != M2M_SUCCESS)
+    {
+        eccJobFinish(status);
+        return;
+    }
+    eccJob.busy = true;
+    // The commands of the request share one wake of the ECC608
+    atca_session_begin();
+    eccJobNext();
+}
+
+void CRYPTO_CLIENT_sched(void)
+{
+    atca_command_sched();
 }
@@ -51,8 +51,10 @@ pf_MQTT_CLIENT pf_mqqt_iothub_client = {
 
 extern const az_span device_model_id;
 extern void APP_ReceivedFromCloud_methods(uint8_t* topic, uint8_t* payload);
-extern void APP_ReceivedFromCloud_twin(uint8_t* topic, uint8_t* payload);
-extern void APP_ReceivedFromCloud_patch(uint8_t* topic, uint8_t* payload);
+extern void *APP_GetTwinDocument(void);
+extern void APP_ReceivedFromCloud_twin_begin(void *context, uint8_t *topic, uint32_t payloadLength);
+extern void APP_ReceivedFromCloud_twin_data(void *context, uint8_t *data, uint16_t length);
+extern void APP_ReceivedFromCloud_twin_end(void *context, bool complete);
 static const az_span twin_request_id = AZ_SPAN_LITERAL_FROM_STR("initial_get");
 
 char mqtt_telemetry_topic_buf[64];
@@ -72,7 +74,7 @@ az_iot_hub_client hub_client;
  *       mchp/mySubscribedTopic/myDetailedPath
  *       Sample publish handler function  = void handlePublishMessage(uint8_t *topic, uint8_t *payload)
  */
-publishReceptionHandler_t imqtt_publishReceiveCallBackTable[MAX_NUM_TOPICS_SUBSCRIBE];
+publishReceptionHandler_t imqtt_publishReceiveCallBackTable[MAX_NUM_PUBLISH_HANDLERS];
 
 void MQTT_CLIENT_iothub_publish(uint8_t* data, uint16_t len)
 {
@@ -153,7 +155,9 @@ void MQTT_CLIENT_iothub_connect(char* deviceID)
 
 	mqttConnectPacket cloudConnectPacket;
 	memset(&cloudConnectPacket, 0, sizeof(mqttConnectPacket));
-	cloudConnectPacket.connectVariableHeader.connectFlagsByte.All = 0x20; // AZ_CLIENT_DEFAULT_MQTT_CONNECT_CLEAN_SESSION
+	// Keep the session on the hub across connections: subscriptions and 
+	// unacknowledged QoS 1 messages survive a reconnect
+	cloudConnectPacket.connectVariableHeader.connectFlagsByte.cleanSession = 0;
 	cloudConnectPacket.connectVariableHeader.keepAliveTimer = AZ_IOT_DEFAULT_MQTT_CONNECT_KEEPALIVE_SECONDS;
 
 	cloudConnectPacket.clientID = az_span_ptr(device_id);
@@ -184,11 +188,26 @@ bool MQTT_CLIENT_iothub_subscribe()
 
 	imqtt_publishReceiveCallBackTable[0].topic = AZ_IOT_HUB_CLIENT_METHODS_SUBSCRIBE_TOPIC;
 	imqtt_publishReceiveCallBackTable[0].mqttHandlePublishDataCallBack = APP_ReceivedFromCloud_methods;
+	// Twin documents are streamed: they are not limited by the Rx buffer
 	imqtt_publishReceiveCallBackTable[1].topic = AZ_IOT_HUB_CLIENT_TWIN_PATCH_SUBSCRIBE_TOPIC;
-	imqtt_publishReceiveCallBackTable[1].mqttHandlePublishDataCallBack = APP_ReceivedFromCloud_patch;
+	imqtt_publishReceiveCallBackTable[1].mqttPublishBeginCallBack = APP_ReceivedFromCloud_twin_begin;
+	imqtt_publishReceiveCallBackTable[1].mqttPublishDataCallBack = APP_ReceivedFromCloud_twin_data;
+	imqtt_publishReceiveCallBackTable[1].mqttPublishEndCallBack = APP_ReceivedFromCloud_twin_end;
+	imqtt_publishReceiveCallBackTable[1].mqttPublishContext = APP_GetTwinDocument();
 	imqtt_publishReceiveCallBackTable[2].topic = AZ_IOT_HUB_CLIENT_TWIN_RESPONSE_SUBSCRIBE_TOPIC;
-	imqtt_publishReceiveCallBackTable[2].mqttHandlePublishDataCallBack = APP_ReceivedFromCloud_twin;
-	MQTT_SetPublishReceptionHandlerTable(imqtt_publishReceiveCallBackTable);
+	imqtt_publishReceiveCallBackTable[2].mqttPublishBeginCallBack = APP_ReceivedFromCloud_twin_begin;
+	imqtt_publishReceiveCallBackTable[2].mqttPublishDataCallBack = APP_ReceivedFromCloud_twin_data;
+	imqtt_publishReceiveCallBackTable[2].mqttPublishEndCallBack = APP_ReceivedFromCloud_twin_end;
+	imqtt_publishReceiveCallBackTable[2].mqttPublishContext = APP_GetTwinDocument();
+	MQTT_SetPublishReceptionHandlerTable(imqtt_publishReceiveCallBackTable, MAX_NUM_PUBLISH_HANDLERS);
+
+	if (MQTT_GetSessionPresent() == true)
+	{
+		// The hub kept the subscriptions: no SUBSCRIBE/SUBACK round trip
+		debug_printInfo("MQTT: session resumed");
+		MQTT_CLIENT_iothub_connected();
+		return true;
+	}
 
 	bool ret = MQTT_CreateSubscribePacket(&cloudSubscribePacket);
 	if (ret == true)
@@ -203,6 +222,8 @@ void MQTT_CLIENT_iothub_connected()
 {
 	// get the current state of the device twin
     debug_printGOOD("MQTT_CLIENT_iothub_connected()");
+	// Also on a resumed session: the patches are subscribed at QoS 0, so the
+	// hub did not keep those sent while the device was offline
 	az_result result = az_iot_hub_client_twin_document_get_publish_topic(&hub_client, twin_request_id, mqtt_get_topic_twin_buf, sizeof(mqtt_get_topic_twin_buf), NULL);
 	if (az_result_failed(result))
 	{
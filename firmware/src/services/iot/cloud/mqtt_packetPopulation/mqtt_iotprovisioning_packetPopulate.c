@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdio.h>
 #include <time.h>
@@ -11,6 +12,7 @@
 #include "mqtt_packetPopulate.h"
 #include "mqtt_packetPopulate.h"
 #include "mqtt_iotprovisioning_packetPopulate.h"
+#include "../cloud_service.h"
 #include "iot_config/IoT_Sensor_Node_config.h"
 #include "../../debug_print.h"
 #include "cryptoauthlib/lib/basic/atca_basic.h"
@@ -18,9 +20,12 @@
 #include "azure/iot/az_iot_provisioning_client.h"
 #include "azure/iot/az_iot_hub_client.h"
 #include "azure/core/az_span.h"
+#include "definitions.h"
+#include "flash_storage.h"
 
 #ifdef CFG_MQTT_PROVISIONING_HOST
 #define HALF_SECOND 500L
+#define DPS_ASSIGNMENT_MAGIC 0x41535044UL    // "DPSA"
 
 pf_MQTT_CLIENT pf_mqqt_iotprovisioning_client = {
   MQTT_CLIENT_iotprovisioning_publish,
@@ -35,6 +40,24 @@ extern const az_span device_model_id;
 extern uint8_t device_id_buf[100];
 extern az_span device_id;
 char hub_hostname_buf[128];
+char assigned_device_id_buf[100];
+
+// What DPS assigned, so that a reboot connects to the hub without registering 
+// again. Valid for the registration ID it was made for.
+typedef struct
+{
+	uint32_t magic;
+	uint32_t registration_hash;
+	char hub_hostname[sizeof(hub_hostname_buf)];
+	char device_id[sizeof(assigned_device_id_buf)];
+	uint32_t checksum;
+} dps_assignment_record;
+
+// Rows reserved in the application flash; reprogramming the device clears them
+static const volatile uint8_t dps_assignment_flash[(sizeof(dps_assignment_record) + NVMCTRL_FLASH_ROWSIZE - 1) / NVMCTRL_FLASH_ROWSIZE * NVMCTRL_FLASH_ROWSIZE] __attribute__((aligned(NVMCTRL_FLASH_ROWSIZE))) = { 0 };
+static uint32_t dps_registration_hash;
+// Built by dps_assignment_save(); the saved one is checked in place
+static dps_assignment_record dps_assignment;
 
 az_iot_provisioning_client provisioning_client;
 az_iot_provisioning_client_register_response dps_register_response;
@@ -50,6 +73,56 @@ static void dps_retry_task(uintptr_t context);
 static SYS_TIME_HANDLE dps_assigning_timer_handle = SYS_TIME_HANDLE_INVALID;
 static void dps_assigning_task(uintptr_t context);
 
+static void dps_assignment_save(void)
+{
+	const dps_assignment_record* saved = (const dps_assignment_record*)(uint32_t)dps_assignment_flash;
+
+	memset(&dps_assignment, 0, sizeof(dps_assignment));
+	dps_assignment.magic = DPS_ASSIGNMENT_MAGIC;
+	dps_assignment.registration_hash = dps_registration_hash;
+	strncpy(dps_assignment.hub_hostname, hub_hostname_buf, sizeof(dps_assignment.hub_hostname) - 1);
+	strncpy(dps_assignment.device_id, assigned_device_id_buf, sizeof(dps_assignment.device_id) - 1);
+	dps_assignment.checksum = FLASH_STORAGE_hash((const uint8_t*)&dps_assignment, offsetof(dps_assignment_record, checksum));
+
+	// Registering again to the same hub leaves the flash alone
+	if (saved->checksum == dps_assignment.checksum)
+	{
+		return;
+	}
+	// Losing power in between only loses the assignment
+	if (FLASH_STORAGE_write((uint32_t)dps_assignment_flash, sizeof(dps_assignment_flash), &dps_assignment, sizeof(dps_assignment)) == false)
+	{
+		debug_printError("DPS: Assignment save failed");
+	}
+}
+
+bool dps_assignment_restore(const char* registration_id)
+{
+	// Flash is mapped: the record is checked where it is rather than copied
+	const dps_assignment_record* saved = (const dps_assignment_record*)(uint32_t)dps_assignment_flash;
+
+	if ((saved->magic != DPS_ASSIGNMENT_MAGIC)
+		|| (saved->registration_hash != FLASH_STORAGE_hash((const uint8_t*)registration_id, strlen(registration_id)))
+		|| (saved->checksum != FLASH_STORAGE_hash((const uint8_t*)saved, offsetof(dps_assignment_record, checksum))))
+	{
+		return false;
+	}
+	memcpy(hub_hostname_buf, saved->hub_hostname, sizeof(hub_hostname_buf));
+	memcpy(assigned_device_id_buf, saved->device_id, sizeof(assigned_device_id_buf));
+	hub_hostname = hub_hostname_buf;
+	debug_printInfo("DPS: Assigned to %s as %s", hub_hostname_buf, assigned_device_id_buf);
+	return true;
+}
+
+// Called when the assigned hub refuses the device, which registers again
+void dps_assignment_forget(void)
+{
+	if (FLASH_STORAGE_write((uint32_t)dps_assignment_flash, sizeof(dps_assignment_flash), NULL, 0) == false)
+	{
+		debug_printError("DPS: Assignment erase failed");
+	}
+}
+
 void dps_client_register(uint8_t* topic, uint8_t* payload)
 {
 	int rc;
@@ -79,7 +152,11 @@ void dps_client_register(uint8_t* topic, uint8_t* payload)
             SYS_TIME_TimerDestroy(dps_retry_timer_handle);
             SYS_TIME_TimerDestroy(dps_assigning_timer_handle);
             az_span_to_str(hub_hostname_buf, sizeof(hub_hostname_buf), dps_register_response.registration_state.assigned_hub_hostname);
+            az_span_to_str(assigned_device_id_buf, sizeof(assigned_device_id_buf), dps_register_response.registration_state.device_id);
             hub_hostname = hub_hostname_buf;
+            dps_assignment_save();
+            // Look the hub up before the provisioning connection is closed
+            CLOUD_prefetchHost(hub_hostname);
             pf_mqqt_iotprovisioning_client.MQTT_CLIENT_task_completed();
             break;
 
@@ -147,7 +224,7 @@ static void dps_retry_task(uintptr_t context)
  *       mchp/mySubscribedTopic/myDetailedPath
  *       Sample publish handler function  = void handlePublishMessage(uint8_t *topic, uint8_t *payload)
  */
-extern publishReceptionHandler_t imqtt_publishReceiveCallBackTable[MAX_NUM_TOPICS_SUBSCRIBE];
+extern publishReceptionHandler_t imqtt_publishReceiveCallBackTable[MAX_NUM_PUBLISH_HANDLERS];
 
 void MQTT_CLIENT_iotprovisioning_publish(uint8_t* data, uint16_t len)
 {
@@ -164,6 +241,7 @@ void MQTT_CLIENT_iotprovisioning_connect(char* deviceID)
 	az_span device_id = AZ_SPAN_FROM_BUFFER(device_id_buf);
 	az_span_copy(device_id, deviceID_parm);
 	device_id = az_span_slice(device_id, 0, az_span_size(deviceID_parm));
+	dps_registration_hash = FLASH_STORAGE_hash((const uint8_t*)deviceID, strlen(deviceID));
 	    
 	const az_span global_device_endpoint = AZ_SPAN_LITERAL_FROM_STR(CFG_MQTT_PROVISIONING_HOST);
 	const az_span id_scope = AZ_SPAN_LITERAL_FROM_STR(PROVISIONING_ID_SCOPE);
@@ -209,7 +287,7 @@ bool MQTT_CLIENT_iotprovisioning_subscribe()
 	memset(imqtt_publishReceiveCallBackTable, 0, sizeof(imqtt_publishReceiveCallBackTable));
 	imqtt_publishReceiveCallBackTable[0].topic = AZ_IOT_PROVISIONING_CLIENT_REGISTER_SUBSCRIBE_TOPIC;
 	imqtt_publishReceiveCallBackTable[0].mqttHandlePublishDataCallBack = dps_client_register;
-	MQTT_SetPublishReceptionHandlerTable(imqtt_publishReceiveCallBackTable);
+	MQTT_SetPublishReceptionHandlerTable(imqtt_publishReceiveCallBackTable, MAX_NUM_PUBLISH_HANDLERS);
 
 	bool ret = MQTT_CreateSubscribePacket(&cloudSubscribePacket);
 	if (ret == true)
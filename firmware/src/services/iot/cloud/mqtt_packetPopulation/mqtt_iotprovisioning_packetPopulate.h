@@ -39,4 +39,9 @@ void MQTT_CLIENT_iotprovisioning_connect(char* deviceID);
 bool MQTT_CLIENT_iotprovisioning_subscribe();
 void MQTT_CLIENT_iotprovisioning_connected();
 
+// Hub assignment saved in flash by the last successful registration
+extern char assigned_device_id_buf[];
+bool dps_assignment_restore(const char* registration_id);
+void dps_assignment_forget(void);
+
 #endif /* MQTT_IOTPROVISIONING_PACKET_POPULATE_H */
\ No newline at end of file
@@ -47,6 +47,7 @@ typedef struct
   bool (*MQTT_CLIENT_subscribe)();
   void (*MQTT_CLIENT_connected)();  
   void (*MQTT_CLIENT_task_completed)();  
+  void (*MQTT_CLIENT_connect_refused)();  
 }  pf_MQTT_CLIENT;
 
 char* url_encode_rfc3986(char* s, char* dest, size_t dest_len);